@@ -7,7 +7,7 @@
 #endif
 
 #define REFRAMEWORK_PLUGIN_VERSION_MAJOR 1
-#define REFRAMEWORK_PLUGIN_VERSION_MINOR 10
+#define REFRAMEWORK_PLUGIN_VERSION_MINOR 11
 #define REFRAMEWORK_PLUGIN_VERSION_PATCH 0
 
 #define REFRAMEWORK_RENDERER_D3D11 0
@@ -386,6 +386,71 @@ typedef struct {
     void (*deallocate)(void*);
 } REFrameworkSDKFunctions;
 
+DECLARE_REFRAMEWORK_HANDLE(REFrameworkInvokeHandle);
+
+/* everything REFrameworkTDBMethod can tell about a method, filled in one call */
+typedef struct {
+    REFrameworkMethodHandle handle;
+    const char* name;
+    REFrameworkTypeDefinitionHandle declaring_type;
+    REFrameworkTypeDefinitionHandle return_type;
+    void* function;
+    unsigned int index;
+    unsigned int num_params;
+    int virtual_index;
+    unsigned short flags;
+    unsigned short impl_flags;
+    bool is_static;
+} REFrameworkMethodDescriptor;
+
+/* everything REFrameworkTDBField can tell about a field, filled in one call */
+typedef struct {
+    REFrameworkFieldHandle handle;
+    const char* name;
+    REFrameworkTypeDefinitionHandle declaring_type;
+    REFrameworkTypeDefinitionHandle type;
+    unsigned int index;
+    unsigned int offset_from_base;
+    unsigned int offset_from_fieldptr;
+    unsigned int flags;
+    bool is_static;
+    bool is_literal;
+} REFrameworkFieldDescriptor;
+
+/* plugin version 1.11+ */
+/* batched versions of the one-item-per-call functions above, for plugins that touch many types or objects per frame */
+typedef struct {
+    /* out must hold count handles, names that weren't found get a null handle */
+    /* returns how many of the names were found */
+    unsigned int (*find_types)(REFrameworkTDBHandle, const char* const* names, unsigned int count, REFrameworkTypeDefinitionHandle* out);
+    unsigned int (*find_methods)(REFrameworkTypeDefinitionHandle, const char* const* names, unsigned int count, REFrameworkMethodHandle* out);
+    unsigned int (*find_fields)(REFrameworkTypeDefinitionHandle, const char* const* names, unsigned int count, REFrameworkFieldHandle* out);
+
+    /* only the type's own methods/fields, not its parents' */
+    /* out_size is the full size, in bytes of the out buffer */
+    /* out_count is how many elements were written to the out buffer, not the size of the written data */
+    REFrameworkResult (*get_method_descriptors)(REFrameworkTypeDefinitionHandle, REFrameworkMethodDescriptor* out, unsigned int out_size, unsigned int* out_count);
+    REFrameworkResult (*get_field_descriptors)(REFrameworkTypeDefinitionHandle, REFrameworkFieldDescriptor* out, unsigned int out_size, unsigned int* out_count);
+
+    /* copies value_size bytes of the field from each of the count objects into out, stride bytes apart */
+    /* value_size 0 uses the size of the field's type (pointer size for reference types) */
+    /* null objects get their slot zeroed */
+    REFrameworkResult (*read_field)(REFrameworkFieldHandle, void* const* objects, unsigned int count, bool is_value_type, void* out, unsigned int stride, unsigned int value_size);
+    /* the opposite of read_field, null objects are skipped */
+    REFrameworkResult (*write_field)(REFrameworkFieldHandle, void* const* objects, unsigned int count, bool is_value_type, const void* in, unsigned int stride, unsigned int value_size);
+
+    /* pre-bound invoke, everything invoke looks up on each call is resolved once here */
+    REFrameworkInvokeHandle (*create_invoke)(REFrameworkMethodHandle);
+    void (*destroy_invoke)(REFrameworkInvokeHandle);
+    /* in_args must hold exactly get_num_params(method) args, each 8 bytes like invoke */
+    /* make sure out size is at least size of InvokeRet */
+    REFrameworkResult (*invoke)(REFrameworkInvokeHandle, void* thisptr, void** in_args, void* out, unsigned int out_size);
+    /* invokes once per object in thisptrs with the same in_args */
+    /* each result is written out_stride bytes apart, out_stride must be at least size of InvokeRet */
+    /* stops at the first exception, out_count is how many calls were made (the last one threw if the result is REFRAMEWORK_ERROR_EXCEPTION) */
+    REFrameworkResult (*invoke_many)(REFrameworkInvokeHandle, void* const* thisptrs, unsigned int count, void** in_args, void* out, unsigned int out_stride, unsigned int* out_count);
+} REFrameworkBulk;
+
 /* these are NOT pointers to the actual objects */
 /* they are interfaces with functions that take handles to the objects */
 /* the functions, however, can return the actual objects */
@@ -403,6 +468,7 @@ typedef struct {
     const REFrameworkVMContext* vm_context;
     const REFrameworkReflectionMethod* reflection_method; /* NOT a TDB method */
     const REFrameworkReflectionProperty* reflection_property; /* NOT a TDB property */
+    const REFrameworkBulk* bulk; /* plugin version 1.11+, check version before touching this */
 } REFrameworkSDKData;
 
 typedef struct {
@@ -5,6 +5,7 @@ extern "C" {
 }
 
 #include <span>
+#include <algorithm>
 #include <mutex>
 #include <array>
 #include <vector>
@@ -103,6 +104,23 @@ public:
         return m_sdk;
     }
 
+    // nullptr if the REFramework we're loaded into is older than plugin version 1.11
+    inline const REFrameworkBulk* bulk() const {
+        const auto version = m_param->version;
+
+        if (version->major < 1 || (version->major == 1 && version->minor < 11)) {
+            return nullptr;
+        }
+
+        return m_sdk->bulk;
+    }
+
+    // The bulk wrappers below check this themselves. Where there's a per item equivalent they fall back to it,
+    // otherwise they return empty results (or throw with REFRAMEWORK_API_EXCEPTIONS).
+    inline bool has_bulk() const {
+        return bulk() != nullptr;
+    }
+
     inline const auto tdb() const { 
         static const auto fn = sdk()->functions->get_tdb;
         return (TDB*)fn(); 
@@ -261,6 +279,24 @@ public:
             return (API::TypeDefinition*)fn(*this, fqn);
         }
 
+        // One entry per name, nullptr for names that weren't found
+        std::vector<API::TypeDefinition*> find_types(std::span<const char* const> names) const {
+            std::vector<API::TypeDefinition*> out(names.size());
+
+            if (!API::s_instance->has_bulk()) {
+                for (size_t i = 0; i < names.size(); ++i) {
+                    out[i] = find_type(names[i]);
+                }
+
+                return out;
+            }
+
+            static const auto fn = API::s_instance->bulk()->find_types;
+            fn(*this, names.data(), (unsigned int)names.size(), (REFrameworkTypeDefinitionHandle*)out.data());
+
+            return out;
+        }
+
         API::Method* get_method(uint32_t index) const {
             static const auto fn = API::s_instance->sdk()->tdb->get_method;
             return (API::Method*)fn(*this, index);
@@ -460,6 +496,89 @@ public:
             return fields;
         }
 
+        // One entry per name, nullptr for names that weren't found
+        std::vector<API::Method*> find_methods(std::span<const char* const> names) const {
+            std::vector<API::Method*> out(names.size());
+
+            if (!API::s_instance->has_bulk()) {
+                for (size_t i = 0; i < names.size(); ++i) {
+                    out[i] = find_method(names[i]);
+                }
+
+                return out;
+            }
+
+            static const auto fn = API::s_instance->bulk()->find_methods;
+            fn(*this, names.data(), (unsigned int)names.size(), (REFrameworkMethodHandle*)out.data());
+
+            return out;
+        }
+
+        std::vector<API::Field*> find_fields(std::span<const char* const> names) const {
+            std::vector<API::Field*> out(names.size());
+
+            if (!API::s_instance->has_bulk()) {
+                for (size_t i = 0; i < names.size(); ++i) {
+                    out[i] = find_field(names[i]);
+                }
+
+                return out;
+            }
+
+            static const auto fn = API::s_instance->bulk()->find_fields;
+            fn(*this, names.data(), (unsigned int)names.size(), (REFrameworkFieldHandle*)out.data());
+
+            return out;
+        }
+
+        std::vector<REFrameworkMethodDescriptor> get_method_descriptors() const {
+            if (!API::s_instance->has_bulk()) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("get_method_descriptors requires REFramework plugin version 1.11");
+#else
+                return {};
+#endif
+            }
+
+            static const auto fn = API::s_instance->bulk()->get_method_descriptors;
+
+            std::vector<REFrameworkMethodDescriptor> out(get_num_methods());
+            uint32_t count{};
+
+            auto result = fn(*this, out.data(), (unsigned int)(out.size() * sizeof(REFrameworkMethodDescriptor)), &count);
+
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                return {};
+            }
+
+            out.resize(count);
+            return out;
+        }
+
+        std::vector<REFrameworkFieldDescriptor> get_field_descriptors() const {
+            if (!API::s_instance->has_bulk()) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("get_field_descriptors requires REFramework plugin version 1.11");
+#else
+                return {};
+#endif
+            }
+
+            static const auto fn = API::s_instance->bulk()->get_field_descriptors;
+
+            std::vector<REFrameworkFieldDescriptor> out(get_num_fields());
+            uint32_t count{};
+
+            auto result = fn(*this, out.data(), (unsigned int)(out.size() * sizeof(REFrameworkFieldDescriptor)), &count);
+
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                return {};
+            }
+
+            out.resize(count);
+            return out;
+        }
+
         std::vector<API::Property*> get_properties() const {
             throw std::runtime_error("Not implemented");
             return {};
@@ -506,6 +625,117 @@ public:
         }
     };
 
+    // Returned by Method::bind. Everything Method::invoke looks up on each call is resolved once,
+    // for invoking the same method many times.
+    class BoundMethod {
+    public:
+        // Unbound (false) on REFramework older than plugin version 1.11.
+        BoundMethod(::REFrameworkMethodHandle method) {
+            if (!API::s_instance->has_bulk()) {
+                return;
+            }
+
+            static const auto fn = API::s_instance->bulk()->create_invoke;
+            static const auto get_num_params = API::s_instance->sdk()->method->get_num_params;
+
+            m_handle = fn(method);
+            m_num_params = method != nullptr ? get_num_params(method) : 0;
+        }
+
+        BoundMethod(const BoundMethod&) = delete;
+        BoundMethod& operator=(const BoundMethod&) = delete;
+
+        BoundMethod(BoundMethod&& other) noexcept
+            : m_handle{other.m_handle},
+            m_num_params{other.m_num_params}
+        {
+            other.m_handle = nullptr;
+        }
+
+        ~BoundMethod() {
+            // Only ever non-null when the bulk API exists.
+            if (m_handle != nullptr) {
+                static const auto fn = API::s_instance->bulk()->destroy_invoke;
+                fn(m_handle);
+            }
+        }
+
+        explicit operator bool() const {
+            return m_handle != nullptr;
+        }
+
+        reframework::InvokeRet invoke(API::ManagedObject* obj, std::span<void*> args) const {
+            reframework::InvokeRet out{};
+
+            if (m_handle == nullptr) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("Method invocation failed, method is not bound");
+#else
+                return out;
+#endif
+            }
+
+            static const auto fn = API::s_instance->bulk()->invoke;
+
+            if (args.size() != m_num_params) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("Method invocation failed, wrong number of arguments");
+#else
+                return out;
+#endif
+            }
+
+            auto result = fn(m_handle, obj, args.data(), &out, sizeof(out));
+
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                throw std::runtime_error("Method invocation failed");
+            }
+#endif
+
+            return out;
+        }
+
+        // One result per object, all invoked with the same args. Stops at the first exception.
+        std::vector<reframework::InvokeRet> invoke_many(std::span<API::ManagedObject* const> objs, std::span<void*> args) const {
+            if (m_handle == nullptr) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("Method invocation failed, method is not bound");
+#else
+                return {};
+#endif
+            }
+
+            static const auto fn = API::s_instance->bulk()->invoke_many;
+
+            if (args.size() != m_num_params) {
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+                throw std::runtime_error("Method invocation failed, wrong number of arguments");
+#else
+                return {};
+#endif
+            }
+
+            std::vector<reframework::InvokeRet> out(objs.size());
+            uint32_t count{};
+
+            auto result = fn(m_handle, (void* const*)objs.data(), (unsigned int)objs.size(), args.data(), out.data(), sizeof(reframework::InvokeRet), &count);
+
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                throw std::runtime_error("Method invocation failed");
+            }
+#endif
+
+            out.resize(count);
+            return out;
+        }
+
+    private:
+        ::REFrameworkInvokeHandle m_handle{};
+        uint32_t m_num_params{};
+    };
+
     struct Method {
         operator ::REFrameworkMethodHandle() const {
             return (::REFrameworkMethodHandle)this;
@@ -629,6 +859,10 @@ public:
             return fn(*this);
         }
 
+        API::BoundMethod bind() const {
+            return API::BoundMethod{*this};
+        }
+
         unsigned int add_hook(REFPreHookFn pre_fn, REFPostHookFn post_fn, bool ignore_jmp) const {
             static const auto fn = API::s_instance->sdk()->functions->add_hook;
             return fn(*this, pre_fn, post_fn, ignore_jmp);
@@ -702,6 +936,52 @@ public:
         }
 
         template <typename T> T& get_data(void* object = nullptr, bool is_value_type = false) const { return *(T*)get_data_raw(object, is_value_type); }
+
+        // get_data for every object in one call, null objects read as T{}
+        template <typename T>
+        void read_many(std::span<void* const> objects, std::span<T> out, bool is_value_type = false) const {
+            if (!API::s_instance->has_bulk()) {
+                for (size_t i = 0; i < std::min(objects.size(), out.size()); ++i) {
+                    out[i] = objects[i] != nullptr ? get_data<T>(objects[i], is_value_type) : T{};
+                }
+
+                return;
+            }
+
+            static const auto fn = API::s_instance->bulk()->read_field;
+
+            auto result = fn(*this, objects.data(), (unsigned int)std::min(objects.size(), out.size()), is_value_type, out.data(), sizeof(T), sizeof(T));
+
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                throw std::runtime_error("Field read failed");
+            }
+#endif
+        }
+
+        // Null objects are skipped
+        template <typename T>
+        void write_many(std::span<void* const> objects, std::span<const T> in, bool is_value_type = false) const {
+            if (!API::s_instance->has_bulk()) {
+                for (size_t i = 0; i < std::min(objects.size(), in.size()); ++i) {
+                    if (objects[i] != nullptr) {
+                        get_data<T>(objects[i], is_value_type) = in[i];
+                    }
+                }
+
+                return;
+            }
+
+            static const auto fn = API::s_instance->bulk()->write_field;
+
+            auto result = fn(*this, objects.data(), (unsigned int)std::min(objects.size(), in.size()), is_value_type, in.data(), sizeof(T), sizeof(T));
+
+#ifdef REFRAMEWORK_API_EXCEPTIONS
+            if (result != REFRAMEWORK_ERROR_NONE) {
+                throw std::runtime_error("Field write failed");
+            }
+#endif
+        }
     };
 
     struct Property {
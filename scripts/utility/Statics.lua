@@ -6,6 +6,17 @@ function Statics.generate(typename, double_ended)
     local t = sdk.find_type_definition(typename)
     if not t then return {} end
 
+    -- Native path, values are cached across all scripts. Copied so callers can still modify the result.
+    if sdk.get_enum ~= nil and t:is_enum() then
+        local enum = {}
+
+        for k, v in pairs(sdk.get_enum(t, double_ended)) do
+            enum[k] = v
+        end
+
+        return enum
+    end
+
     local fields = t:get_fields()
     local enum = {}
 
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "MappedFile.hpp"
+#include "Batch.hpp"
+
+namespace rsz {
+BatchStats parse_files(const std::vector<std::filesystem::path>& paths, const LayoutDatabase& layouts, const BatchCallback& callback, uint32_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    num_threads = std::min<uint32_t>(num_threads, (uint32_t)std::max<size_t>(paths.size(), 1));
+
+    std::atomic<size_t> next{0};
+    std::mutex stats_mtx{};
+    BatchStats stats{};
+
+    const auto worker = [&] {
+        BatchStats local{};
+        std::string error{};
+
+        for (auto i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1)) {
+            const auto& path = paths[i];
+            ++local.files;
+
+            const auto file = MappedFile::open(path);
+
+            if (!file) {
+                ++local.failures;
+
+                if (callback) {
+                    callback(path, nullptr, "Failed to map file");
+                }
+
+                continue;
+            }
+
+            local.bytes += file->data().size();
+
+            error.clear();
+            const auto document = Document::parse(file->data(), layouts, &error);
+
+            if (!document) {
+                ++local.failures;
+            } else {
+                local.instances += document->get_instances().size();
+                local.crc_mismatches += document->get_stats().crc_mismatches;
+
+                for (const auto& instance : document->get_instances()) {
+                    if (instance.layout != nullptr) {
+                        local.fields += instance.layout->fields.size();
+                    }
+                }
+            }
+
+            if (callback) {
+                callback(path, document ? &*document : nullptr, error);
+            }
+        }
+
+        std::scoped_lock _{stats_mtx};
+        stats.files += local.files;
+        stats.failures += local.failures;
+        stats.bytes += local.bytes;
+        stats.instances += local.instances;
+        stats.fields += local.fields;
+        stats.crc_mismatches += local.crc_mismatches;
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_threads - 1);
+
+    for (uint32_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    return stats;
+}
+
+std::vector<std::filesystem::path> find_files(const std::filesystem::path& dir) {
+    std::vector<std::filesystem::path> out{};
+    std::error_code ec{};
+
+    for (auto it = std::filesystem::recursive_directory_iterator{dir, ec}; !ec && it != std::filesystem::recursive_directory_iterator{}; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+
+        auto name = it->path().filename().string();
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+        if (name.find(".user") != std::string::npos || name.find(".pfb") != std::string::npos || name.find(".scn") != std::string::npos) {
+            out.push_back(it->path());
+        }
+    }
+
+    // Stable order so runs are comparable.
+    std::sort(out.begin(), out.end());
+    return out;
+}
+} // namespace rsz
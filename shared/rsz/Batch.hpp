@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "Document.hpp"
+
+namespace rsz {
+// Called once per file from whichever worker parsed it. document is nullptr if the file
+// couldn't be opened or parsed, error says why. The document and the mapping behind it
+// only live for the duration of the call.
+using BatchCallback = std::function<void(const std::filesystem::path& path, const Document* document, std::string_view error)>;
+
+struct BatchStats {
+    uint32_t files{};
+    uint32_t failures{};
+    uint64_t bytes{};
+    uint64_t instances{};
+    uint64_t fields{};
+    uint32_t crc_mismatches{};
+};
+
+// Maps, parses and hands every file to callback, spread over num_threads workers
+// (hardware concurrency if 0). Files are claimed one at a time so slow ones don't stall a worker's queue.
+BatchStats parse_files(const std::vector<std::filesystem::path>& paths, const LayoutDatabase& layouts, const BatchCallback& callback = {}, uint32_t num_threads = 0);
+
+// Every .user/.pfb/.scn file (any version suffix, e.g. foo.user.2) under dir.
+std::vector<std::filesystem::path> find_files(const std::filesystem::path& dir);
+} // namespace rsz
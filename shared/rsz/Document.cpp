@@ -0,0 +1,450 @@
+#include <algorithm>
+
+#include "Document.hpp"
+
+namespace rsz {
+namespace detail {
+constexpr uint32_t USR_MAGIC = 0x525355; // "USR\0"
+constexpr uint32_t PFB_MAGIC = 0x424650; // "PFB\0"
+constexpr uint32_t SCN_MAGIC = 0x4E4353; // "SCN\0"
+
+// Where each container header stores the offset of its RSZ block.
+constexpr size_t USR_DATA_OFFSET = 0x20;
+constexpr size_t PFB_DATA_OFFSET = 0x30;
+constexpr size_t SCN_DATA_OFFSET = 0x38;
+
+template <typename T>
+std::optional<T> read(std::span<const uint8_t> data, size_t offset) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        return std::nullopt;
+    }
+
+    T out{};
+    memcpy(&out, data.data() + offset, sizeof(T));
+    return out;
+}
+
+inline uint64_t align_up(uint64_t value, uint32_t align) {
+    return align > 1 ? (value + align - 1) / align * align : value;
+}
+
+inline uint64_t get_stride(const FieldLayout& field) {
+    return align_up(field.size, field.align);
+}
+
+// Appends zeroes until out.size() - base is aligned.
+void pad(std::vector<uint8_t>& out, size_t base, uint32_t align) {
+    out.resize(base + align_up(out.size() - base, align), 0);
+}
+
+void append(std::vector<uint8_t>& out, std::span<const uint8_t> bytes) {
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+}
+
+std::optional<size_t> Document::find_rsz(std::span<const uint8_t> file) {
+    const auto magic = detail::read<uint32_t>(file, 0);
+
+    if (!magic) {
+        return std::nullopt;
+    }
+
+    if (*magic == RSZ_MAGIC) {
+        return 0;
+    }
+
+    const auto is_rsz_at = [&](uint64_t offset) {
+        return offset % 4 == 0 && detail::read<uint32_t>(file, (size_t)offset).value_or(0) == RSZ_MAGIC;
+    };
+
+    std::optional<uint64_t> header_offset{};
+
+    switch (*magic) {
+    case detail::USR_MAGIC:
+        header_offset = detail::read<uint64_t>(file, detail::USR_DATA_OFFSET);
+        break;
+    case detail::PFB_MAGIC:
+        header_offset = detail::read<uint64_t>(file, detail::PFB_DATA_OFFSET);
+        break;
+    case detail::SCN_MAGIC:
+        header_offset = detail::read<uint64_t>(file, detail::SCN_DATA_OFFSET);
+        break;
+    default:
+        break;
+    }
+
+    if (header_offset && is_rsz_at(*header_offset)) {
+        return (size_t)*header_offset;
+    }
+
+    // Older container revisions put the offset elsewhere. The block is always 16 byte aligned,
+    // and the UTF-16 paths in front of it can't contain the magic.
+    for (size_t offset = 16; offset + sizeof(Header) <= file.size(); offset += 16) {
+        if (is_rsz_at(offset)) {
+            return offset;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<Document> Document::parse(std::span<const uint8_t> file, const LayoutDatabase& layouts, std::string* error) {
+    const auto rsz_offset = find_rsz(file);
+
+    if (!rsz_offset) {
+        detail::set_error(error, "No RSZ block found");
+        return std::nullopt;
+    }
+
+    const auto header = detail::read<Header>(file, *rsz_offset);
+
+    if (!header || header->instance_count < 0 || header->object_count < 0 || header->userdata_count < 0) {
+        detail::set_error(error, "Truncated or corrupt RSZ header");
+        return std::nullopt;
+    }
+
+    const auto rsz_size = file.size() - *rsz_offset;
+    const auto object_table_end = sizeof(Header) + (uint64_t)header->object_count * sizeof(int32_t);
+    const auto instances_end = header->instance_offset + (uint64_t)header->instance_count * sizeof(InstanceInfo);
+    const auto userdata_end = header->userdata_offset + (uint64_t)header->userdata_count * sizeof(UserDataInfo);
+
+    if (object_table_end > rsz_size || instances_end > rsz_size || header->data_offset > rsz_size ||
+        (header->userdata_count > 0 && userdata_end > rsz_size))
+    {
+        detail::set_error(error, "RSZ tables are out of bounds");
+        return std::nullopt;
+    }
+
+    Document out{};
+    out.m_file = file;
+    out.m_rsz_offset = *rsz_offset;
+    out.m_instances.resize(header->instance_count);
+
+    const auto infos = (const InstanceInfo*)(file.data() + *rsz_offset + header->instance_offset);
+    size_t num_fields{};
+
+    for (int32_t i = 0; i < header->instance_count; ++i) {
+        auto& instance = out.m_instances[i];
+        instance.type_hash = infos[i].type_hash;
+        instance.crc = infos[i].crc;
+    }
+
+    for (const auto& userdata : out.get_userdata_infos()) {
+        if (userdata.instance_id < out.m_instances.size()) {
+            out.m_instances[userdata.instance_id].external = true;
+        }
+    }
+
+    for (auto& instance : out.m_instances) {
+        if (instance.type_hash == 0 || instance.external) {
+            continue;
+        }
+
+        instance.layout = layouts.find(instance.type_hash);
+
+        if (instance.layout == nullptr) {
+            ++out.m_stats.unknown_types;
+            continue;
+        }
+
+        if (instance.layout->crc != 0 && instance.layout->crc != instance.crc) {
+            ++out.m_stats.crc_mismatches;
+        }
+
+        num_fields += instance.layout->fields.size();
+    }
+
+    // Without a layout there's no way to tell where the next instance starts.
+    if (out.m_stats.unknown_types > 0) {
+        detail::set_error(error, std::to_string(out.m_stats.unknown_types) + " instances have types missing from the layouts");
+        return std::nullopt;
+    }
+
+    out.m_fields.reserve(num_fields);
+
+    if (!out.parse_instance_data(error)) {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+bool Document::parse_instance_data(std::string* error) {
+    const auto& header = get_header();
+    const auto base = (uint64_t)m_rsz_offset;
+    const auto file_size = (uint64_t)m_file.size();
+
+    // Alignment is relative to the start of the RSZ block.
+    const auto align = [&](uint64_t pos, uint32_t alignment) {
+        return base + detail::align_up(pos - base, alignment);
+    };
+
+    const auto read_count = [&](uint64_t pos) -> std::optional<uint32_t> {
+        return detail::read<uint32_t>(m_file, (size_t)pos);
+    };
+
+    // Skips a serialized string, returns the position after it.
+    const auto skip_string = [&](uint64_t pos) -> std::optional<uint64_t> {
+        const auto len = read_count(pos);
+
+        if (!len) {
+            return std::nullopt;
+        }
+
+        return pos + sizeof(uint32_t) + (uint64_t)*len * sizeof(char16_t);
+    };
+
+    auto pos = base + header.data_offset;
+
+    for (uint32_t i = 0; i < m_instances.size(); ++i) {
+        auto& instance = m_instances[i];
+
+        if (instance.layout == nullptr) {
+            continue;
+        }
+
+        instance.first_field = (uint32_t)m_fields.size();
+
+        for (const auto& layout : instance.layout->fields) {
+            Field field{};
+            const auto is_string = is_string_code(layout.code);
+
+            if (layout.array) {
+                pos = align(pos, sizeof(uint32_t));
+
+                const auto count = read_count(pos);
+
+                if (!count) {
+                    break;
+                }
+
+                field.start = (uint32_t)pos;
+                field.count = *count;
+                pos += sizeof(uint32_t);
+
+                if (field.count > 0) {
+                    if (is_string) {
+                        pos = align(pos, sizeof(uint32_t));
+                        field.data = (uint32_t)pos;
+
+                        for (uint32_t e = 0; e < field.count && pos <= file_size; ++e) {
+                            pos = skip_string(align(pos, sizeof(uint32_t))).value_or(UINT64_MAX);
+                        }
+                    } else {
+                        pos = align(pos, layout.align);
+                        field.data = (uint32_t)pos;
+
+                        // Checked before multiplying so a garbage count can't wrap around.
+                        if ((uint64_t)field.count > file_size) {
+                            pos = UINT64_MAX;
+                        } else {
+                            pos += detail::get_stride(layout) * (field.count - 1) + layout.size;
+                        }
+                    }
+                } else {
+                    field.data = (uint32_t)pos;
+                }
+            } else if (is_string) {
+                pos = align(pos, sizeof(uint32_t));
+                field.start = field.data = (uint32_t)pos;
+                field.count = 1;
+                pos = skip_string(pos).value_or(UINT64_MAX);
+            } else {
+                pos = align(pos, layout.align);
+                field.start = field.data = (uint32_t)pos;
+                field.count = 1;
+                pos += layout.size;
+            }
+
+            if (pos > file_size) {
+                break;
+            }
+
+            field.end = (uint32_t)pos;
+            m_fields.push_back(field);
+        }
+
+        if (m_fields.size() != instance.first_field + instance.layout->fields.size()) {
+            detail::set_error(error, "Instance " + std::to_string(i) + " (" + instance.layout->name + ") runs past the end of the file");
+            return false;
+        }
+    }
+
+    m_data_end = (size_t)pos;
+    return true;
+}
+
+std::span<const UserDataInfo> Document::get_userdata_infos() const {
+    const auto& header = get_header();
+
+    if (header.userdata_count <= 0) {
+        return {};
+    }
+
+    return {(const UserDataInfo*)(m_file.data() + m_rsz_offset + header.userdata_offset), (size_t)header.userdata_count};
+}
+
+std::u16string_view Document::get_userdata_path(const UserDataInfo& info) const {
+    const auto offset = m_rsz_offset + info.path_offset;
+
+    if (offset >= m_file.size()) {
+        return {};
+    }
+
+    const auto begin = (const char16_t*)(m_file.data() + offset);
+    const auto max_len = (m_file.size() - offset) / sizeof(char16_t);
+
+    return {begin, (size_t)(std::find(begin, begin + max_len, u'\0') - begin)};
+}
+
+const Document::Field* Document::get_field(uint32_t instance, std::string_view name) const {
+    if (instance >= m_instances.size() || m_instances[instance].layout == nullptr) {
+        return nullptr;
+    }
+
+    const auto index = m_instances[instance].layout->find_field(name);
+
+    if (!index) {
+        return nullptr;
+    }
+
+    return get_field(instance, *index);
+}
+
+std::span<const uint8_t> Document::get_bytes(uint32_t instance, uint32_t field, uint32_t element) const {
+    const auto f = get_field(instance, field);
+
+    if (f == nullptr || element >= f->count) {
+        return {};
+    }
+
+    const auto& layout = m_instances[instance].layout->fields[field];
+
+    if (is_string_code(layout.code)) {
+        return {};
+    }
+
+    return m_file.subspan(f->data + detail::get_stride(layout) * element, layout.size);
+}
+
+std::optional<std::u16string_view> Document::get_string(uint32_t instance, uint32_t field, uint32_t element) const {
+    const auto f = get_field(instance, field);
+
+    if (f == nullptr || element >= f->count || !is_string_code(m_instances[instance].layout->fields[field].code)) {
+        return std::nullopt;
+    }
+
+    // Bounds were checked while parsing.
+    uint64_t pos = f->data;
+
+    for (uint32_t e = 0; e < element; ++e) {
+        const auto len = *detail::read<uint32_t>(m_file, (size_t)pos);
+        pos = m_rsz_offset + detail::align_up(pos + sizeof(uint32_t) + len * sizeof(char16_t) - m_rsz_offset, sizeof(uint32_t));
+    }
+
+    const auto len = *detail::read<uint32_t>(m_file, (size_t)pos);
+
+    return std::u16string_view{(const char16_t*)(m_file.data() + pos + sizeof(uint32_t)), len > 0 ? len - 1 : 0};
+}
+
+bool Document::set_bytes(uint32_t instance, uint32_t field, std::span<const uint8_t> elements, uint32_t count) {
+    const auto f = get_field(instance, field);
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    const auto& layout = m_instances[instance].layout->fields[field];
+
+    if (is_string_code(layout.code) || (!layout.array && count != 1) || elements.size() != (size_t)layout.size * count) {
+        return false;
+    }
+
+    // Stored with the padding between elements already in place.
+    Patch patch{};
+    patch.count = count;
+    patch.data.reserve(detail::get_stride(layout) * count);
+
+    for (uint32_t e = 0; e < count; ++e) {
+        detail::pad(patch.data, 0, layout.align);
+        detail::append(patch.data, elements.subspan((size_t)layout.size * e, layout.size));
+    }
+
+    m_patches[m_instances[instance].first_field + field] = std::move(patch);
+    return true;
+}
+
+bool Document::set_strings(uint32_t instance, uint32_t field, std::span<const std::u16string_view> values) {
+    const auto f = get_field(instance, field);
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    const auto& layout = m_instances[instance].layout->fields[field];
+
+    if (!is_string_code(layout.code) || (!layout.array && values.size() != 1)) {
+        return false;
+    }
+
+    Patch patch{};
+    patch.count = (uint32_t)values.size();
+
+    for (const auto& value : values) {
+        detail::pad(patch.data, 0, sizeof(uint32_t));
+
+        const auto len = (uint32_t)value.size() + 1;
+        detail::append(patch.data, {(const uint8_t*)&len, sizeof(len)});
+        detail::append(patch.data, {(const uint8_t*)value.data(), value.size() * sizeof(char16_t)});
+        patch.data.push_back(0);
+        patch.data.push_back(0);
+    }
+
+    m_patches[m_instances[instance].first_field + field] = std::move(patch);
+    return true;
+}
+
+void Document::write(std::vector<uint8_t>& out) const {
+    const auto data_start = m_rsz_offset + get_header().data_offset;
+
+    out.clear();
+    out.reserve(m_file.size() + m_file.size() / 8);
+    detail::append(out, m_file.subspan(0, data_start));
+
+    for (const auto& instance : m_instances) {
+        if (instance.layout == nullptr) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < instance.layout->fields.size(); ++i) {
+            const auto& layout = instance.layout->fields[i];
+            const auto& field = m_fields[instance.first_field + i];
+            const auto it = m_patches.find(instance.first_field + i);
+            const auto patch = it != m_patches.end() ? &it->second : nullptr;
+            const auto element_align = is_string_code(layout.code) ? (uint32_t)sizeof(uint32_t) : layout.align;
+
+            if (layout.array) {
+                const auto count = patch != nullptr ? patch->count : field.count;
+
+                detail::pad(out, m_rsz_offset, sizeof(uint32_t));
+                detail::append(out, {(const uint8_t*)&count, sizeof(count)});
+
+                if (count == 0) {
+                    continue;
+                }
+            }
+
+            // Elements are copied as one run, the padding inside it stays valid since both ends are aligned the same.
+            detail::pad(out, m_rsz_offset, element_align);
+
+            if (patch != nullptr) {
+                detail::append(out, patch->data);
+            } else {
+                detail::append(out, m_file.subspan(field.data, field.end - field.data));
+            }
+        }
+    }
+
+    detail::append(out, m_file.subspan(m_data_end));
+}
+} // namespace rsz
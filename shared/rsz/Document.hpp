@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Layout.hpp"
+
+namespace rsz {
+// The RSZ block embedded in .user/.pfb/.scn files (or a standalone one).
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    int32_t object_count;
+    int32_t instance_count;
+    int32_t userdata_count;
+    int32_t reserved;
+    uint64_t instance_offset;
+    uint64_t data_offset;
+    uint64_t userdata_offset;
+};
+
+struct InstanceInfo {
+    uint32_t type_hash;
+    uint32_t crc;
+};
+
+struct UserDataInfo {
+    uint32_t instance_id;
+    uint32_t type_hash;
+    uint64_t path_offset;
+};
+
+static_assert(sizeof(Header) == 0x30);
+static_assert(sizeof(InstanceInfo) == 8);
+static_assert(sizeof(UserDataInfo) == 0x10);
+
+constexpr uint32_t RSZ_MAGIC = 0x5A5352; // "RSZ\0"
+
+// Parsed view over an RSZ block. Nothing is copied out of the input buffer: parsing only
+// walks the instance data once to find where every field starts, and the accessors read
+// straight from the buffer, which has to outlive the Document.
+//
+// Instance 0 is the null instance. Instances that refer to external userdata files have no data.
+//
+// Modified fields are kept on the side and only applied by write(), which re-emits the
+// instance data with the alignment recomputed around them.
+class Document {
+public:
+    struct Field {
+        uint32_t start{}; // Where the field begins, the count for arrays. Relative to the input buffer
+        uint32_t data{};  // First element
+        uint32_t end{};   // One past the last element
+        uint32_t count{}; // 1 for non-arrays
+    };
+
+    struct Instance {
+        const TypeLayout* layout{nullptr}; // nullptr for the null instance, userdata references and unknown types
+        uint32_t type_hash{};
+        uint32_t crc{};
+        uint32_t first_field{}; // Index into the document's field table
+        bool external{false};   // External userdata reference
+    };
+
+    struct Stats {
+        uint32_t unknown_types{};
+        uint32_t crc_mismatches{};
+    };
+
+    // Finds the RSZ block in a .user/.pfb/.scn file (or accepts a bare one) and parses it.
+    static std::optional<Document> parse(std::span<const uint8_t> file, const LayoutDatabase& layouts, std::string* error = nullptr);
+
+    // Offset of the RSZ block within file, if there is one.
+    static std::optional<size_t> find_rsz(std::span<const uint8_t> file);
+
+    const Header& get_header() const {
+        return *(const Header*)(m_file.data() + m_rsz_offset);
+    }
+
+    std::span<const Instance> get_instances() const {
+        return m_instances;
+    }
+
+    // Instance indices of the root objects.
+    std::span<const int32_t> get_object_table() const {
+        return {(const int32_t*)(m_file.data() + m_rsz_offset + sizeof(Header)), (size_t)get_header().object_count};
+    }
+
+    std::span<const UserDataInfo> get_userdata_infos() const;
+
+    // Path of an external userdata reference.
+    std::u16string_view get_userdata_path(const UserDataInfo& info) const;
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+    const Field* get_field(uint32_t instance, uint32_t field) const {
+        if (instance >= m_instances.size()) {
+            return nullptr;
+        }
+
+        const auto& inst = m_instances[instance];
+
+        if (inst.layout == nullptr || field >= inst.layout->fields.size()) {
+            return nullptr;
+        }
+
+        return &m_fields[inst.first_field + field];
+    }
+
+    const Field* get_field(uint32_t instance, std::string_view name) const;
+
+    // Raw bytes of one element of a fixed size field.
+    std::span<const uint8_t> get_bytes(uint32_t instance, uint32_t field, uint32_t element = 0) const;
+
+    template <typename T>
+    std::optional<T> get(uint32_t instance, uint32_t field, uint32_t element = 0) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const auto bytes = get_bytes(instance, field, element);
+
+        if (bytes.size() < sizeof(T)) {
+            return std::nullopt;
+        }
+
+        T out{};
+        memcpy(&out, bytes.data(), sizeof(T));
+        return out;
+    }
+
+    // Instance index stored in an Object/UserData field.
+    std::optional<uint32_t> get_reference(uint32_t instance, uint32_t field, uint32_t element = 0) const {
+        return get<uint32_t>(instance, field, element);
+    }
+
+    // String/Resource/RuntimeType fields, without the terminator.
+    std::optional<std::u16string_view> get_string(uint32_t instance, uint32_t field, uint32_t element = 0) const;
+
+    // Replaces a fixed size field. For arrays, elements holds count tightly packed elements.
+    bool set_bytes(uint32_t instance, uint32_t field, std::span<const uint8_t> elements, uint32_t count = 1);
+
+    template <typename T>
+    bool set(uint32_t instance, uint32_t field, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return set_bytes(instance, field, {(const uint8_t*)&value, sizeof(T)});
+    }
+
+    // Replaces a string field. Arrays of strings are replaced as a whole.
+    bool set_strings(uint32_t instance, uint32_t field, std::span<const std::u16string_view> values);
+
+    bool set_string(uint32_t instance, uint32_t field, std::u16string_view value) {
+        return set_strings(instance, field, {&value, 1});
+    }
+
+    void clear_modifications() {
+        m_patches.clear();
+    }
+
+    bool is_modified() const {
+        return !m_patches.empty();
+    }
+
+    // The whole input file with the modifications applied. Everything outside of the
+    // instance data is copied as is, so the header offsets stay valid.
+    void write(std::vector<uint8_t>& out) const;
+
+private:
+    struct Patch {
+        uint32_t count{};
+        std::vector<uint8_t> data{}; // Elements, or the serialized strings
+    };
+
+    bool parse_instance_data(std::string* error);
+
+    std::span<const uint8_t> m_file{};
+    size_t m_rsz_offset{};
+    size_t m_data_end{}; // Absolute end of the instance data
+
+    std::vector<Instance> m_instances{};
+    std::vector<Field> m_fields{};
+    Stats m_stats{};
+
+    // Keyed by index into m_fields
+    std::unordered_map<uint32_t, Patch> m_patches{};
+};
+} // namespace rsz
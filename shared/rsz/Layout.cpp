@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+
+#include <json.hpp>
+
+#include "Layout.hpp"
+
+using json = nlohmann::json;
+
+namespace rsz {
+namespace detail {
+constexpr std::array<std::string_view, (size_t)TypeCode::Data + 1> g_type_code_names{
+    "Undefined", "Object", "Action", "Struct", "NativeObject", "Resource", "UserData", "Bool", "C8", "C16", "S8", "U8", "S16", "U16",
+    "S32", "U32", "S64", "U64", "F32", "F64", "String", "MBString", "Enum", "Uint2", "Uint3", "Uint4", "Int2", "Int3", "Int4", "Float2",
+    "Float3", "Float4", "Float3x3", "Float3x4", "Float4x3", "Float4x4", "Half2", "Half4", "Mat3", "Mat4", "Vec2", "Vec3", "Vec4", "VecU4",
+    "Quaternion", "Guid", "Color", "DateTime", "AABB", "Capsule", "TaperedCapsule", "Cone", "Line", "LineSegment", "OBB", "Plane",
+    "PlaneXZ", "Point", "Range", "RangeI", "Ray", "RayY", "Segment", "Size", "Sphere", "Triangle", "Cylinder", "Ellipsoid", "Area",
+    "Torus", "Rect", "Rect3D", "Frustum", "KeyFrame", "Uri", "GameObjectRef", "RuntimeType", "Sfix", "Sfix2", "Sfix3", "Sfix4",
+    "Position", "F16", "Decimal", "Data",
+};
+
+// code_typedefs in non-native-dumper.py
+constexpr std::array<std::pair<std::string_view, TypeCode>, 10> g_type_code_typedefs{{
+    {"RSZFloat", TypeCode::F32},
+    {"RSZDouble", TypeCode::F64},
+    {"ubyte", TypeCode::U8},
+    {"byte", TypeCode::S8},
+    {"RSZInt64", TypeCode::S64},
+    {"RSZInt", TypeCode::S32},
+    {"RSZShort", TypeCode::S16},
+    {"RSZUInt64", TypeCode::U64},
+    {"RSZUInt", TypeCode::U32},
+    {"RSZUShort", TypeCode::U16},
+}};
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4C5A5352; // "RSZL"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+std::optional<uint32_t> parse_hex(std::string_view str) {
+    uint32_t out{};
+    const auto result = std::from_chars(str.data(), str.data() + str.size(), out, 16);
+
+    if (result.ec != std::errc{} || result.ptr != str.data() + str.size()) {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+// The dump stores hashes as hex strings, but accept plain numbers too.
+std::optional<uint32_t> parse_hash(const json& j) {
+    if (j.is_number_unsigned() || j.is_number_integer()) {
+        return j.get<uint32_t>();
+    }
+
+    if (j.is_string()) {
+        return parse_hex(j.get_ref<const std::string&>());
+    }
+
+    return std::nullopt;
+}
+
+void set_error(std::string* error, std::string message) {
+    if (error != nullptr) {
+        *error = std::move(message);
+    }
+}
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::ofstream& stream) : m_stream{stream} {}
+
+    template <typename T>
+    void write(const T& value) {
+        m_stream.write((const char*)&value, sizeof(T));
+    }
+
+    void write(std::string_view str) {
+        write((uint32_t)str.size());
+        m_stream.write(str.data(), str.size());
+    }
+
+private:
+    std::ofstream& m_stream;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::vector<char>& data) : m_data{data} {}
+
+    template <typename T>
+    bool read(T& out) {
+        if (m_pos + sizeof(T) > m_data.size()) {
+            return false;
+        }
+
+        memcpy(&out, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string& out) {
+        uint32_t len{};
+
+        if (!read(len) || m_pos + len > m_data.size()) {
+            return false;
+        }
+
+        out.assign(m_data.data() + m_pos, len);
+        m_pos += len;
+        return true;
+    }
+
+private:
+    const std::vector<char>& m_data;
+    size_t m_pos{0};
+};
+}
+
+TypeCode parse_type_code(std::string_view name) {
+    for (size_t i = 0; i < detail::g_type_code_names.size(); ++i) {
+        if (detail::g_type_code_names[i] == name) {
+            return (TypeCode)i;
+        }
+    }
+
+    for (const auto& [alias, code] : detail::g_type_code_typedefs) {
+        if (alias == name) {
+            return code;
+        }
+    }
+
+    // use_typedefs prefixes everything else with RSZ
+    if (name.starts_with("RSZ") && name.size() > 3) {
+        return parse_type_code(name.substr(3));
+    }
+
+    return TypeCode::Data;
+}
+
+std::string_view get_type_code_name(TypeCode code) {
+    if ((size_t)code >= detail::g_type_code_names.size()) {
+        return "Data";
+    }
+
+    return detail::g_type_code_names[(size_t)code];
+}
+
+std::optional<uint32_t> TypeLayout::find_field(std::string_view field_name) const {
+    for (uint32_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].name == field_name) {
+            return i;
+        }
+    }
+
+    return std::nullopt;
+}
+
+const TypeLayout* LayoutDatabase::find(std::string_view name) const {
+    if (auto it = m_types_by_name.find(std::string{name}); it != m_types_by_name.end()) {
+        return &m_types[it->second];
+    }
+
+    return nullptr;
+}
+
+void LayoutDatabase::rebuild_index() {
+    m_types_by_hash.clear();
+    m_types_by_name.clear();
+    m_types_by_hash.reserve(m_types.size());
+    m_types_by_name.reserve(m_types.size());
+
+    for (uint32_t i = 0; i < m_types.size(); ++i) {
+        m_types_by_hash.emplace(m_types[i].hash, i);
+        m_types_by_name.emplace(m_types[i].name, i);
+    }
+}
+
+std::unique_ptr<LayoutDatabase> LayoutDatabase::load_json(const std::filesystem::path& path, std::string* error) try {
+    std::ifstream stream{path};
+
+    if (!stream) {
+        detail::set_error(error, "Failed to open " + path.string());
+        return nullptr;
+    }
+
+    const auto root = json::parse(stream);
+
+    if (!root.is_object()) {
+        detail::set_error(error, "Layout root is not an object");
+        return nullptr;
+    }
+
+    auto out = std::make_unique<LayoutDatabase>();
+    out->m_types.reserve(root.size());
+
+    for (const auto& [key, entry] : root.items()) {
+        if (!entry.is_object()) {
+            continue;
+        }
+
+        TypeLayout layout{};
+
+        // Keyed by name with a "fqn" member by default, keyed by fqn with a "name" member with use_hashkeys.
+        if (entry.contains("fqn")) {
+            layout.name = key;
+            const auto hash = detail::parse_hash(entry["fqn"]);
+
+            if (!hash) {
+                continue;
+            }
+
+            layout.hash = *hash;
+        } else {
+            const auto hash = detail::parse_hex(key);
+
+            if (!hash) {
+                continue;
+            }
+
+            layout.hash = *hash;
+            layout.name = entry.value("name", key);
+        }
+
+        if (entry.contains("crc")) {
+            layout.crc = detail::parse_hash(entry["crc"]).value_or(0);
+        }
+
+        if (entry.contains("fields") && entry["fields"].is_array()) {
+            const auto& fields = entry["fields"];
+            layout.fields.reserve(fields.size());
+
+            for (const auto& f : fields) {
+                FieldLayout field{};
+                field.name = f.value("name", "");
+                field.original_type = f.value("original_type", "");
+                field.code = parse_type_code(f.value("type", "Data"));
+                field.align = std::max<uint32_t>(f.value("align", 1u), 1u);
+                field.size = f.value("size", 0u);
+                field.array = f.value("array", false);
+                field.native = f.value("native", false);
+
+                layout.fields.emplace_back(std::move(field));
+            }
+        }
+
+        out->m_types.emplace_back(std::move(layout));
+    }
+
+    out->rebuild_index();
+    return out;
+} catch (const std::exception& e) {
+    detail::set_error(error, std::string{"Failed to parse layout JSON: "} + e.what());
+    return nullptr;
+}
+
+std::unique_ptr<LayoutDatabase> LayoutDatabase::load_snapshot(const std::filesystem::path& path, std::string* error) {
+    std::ifstream stream{path, std::ios::binary};
+
+    if (!stream) {
+        detail::set_error(error, "Failed to open " + path.string());
+        return nullptr;
+    }
+
+    const std::vector<char> data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    detail::SnapshotReader reader{data};
+
+    uint32_t magic{}, version{}, num_types{};
+
+    if (!reader.read(magic) || !reader.read(version) || !reader.read(num_types) ||
+        magic != detail::SNAPSHOT_MAGIC || version != detail::SNAPSHOT_VERSION)
+    {
+        detail::set_error(error, "Not a layout snapshot or unsupported snapshot version");
+        return nullptr;
+    }
+
+    auto out = std::make_unique<LayoutDatabase>();
+    out->m_types.resize(num_types);
+
+    for (auto& layout : out->m_types) {
+        uint32_t num_fields{};
+
+        if (!reader.read(layout.hash) || !reader.read(layout.crc) || !reader.read(layout.name) || !reader.read(num_fields)) {
+            detail::set_error(error, "Truncated layout snapshot");
+            return nullptr;
+        }
+
+        layout.fields.resize(num_fields);
+
+        for (auto& field : layout.fields) {
+            uint8_t code{}, flags{};
+
+            if (!reader.read(code) || !reader.read(flags) || !reader.read(field.align) || !reader.read(field.size) ||
+                !reader.read(field.name) || !reader.read(field.original_type))
+            {
+                detail::set_error(error, "Truncated layout snapshot");
+                return nullptr;
+            }
+
+            field.code = code <= (uint8_t)TypeCode::Data ? (TypeCode)code : TypeCode::Data;
+            field.array = (flags & 1) != 0;
+            field.native = (flags & 2) != 0;
+        }
+    }
+
+    out->rebuild_index();
+    return out;
+}
+
+std::unique_ptr<LayoutDatabase> LayoutDatabase::load(const std::filesystem::path& path, std::string* error) {
+    std::ifstream stream{path, std::ios::binary};
+    uint32_t magic{};
+
+    if (!stream || !stream.read((char*)&magic, sizeof(magic))) {
+        detail::set_error(error, "Failed to open " + path.string());
+        return nullptr;
+    }
+
+    stream.close();
+
+    if (magic == detail::SNAPSHOT_MAGIC) {
+        return load_snapshot(path, error);
+    }
+
+    return load_json(path, error);
+}
+
+bool LayoutDatabase::save_snapshot(const std::filesystem::path& path) const {
+    std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+
+    if (!stream) {
+        return false;
+    }
+
+    detail::SnapshotWriter writer{stream};
+
+    writer.write(detail::SNAPSHOT_MAGIC);
+    writer.write(detail::SNAPSHOT_VERSION);
+    writer.write((uint32_t)m_types.size());
+
+    for (const auto& layout : m_types) {
+        writer.write(layout.hash);
+        writer.write(layout.crc);
+        writer.write(std::string_view{layout.name});
+        writer.write((uint32_t)layout.fields.size());
+
+        for (const auto& field : layout.fields) {
+            writer.write((uint8_t)field.code);
+            writer.write((uint8_t)((field.array ? 1 : 0) | (field.native ? 2 : 0)));
+            writer.write(field.align);
+            writer.write(field.size);
+            writer.write(std::string_view{field.name});
+            writer.write(std::string_view{field.original_type});
+        }
+    }
+
+    return (bool)stream;
+}
+} // namespace rsz
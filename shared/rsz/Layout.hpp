@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rsz {
+namespace detail {
+// Stores message into error if the caller asked for one.
+void set_error(std::string* error, std::string message);
+}
+
+// Same order as the TypeCode list in reversing/rsz/non-native-dumper.py.
+enum class TypeCode : uint8_t {
+    Undefined,
+    Object,
+    Action,
+    Struct,
+    NativeObject,
+    Resource,
+    UserData,
+    Bool,
+    C8,
+    C16,
+    S8,
+    U8,
+    S16,
+    U16,
+    S32,
+    U32,
+    S64,
+    U64,
+    F32,
+    F64,
+    String,
+    MBString,
+    Enum,
+    Uint2,
+    Uint3,
+    Uint4,
+    Int2,
+    Int3,
+    Int4,
+    Float2,
+    Float3,
+    Float4,
+    Float3x3,
+    Float3x4,
+    Float4x3,
+    Float4x4,
+    Half2,
+    Half4,
+    Mat3,
+    Mat4,
+    Vec2,
+    Vec3,
+    Vec4,
+    VecU4,
+    Quaternion,
+    Guid,
+    Color,
+    DateTime,
+    AABB,
+    Capsule,
+    TaperedCapsule,
+    Cone,
+    Line,
+    LineSegment,
+    OBB,
+    Plane,
+    PlaneXZ,
+    Point,
+    Range,
+    RangeI,
+    Ray,
+    RayY,
+    Segment,
+    Size,
+    Sphere,
+    Triangle,
+    Cylinder,
+    Ellipsoid,
+    Area,
+    Torus,
+    Rect,
+    Rect3D,
+    Frustum,
+    KeyFrame,
+    Uri,
+    GameObjectRef,
+    RuntimeType,
+    Sfix,
+    Sfix2,
+    Sfix3,
+    Sfix4,
+    Position,
+    F16,
+    Decimal,
+    Data, // Native field the dumper couldn't name, only align/size are known
+};
+
+// Accepts the dumper's names with or without typedefs ("F32", "RSZFloat", ...). Unknown names map to Data.
+TypeCode parse_type_code(std::string_view name);
+std::string_view get_type_code_name(TypeCode code);
+
+// Serialized as a uint32 length in characters (including the terminator) followed by UTF-16 data.
+inline bool is_string_code(TypeCode code) {
+    return code == TypeCode::String || code == TypeCode::Resource || code == TypeCode::RuntimeType;
+}
+
+// Serialized as a uint32 instance index.
+inline bool is_reference_code(TypeCode code) {
+    return code == TypeCode::Object || code == TypeCode::UserData;
+}
+
+struct FieldLayout {
+    std::string name{};
+    std::string original_type{};
+    TypeCode code{TypeCode::Data};
+    uint32_t align{1};
+    uint32_t size{0}; // Of one element for arrays, unused for strings
+    bool array{false};
+    bool native{false};
+};
+
+struct TypeLayout {
+    uint32_t hash{}; // "fqn" in the dump, what instance tables refer to types by
+    uint32_t crc{};
+    std::string name{};
+    std::vector<FieldLayout> fields{};
+
+    std::optional<uint32_t> find_field(std::string_view field_name) const;
+};
+
+// Type layouts keyed by type hash, loaded from the rsz*.json that non-native-dumper.py generates
+// or from a binary snapshot of one (which loads an order of magnitude faster).
+// Immutable once loaded, so a single instance can be shared by any number of parsing threads.
+class LayoutDatabase {
+public:
+    static std::unique_ptr<LayoutDatabase> load_json(const std::filesystem::path& path, std::string* error = nullptr);
+    static std::unique_ptr<LayoutDatabase> load_snapshot(const std::filesystem::path& path, std::string* error = nullptr);
+
+    // Picks the loader by looking at the file's magic.
+    static std::unique_ptr<LayoutDatabase> load(const std::filesystem::path& path, std::string* error = nullptr);
+
+    bool save_snapshot(const std::filesystem::path& path) const;
+
+    const TypeLayout* find(uint32_t hash) const {
+        if (auto it = m_types_by_hash.find(hash); it != m_types_by_hash.end()) {
+            return &m_types[it->second];
+        }
+
+        return nullptr;
+    }
+
+    const TypeLayout* find(std::string_view name) const;
+
+    const std::vector<TypeLayout>& get_types() const {
+        return m_types;
+    }
+
+private:
+    void rebuild_index();
+
+    std::vector<TypeLayout> m_types{};
+    std::unordered_map<uint32_t, uint32_t> m_types_by_hash{};
+    std::unordered_map<std::string, uint32_t> m_types_by_name{};
+};
+} // namespace rsz
@@ -0,0 +1,141 @@
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.hpp"
+
+namespace rsz {
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+
+    MappedFile out{};
+    out.m_file = file;
+
+    LARGE_INTEGER size{};
+
+    if (!GetFileSizeEx(file, &size)) {
+        return std::nullopt;
+    }
+
+    // Mapping an empty file fails, an empty view is fine.
+    if (size.QuadPart == 0) {
+        return out;
+    }
+
+    out.m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (out.m_mapping == nullptr) {
+        return std::nullopt;
+    }
+
+    out.m_data = (const uint8_t*)MapViewOfFile(out.m_mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (out.m_data == nullptr) {
+        return std::nullopt;
+    }
+
+    out.m_size = (size_t)size.QuadPart;
+    return out;
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+
+    if (m_mapping != nullptr) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+
+    if (m_file != nullptr) {
+        CloseHandle(m_file);
+        m_file = nullptr;
+    }
+
+    m_size = 0;
+}
+#else
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1) {
+        return std::nullopt;
+    }
+
+    // The mapping outlives the descriptor, so there's nothing to keep open.
+    struct FdGuard {
+        int fd;
+        ~FdGuard() { ::close(fd); }
+    } guard{fd};
+
+    struct stat st{};
+
+    if (fstat(fd, &st) != 0) {
+        return std::nullopt;
+    }
+
+    MappedFile out{};
+
+    // Mapping an empty file fails, an empty view is fine.
+    if (st.st_size == 0) {
+        return out;
+    }
+
+    auto data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+        return std::nullopt;
+    }
+
+    posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+
+    out.m_data = (const uint8_t*)data;
+    out.m_size = (size_t)st.st_size;
+    return out;
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) {
+        munmap((void*)m_data, m_size);
+        m_data = nullptr;
+    }
+
+    m_size = 0;
+}
+#endif
+} // namespace rsz
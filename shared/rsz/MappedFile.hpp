@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace rsz {
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+    std::span<const uint8_t> data() const {
+        return {m_data, m_size};
+    }
+
+private:
+    void close();
+
+    void* m_file{nullptr};    // Windows only, the POSIX path closes the descriptor once mapped
+    void* m_mapping{nullptr}; // Windows only
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+};
+} // namespace rsz
@@ -0,0 +1,140 @@
+// Parses every .user/.pfb/.scn file under a directory with the given layouts and reports throughput.
+// Usage: rsz_bench <rsz.json|snapshot> <dir> [threads] [--snapshot <out>] [--verify-write]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <rsz/Batch.hpp>
+#include <rsz/MappedFile.hpp>
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void print_run(const char* name, const rsz::BatchStats& stats, double ms) {
+    const auto seconds = ms / 1000.0;
+
+    std::printf("%-12s %8.1fms  %6u files (%u failed)  %10llu instances  %11llu fields  %8.1f files/s  %8.1f MB/s\n",
+        name, ms, stats.files, stats.failures, (unsigned long long)stats.instances, (unsigned long long)stats.fields,
+        seconds > 0.0 ? stats.files / seconds : 0.0, seconds > 0.0 ? stats.bytes / seconds / (1024.0 * 1024.0) : 0.0);
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::printf("Usage: %s <rsz.json|snapshot> <dir> [threads] [--snapshot <out>] [--verify-write]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t num_threads = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+    const char* snapshot_path = nullptr;
+    bool verify_write = false;
+
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--verify-write") == 0) {
+            verify_write = true;
+        } else {
+            num_threads = (uint32_t)std::max(std::atoi(argv[i]), 1);
+        }
+    }
+
+    std::string error{};
+    auto start = Clock::now();
+    const auto layouts = rsz::LayoutDatabase::load(argv[1], &error);
+
+    if (layouts == nullptr) {
+        std::printf("Failed to load layouts: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::printf("Loaded %zu type layouts in %.1fms\n", layouts->get_types().size(), ms_since(start));
+
+    if (snapshot_path != nullptr) {
+        start = Clock::now();
+
+        if (!layouts->save_snapshot(snapshot_path)) {
+            std::printf("Failed to write snapshot %s\n", snapshot_path);
+            return 1;
+        }
+
+        const auto reloaded = rsz::LayoutDatabase::load_snapshot(snapshot_path, &error);
+        std::printf("Wrote and reloaded snapshot in %.1fms (%s)\n", ms_since(start), reloaded != nullptr ? "ok" : error.c_str());
+    }
+
+    start = Clock::now();
+    const auto files = rsz::find_files(argv[2]);
+    std::printf("Found %zu files in %.1fms\n", files.size(), ms_since(start));
+
+    if (files.empty()) {
+        return 0;
+    }
+
+    // Warm the file cache so the first run doesn't measure the disk.
+    rsz::parse_files(files, *layouts, {}, num_threads);
+
+    start = Clock::now();
+    const auto single = rsz::parse_files(files, *layouts, {}, 1);
+    print_run("1 thread", single, ms_since(start));
+
+    start = Clock::now();
+    const auto parallel = rsz::parse_files(files, *layouts, {}, num_threads);
+    print_run((std::to_string(num_threads) + " threads").c_str(), parallel, ms_since(start));
+
+    if (parallel.crc_mismatches > 0) {
+        std::printf("%u instances have a different CRC than their layout, the layouts are likely for another game version\n", parallel.crc_mismatches);
+    }
+
+    // Print a few failures to help tell layout problems from unsupported files.
+    std::mutex print_mtx{};
+    uint32_t printed{0};
+
+    rsz::parse_files(files, *layouts, [&](const auto& path, const rsz::Document* doc, std::string_view err) {
+        if (doc != nullptr) {
+            return;
+        }
+
+        std::scoped_lock _{print_mtx};
+
+        if (printed++ < 10) {
+            std::printf("  %s: %.*s\n", path.string().c_str(), (int)err.size(), err.data());
+        }
+    }, num_threads);
+
+    if (verify_write) {
+        std::atomic<uint32_t> mismatches{0};
+
+        start = Clock::now();
+        rsz::parse_files(files, *layouts, [&](const auto& path, const rsz::Document* doc, std::string_view) {
+            if (doc == nullptr) {
+                return;
+            }
+
+            thread_local std::vector<uint8_t> out{};
+            doc->write(out);
+
+            const auto original = rsz::MappedFile::open(path);
+
+            if (!original || original->data().size() != out.size() || std::memcmp(original->data().data(), out.data(), out.size()) != 0) {
+                if (mismatches++ < 10) {
+                    std::scoped_lock _{print_mtx};
+                    std::printf("  Round trip differs: %s\n", path.string().c_str());
+                }
+            }
+        }, num_threads);
+
+        std::printf("Round trip: %u of %u parsed files differ (%.1fms)\n", mismatches.load(), parallel.files - parallel.failures, ms_since(start));
+    }
+
+    return 0;
+}
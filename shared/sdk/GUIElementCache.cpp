@@ -0,0 +1,106 @@
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#include <utility/String.hpp>
+
+#include "ReClass.hpp"
+#include "RETypeDefinition.hpp"
+#include "SceneManager.hpp"
+#include "GUIElementCache.hpp"
+
+namespace sdk {
+namespace detail {
+std::atomic<uint32_t> g_gui_element_cache_next_slot{0};
+thread_local std::shared_ptr<GUIElementCache::Entry> t_current_gui_element{};
+}
+
+GUIElementCache& GUIElementCache::get() {
+    static GUIElementCache instance{};
+    return instance;
+}
+
+uint32_t GUIElementCache::allocate_slot() {
+    const auto slot = detail::g_gui_element_cache_next_slot.fetch_add(1);
+    return slot < MAX_SLOTS ? slot : UINT32_MAX;
+}
+
+std::shared_ptr<GUIElementCache::Entry> GUIElementCache::set_current(std::shared_ptr<Entry> entry) {
+    return std::exchange(detail::t_current_gui_element, std::move(entry));
+}
+
+uint64_t GUIElementCache::get_name_key(::REGameObject* game_object) {
+    // Either the string pointer or the first characters, plus the length.
+    uint64_t first{};
+    memcpy(&first, &game_object->name, sizeof(first));
+
+    return first ^ ((uint64_t)(uint32_t)game_object->name.length << 32);
+}
+
+std::shared_ptr<GUIElementCache::Entry> GUIElementCache::lookup(::REComponent* gui_element) {
+    if (gui_element == nullptr) {
+        return nullptr;
+    }
+
+    if (const auto& current = detail::t_current_gui_element; current != nullptr && current->element == gui_element) {
+        return current;
+    }
+
+    const auto game_object = utility::re_component::get_game_object(gui_element);
+
+    if (game_object == nullptr || game_object->transform == nullptr) {
+        return nullptr;
+    }
+
+    const auto name_key = get_name_key(game_object);
+
+    {
+        std::shared_lock _{m_mtx};
+
+        if (auto it = m_entries.find(gui_element); it != m_entries.end()) {
+            const auto& entry = it->second;
+
+            if (entry->game_object == game_object && entry->transform == game_object->transform && entry->name_key == name_key) {
+                return entry;
+            }
+        }
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->element = gui_element;
+    entry->game_object = game_object;
+    entry->transform = game_object->transform;
+    entry->name_key = name_key;
+    entry->name = utility::re_string::get_string(game_object->name);
+    entry->name_hash = utility::hash(entry->name);
+
+    if (const auto t = utility::re_managed_object::get_type_definition(gui_element); t != nullptr) {
+        entry->type_index = t->get_index();
+    }
+
+    std::unique_lock _{m_mtx};
+
+    if (m_entries.size() >= MAX_ENTRIES) {
+        m_entries.clear();
+    }
+
+    m_entries[gui_element] = entry;
+    return entry;
+}
+
+void GUIElementCache::on_frame() {
+    const auto scene = sdk::get_current_scene();
+
+    if (scene == m_last_scene) {
+        return;
+    }
+
+    m_last_scene = scene;
+    clear();
+}
+
+void GUIElementCache::clear() {
+    std::unique_lock _{m_mtx};
+    m_entries.clear();
+}
+} // namespace sdk
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+class REComponent;
+class REGameObject;
+class REManagedObject;
+class RETransform;
+
+namespace sdk {
+// Per-element facts about GUI elements, for the gui draw hook which runs for every element every frame.
+// Entries are keyed by element address, so a GameObject with several GUI components gets one entry each.
+// An entry is rebuilt when the element at that address no longer matches it (different GameObject,
+// name or transform), and the whole cache is dropped on scene change.
+class GUIElementCache {
+public:
+    static constexpr size_t MAX_SLOTS = 8;
+    static constexpr size_t MAX_ENTRIES = 16384; // Cleared past this, catches objects destroyed without a scene change
+
+    struct Entry {
+        ::REComponent* element{nullptr};
+        ::REGameObject* game_object{nullptr};
+        ::RETransform* transform{nullptr};
+        uint64_t name_key{};   // Raw REString words, to notice a new object reusing the address
+        std::string name{};
+        size_t name_hash{};    // utility::hash(name), matches the _fnv literals
+        uint32_t type_index{}; // TDB index of the element's type
+
+        // Owned by whoever allocated the slot, 0 = not classified yet.
+        std::array<std::atomic<uint8_t>, MAX_SLOTS> slots{};
+    };
+
+    static GUIElementCache& get();
+
+    // Reserves a per-entry byte for a mod's own classification. UINT32_MAX once they run out.
+    static uint32_t allocate_slot();
+
+    // nullptr if the element has no GameObject or transform.
+    std::shared_ptr<Entry> lookup(::REComponent* gui_element);
+
+    // Set by the gui draw hook for the element being drawn on this thread, so the mods
+    // it calls into don't each look it up again. Returns the previous one, for nested draws.
+    static std::shared_ptr<Entry> set_current(std::shared_ptr<Entry> entry);
+
+    // Drops everything if the current scene changed since the last call.
+    void on_frame();
+    void clear();
+
+private:
+    static uint64_t get_name_key(::REGameObject* game_object);
+
+    std::shared_mutex m_mtx{};
+    std::unordered_map<::REComponent*, std::shared_ptr<Entry>> m_entries{};
+    ::REManagedObject* m_last_scene{nullptr};
+};
+} // namespace sdk
@@ -0,0 +1,109 @@
+#include <spdlog/spdlog.h>
+
+#include "RETypeDefinition.hpp"
+#include "Method.hpp"
+
+namespace sdk {
+namespace detail {
+bool is_floating_type(sdk::RETypeDefinition* t) {
+    const auto name = t->get_full_name();
+    return name == "System.Single" || name == "System.Double";
+}
+
+// Passed or returned in a register as is (primitives, enums).
+bool matches_register_value(sdk::RETypeDefinition* t, NativeTypeShape shape) {
+    using Kind = NativeTypeShape::Kind;
+
+    if (shape.kind == Kind::NONE || shape.kind == Kind::STRUCT) {
+        return false;
+    }
+
+    if ((shape.kind == Kind::FLOATING) != is_floating_type(t)) {
+        return false;
+    }
+
+    // Pointers are fine for System.IntPtr and friends. Other than that the size has to match exactly
+    // or the upper bits of the register end up in the value.
+    const auto size = t->get_valuetype_size();
+
+    return size == 0 || shape.size == size;
+}
+
+bool matches_param(sdk::RETypeDefinition* t, NativeTypeShape shape) {
+    if (t == nullptr) {
+        return true;
+    }
+
+    if (t->should_pass_by_pointer()) {
+        return shape.kind == NativeTypeShape::Kind::POINTER;
+    }
+
+    return matches_register_value(t, shape);
+}
+
+bool matches_return(sdk::RETypeDefinition* t, NativeTypeShape shape) {
+    using Kind = NativeTypeShape::Kind;
+
+    if (t == nullptr || t->get_full_name() == "System.Void") {
+        return shape.kind == Kind::NONE;
+    }
+
+    if (!t->is_value_type()) {
+        return shape.kind == Kind::POINTER || shape.kind == Kind::NONE;
+    }
+
+    const auto size = t->get_valuetype_size();
+    const auto through_buffer = size > sizeof(void*) || (!t->is_primitive() && !t->is_enum());
+    const auto shape_through_buffer = shape.kind == Kind::STRUCT || shape.size > sizeof(void*);
+
+    if (through_buffer) {
+        // A bigger buffer is fine, vec3 is commonly read into a Vector4f.
+        return shape_through_buffer && shape.size >= size;
+    }
+
+    // Ignoring a value that comes back in a register is harmless.
+    return shape.kind == Kind::NONE || matches_register_value(t, shape);
+}
+
+bool validate_method_signature(const sdk::REMethodDefinition* method, NativeTypeShape ret, std::span<const NativeTypeShape> params) {
+    const auto declaring_type = method->get_declaring_type();
+    const auto declaring_name = declaring_type != nullptr ? declaring_type->get_full_name() : "unknownclass";
+
+    const auto fail = [&](const std::string& reason) {
+        spdlog::error("[sdk::Method] Signature mismatch for {}.{}: {}", declaring_name, method->get_name(), reason);
+        return false;
+    };
+
+    const auto has_this = !method->is_static();
+    const auto expected_params = method->get_num_params() + (has_this ? 1 : 0);
+
+    if (params.size() != expected_params) {
+        return fail(fmt::format("expected {} arguments{}, got {}", expected_params, has_this ? " including this" : "", params.size()));
+    }
+
+    if (has_this && params[0].kind != NativeTypeShape::Kind::POINTER) {
+        return fail("this must be a pointer");
+    }
+
+    const auto param_types = method->get_param_types();
+    const auto first_param = has_this ? 1 : 0;
+
+    for (size_t i = 0; i < param_types.size() && first_param + i < params.size(); ++i) {
+        const auto t = param_types[i];
+
+        if (!matches_param(t, params[first_param + i])) {
+            return fail(fmt::format("argument {} ({}) {}", i, t->get_full_name(),
+                t->should_pass_by_pointer() ? "is passed by pointer" : "doesn't match the declared type"));
+        }
+    }
+
+    const auto ret_type = method->get_return_type();
+
+    if (!matches_return(ret_type, ret)) {
+        return fail(fmt::format("return type {} doesn't match the declared type", ret_type != nullptr ? ret_type->get_full_name() : "void"));
+    }
+
+    return true;
+}
+}
+}
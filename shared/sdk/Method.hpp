@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "RETypeDB.hpp"
+
+namespace sdk {
+namespace detail {
+// What the native calling convention cares about for a C++ type in a bound signature.
+struct NativeTypeShape {
+    enum class Kind : uint8_t {
+        NONE, // void
+        POINTER,
+        INTEGER,
+        FLOATING,
+        STRUCT,
+    };
+
+    Kind kind{Kind::NONE};
+    uint32_t size{};
+};
+
+template <typename T>
+constexpr NativeTypeShape get_native_type_shape() {
+    using Kind = NativeTypeShape::Kind;
+
+    if constexpr (std::is_void_v<T>) {
+        return {Kind::NONE, 0};
+    } else if constexpr (std::is_pointer_v<T>) {
+        return {Kind::POINTER, sizeof(T)};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return {Kind::FLOATING, sizeof(T)};
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        return {Kind::INTEGER, sizeof(T)};
+    } else {
+        return {Kind::STRUCT, sizeof(T)};
+    }
+}
+
+// Same rule the engine uses: structs (and anything wider than a register) come back
+// through a buffer the caller passes in front of the thread context.
+template <typename T>
+constexpr bool returns_through_buffer() {
+    constexpr auto shape = get_native_type_shape<T>();
+    return shape.kind == NativeTypeShape::Kind::STRUCT || shape.size > sizeof(void*);
+}
+
+// Checks the C++ signature against the TDB, logs what doesn't match.
+// params includes the this pointer for instance methods.
+bool validate_method_signature(const sdk::REMethodDefinition* method, NativeTypeShape ret, std::span<const NativeTypeShape> params);
+}
+
+template <typename Sig>
+class Method;
+
+// Statically typed binding to a native method, e.g.
+//   static const sdk::Method<glm::quat(REJoint*)> get_rotation{"via.Joint", "get_Rotation"};
+//   const auto rotation = get_rotation(joint);
+// The signature is checked against the TDB and the function pointer resolved once when binding,
+// calls after that go straight to the function. Instance methods take this as their first argument,
+// the thread context and the return buffer for structs are filled in automatically.
+// Structs that are passed by pointer to the engine (vec3, quaternion...) are declared as pointers.
+template <typename Ret, typename... Args>
+class Method<Ret(Args...)> {
+public:
+    Method() = default;
+
+    Method(const sdk::REMethodDefinition* method) {
+        bind(method);
+    }
+
+    Method(std::string_view type_name, std::string_view method_name) {
+        bind(sdk::find_method_definition(type_name, method_name));
+    }
+
+    bool bind(const sdk::REMethodDefinition* method) {
+        m_method = nullptr;
+        m_function = nullptr;
+
+        if (method == nullptr) {
+            return false;
+        }
+
+        static constexpr std::array<detail::NativeTypeShape, sizeof...(Args)> param_shapes{detail::get_native_type_shape<Args>()...};
+
+        if (!detail::validate_method_signature(method, detail::get_native_type_shape<Ret>(), param_shapes)) {
+            return false;
+        }
+
+        m_method = method;
+        m_function = method->get_function();
+
+        return m_function != nullptr;
+    }
+
+    // Unbound methods return a default constructed Ret, like call_native_func does for missing methods.
+    Ret operator()(Args... args) const {
+        if (m_function == nullptr) {
+            return Ret();
+        }
+
+        return call_direct(args...);
+    }
+
+    // Catches exceptions thrown by the engine, see VMContext::safe_wrap.
+    Ret call_safe(Args... args) const {
+        if (m_function == nullptr) {
+            return Ret();
+        }
+
+        if constexpr (std::is_void_v<Ret>) {
+            sdk::VMContext::safe_wrap(m_method->get_name(), [&]() {
+                call_direct(args...);
+            });
+        } else {
+            Ret result{};
+            sdk::VMContext::safe_wrap(m_method->get_name(), [&]() {
+                result = call_direct(args...);
+            });
+
+            return result;
+        }
+    }
+
+    explicit operator bool() const {
+        return m_function != nullptr;
+    }
+
+    const sdk::REMethodDefinition* get_definition() const {
+        return m_method;
+    }
+
+    void* get_function() const {
+        return m_function;
+    }
+
+private:
+    Ret call_direct(Args... args) const {
+        const auto context = sdk::get_thread_context();
+
+        if constexpr (detail::returns_through_buffer<Ret>()) {
+            Ret out{};
+            ((Ret* (*)(Ret*, sdk::VMContext*, Args...))m_function)(&out, context, args...);
+
+            return out;
+        } else {
+            return ((Ret (*)(sdk::VMContext*, Args...))m_function)(context, args...);
+        }
+    }
+
+    const sdk::REMethodDefinition* m_method{nullptr};
+    void* m_function{nullptr};
+};
+}
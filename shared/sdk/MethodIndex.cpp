@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+#include <utility/Module.hpp>
+
+#include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+#include "MethodIndex.hpp"
+
+namespace sdk {
+namespace detail {
+enum class MethodIndexState {
+    IDLE,
+    BUILDING,
+    BUILT,
+};
+
+std::mutex g_method_index_mtx{};
+std::condition_variable g_method_index_cv{};
+MethodIndexState g_method_index_state{MethodIndexState::IDLE};
+
+// Published once and intentionally leaked, readers never lock.
+std::atomic<const MethodAddressIndex*> g_method_index{nullptr};
+}
+
+std::string MethodAddressIndex::Symbol::to_string() const {
+    std::array<char, 512> buffer{};
+    return std::string{format(buffer)};
+}
+
+std::string_view MethodAddressIndex::Symbol::format(std::span<char> out) const {
+    if (out.empty()) {
+        return {};
+    }
+
+    const auto method_name = method != nullptr ? method->get_name() : nullptr;
+
+    if (method_name == nullptr) {
+        return {"<unknown>"};
+    }
+
+    const auto result = type_name[0] != '\0' ?
+        fmt::format_to_n(out.data(), out.size(), "{}.{}", type_name, method_name) :
+        fmt::format_to_n(out.data(), out.size(), "{}", method_name);
+
+    auto size = std::min<size_t>(result.size, out.size());
+
+    if (offset != 0 && size < out.size()) {
+        size += std::min<size_t>(fmt::format_to_n(out.data() + size, out.size() - size, "+0x{:x}", offset).size, out.size() - size);
+    }
+
+    return std::string_view{out.data(), size};
+}
+
+const MethodAddressIndex* MethodAddressIndex::get() {
+    return detail::g_method_index.load(std::memory_order_acquire);
+}
+
+void MethodAddressIndex::build_async() {
+    {
+        std::scoped_lock _{detail::g_method_index_mtx};
+
+        if (detail::g_method_index_state != detail::MethodIndexState::IDLE) {
+            return;
+        }
+
+        detail::g_method_index_state = detail::MethodIndexState::BUILDING;
+    }
+
+    std::thread{[] {
+        const auto index = build();
+
+        std::scoped_lock _{detail::g_method_index_mtx};
+        detail::g_method_index.store(index, std::memory_order_release);
+
+        // Go back to idle if the TDB wasn't ready so the next caller retries.
+        detail::g_method_index_state = index != nullptr ? detail::MethodIndexState::BUILT : detail::MethodIndexState::IDLE;
+        detail::g_method_index_cv.notify_all();
+    }}.detach();
+}
+
+const MethodAddressIndex* MethodAddressIndex::wait() {
+    if (const auto index = get(); index != nullptr) {
+        return index;
+    }
+
+    std::unique_lock lock{detail::g_method_index_mtx};
+
+    if (detail::g_method_index_state == detail::MethodIndexState::IDLE) {
+        detail::g_method_index_state = detail::MethodIndexState::BUILDING;
+        lock.unlock();
+
+        const auto index = build();
+
+        lock.lock();
+        detail::g_method_index.store(index, std::memory_order_release);
+        detail::g_method_index_state = index != nullptr ? detail::MethodIndexState::BUILT : detail::MethodIndexState::IDLE;
+        detail::g_method_index_cv.notify_all();
+
+        return index;
+    }
+
+    detail::g_method_index_cv.wait(lock, [] { return detail::g_method_index_state != detail::MethodIndexState::BUILDING; });
+    return get();
+}
+
+MethodAddressIndex* MethodAddressIndex::build() try {
+    const auto tdb = sdk::RETypeDB::get();
+
+    if (tdb == nullptr) {
+        return nullptr;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::pair<uintptr_t, uint32_t>> entries{};
+    entries.reserve(tdb->get_num_methods());
+
+    for (uint32_t i = 0; i < tdb->get_num_methods(); ++i) {
+        const auto method = tdb->get_method(i);
+
+        if (method == nullptr) {
+            continue;
+        }
+
+        const auto func = (uintptr_t)method->get_function();
+
+        if (func == 0) {
+            continue;
+        }
+
+        entries.emplace_back(func, i);
+    }
+
+    // Sorting by (address, index) puts the lowest method index first for shared functions.
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), entries.end());
+
+    auto out = new MethodAddressIndex{};
+    out->m_starts.reserve(entries.size());
+    out->m_methods.reserve(entries.size());
+
+    out->m_type_name_offsets.reserve(entries.size());
+
+    // Names shared by every method of a type are only stored once.
+    std::unordered_map<const sdk::RETypeDefinition*, uint32_t> type_name_offsets{};
+    out->m_type_names.push_back('\0'); // Offset 0 is the empty name for methods without a declaring type
+
+    for (const auto& [func, index] : entries) {
+        out->m_starts.push_back(func);
+        out->m_methods.push_back(index);
+
+        const auto decl_type = tdb->get_method(index)->get_declaring_type();
+        uint32_t name_offset{};
+
+        if (decl_type != nullptr) {
+            auto [it, inserted] = type_name_offsets.try_emplace(decl_type, (uint32_t)out->m_type_names.size());
+
+            if (inserted) {
+                out->m_type_names += decl_type->get_full_name();
+                out->m_type_names.push_back('\0');
+            }
+
+            name_offset = it->second;
+        }
+
+        out->m_type_name_offsets.push_back(name_offset);
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    spdlog::info("[MethodAddressIndex] Indexed {} method entry points in {}ms",
+        out->m_starts.size(), std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+
+    return out;
+} catch (...) {
+    spdlog::error("[MethodAddressIndex] Failed to build method address index");
+    return nullptr;
+}
+
+std::optional<MethodAddressIndex::Symbol> MethodAddressIndex::find_nearest(uintptr_t addr) const {
+    const auto it = std::upper_bound(m_starts.begin(), m_starts.end(), addr);
+
+    if (it == m_starts.begin()) {
+        return std::nullopt;
+    }
+
+    const auto i = (size_t)std::distance(m_starts.begin(), it) - 1;
+    const auto method = sdk::RETypeDB::get()->get_method(m_methods[i]);
+
+    if (method == nullptr) {
+        return std::nullopt;
+    }
+
+    return Symbol{method, m_starts[i], addr - m_starts[i], m_type_names.data() + m_type_name_offsets[i]};
+}
+
+std::optional<MethodAddressIndex::Symbol> MethodAddressIndex::find(uintptr_t addr) const {
+    const auto nearest = find_nearest(addr);
+
+    if (!nearest) {
+        return std::nullopt;
+    }
+
+    const auto method_entry = utility::find_function_entry(nearest->start);
+
+    // No unwind info (leaf function), the next entry point is the only bound we have.
+    if (method_entry == nullptr) {
+        return nearest;
+    }
+
+    const auto module_addr = (uintptr_t)utility::get_module_within(addr).value_or(nullptr);
+    const auto addr_rva = (uint32_t)(addr - module_addr);
+
+    if (module_addr != 0 && addr_rva >= method_entry->BeginAddress && addr_rva <= method_entry->EndAddress) {
+        return nearest;
+    }
+
+    // Chained entries for cold or split parts of the method.
+    const auto addr_entry = utility::find_function_entry(addr);
+
+    if (addr_entry == method_entry ||
+        (addr_entry != nullptr && addr_entry->BeginAddress >= method_entry->BeginAddress && addr_entry->BeginAddress <= method_entry->EndAddress + 1))
+    {
+        return nearest;
+    }
+
+    return std::nullopt;
+}
+
+sdk::REMethodDefinition* MethodAddressIndex::find_exact(uintptr_t addr) const {
+    const auto it = std::lower_bound(m_starts.begin(), m_starts.end(), addr);
+
+    if (it == m_starts.end() || *it != addr) {
+        return nullptr;
+    }
+
+    return sdk::RETypeDB::get()->get_method(m_methods[std::distance(m_starts.begin(), it)]);
+}
+
+std::optional<MethodAddressIndex::Symbol> symbolize(uintptr_t addr) {
+    const auto index = MethodAddressIndex::get();
+
+    if (index == nullptr) {
+        return std::nullopt;
+    }
+
+    return index->find(addr);
+}
+} // namespace sdk
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdk {
+struct REMethodDefinition;
+
+// Sorted table of every method's native entry point, for turning a code address
+// (return address, crash RIP, ...) back into the method that contains it.
+// Built once, never freed, and immutable afterwards, so lookups are lock-free
+// and safe to do from hooks or the exception handler.
+class MethodAddressIndex {
+public:
+    struct Symbol {
+        sdk::REMethodDefinition* method{nullptr};
+        uintptr_t start{};     // Entry point of method
+        uintptr_t offset{};    // Queried address - start
+        const char* type_name{""}; // Full name of the declaring type, resolved when the index was built
+
+        // Declaring.Type.method+0xoffset
+        std::string to_string() const;
+
+        // Same as to_string, written into out (truncated if needed). Does not allocate or lock.
+        std::string_view format(std::span<char> out) const;
+    };
+
+    // nullptr until the index has been built.
+    static const MethodAddressIndex* get();
+
+    // Starts building on a background thread. Does nothing if already started or built.
+    static void build_async();
+
+    // Builds on the calling thread if nobody started a build yet, otherwise waits for it.
+    static const MethodAddressIndex* wait();
+
+    // Method with the highest entry point <= addr, without checking that addr is actually inside it.
+    std::optional<Symbol> find_nearest(uintptr_t addr) const;
+
+    // find_nearest, but rejects addresses that the unwind info places outside of the method.
+    // Does not allocate, so it can be used while handling an exception.
+    std::optional<Symbol> find(uintptr_t addr) const;
+
+    // Method whose entry point is exactly addr.
+    sdk::REMethodDefinition* find_exact(uintptr_t addr) const;
+
+    size_t size() const { return m_starts.size(); }
+
+private:
+    static MethodAddressIndex* build();
+
+    // Kept apart so the binary search only touches the addresses.
+    // Functions shared by several methods map to the one with the lowest TDB index.
+    std::vector<uintptr_t> m_starts{};
+    std::vector<uint32_t> m_methods{};
+
+    // Declaring type names are resolved up front so symbolizing never goes through get_full_name
+    // (which locks and allocates) from the exception handler.
+    std::string m_type_names{};              // Null terminated names, back to back
+    std::vector<uint32_t> m_type_name_offsets{}; // Per entry, into m_type_names
+};
+
+// MethodAddressIndex::get()->find(addr) if the index is built.
+std::optional<MethodAddressIndex::Symbol> symbolize(uintptr_t addr);
+} // namespace sdk
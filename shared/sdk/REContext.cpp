@@ -636,28 +636,105 @@ namespace sdk {
     }
 
     ::SystemString* VM::create_managed_string(std::wstring_view str) {
+        static auto string_type = sdk::find_type_definition("System.String");
+
+        // Same allocator the engine uses for new strings, comes back with zeroed data of the requested length.
+        static auto fast_allocate_string = string_type != nullptr ? string_type->get_method("FastAllocateString") : nullptr;
+        static auto clone_method = string_type != nullptr ? string_type->get_method("Clone") : nullptr;
         static auto empty_string = *sdk::get_static_field<REManagedObject*>("System.String", "Empty");
-        static std::vector<uint8_t> huge_string_data{};
 
-        if (huge_string_data.empty()) {
-            huge_string_data.resize(sizeof(REManagedObject) + 4 + 2048);
-            memset(&huge_string_data[0], 0, huge_string_data.size());
+        const auto str_len = str.length();
+        const auto context = sdk::get_thread_context();
+        ::SystemString* out{nullptr};
+
+        if (fast_allocate_string != nullptr) {
+            out = fast_allocate_string->call<::SystemString*>(context, (int32_t)str_len);
+        } else if (clone_method != nullptr && empty_string != nullptr) {
+            // Fall back to cloning a blank string of the right length.
+            // Per thread so concurrent callers don't stomp on each other's size.
+            thread_local std::vector<uint8_t> template_data{};
+
+            const auto needed_size = sizeof(REManagedObject) + sizeof(int32_t) + (str_len + 1) * sizeof(wchar_t);
+
+            if (template_data.size() < needed_size) {
+                template_data.clear();
+                template_data.resize(std::max<size_t>(needed_size, sizeof(REManagedObject) + sizeof(int32_t) + 2048 * sizeof(wchar_t)), 0);
+                memcpy(template_data.data(), empty_string, sizeof(REManagedObject));
+            }
 
-            auto huge_string = (SystemString*)&huge_string_data[0];
-            memcpy(huge_string, empty_string, sizeof(REManagedObject));
-        }
+            auto template_string = (::SystemString*)template_data.data();
+            template_string->size = (int32_t)str_len;
 
-        const auto str_len = str.length();
-        auto huge_string = (SystemString*)&huge_string_data[0];
-        huge_string->size = (int32_t)str_len;
+            out = clone_method->call<::SystemString*>(context, template_string);
+        }
 
-        auto out = (SystemString*)sdk::invoke_object_func(huge_string, "Clone", {}).ptr;
+        if (out == nullptr) {
+            return nullptr;
+        }
 
         memcpy(out->data, str.data(), str_len * sizeof(wchar_t));
 
         return out;
     }
 
+    namespace detail {
+    struct InternedStringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::wstring_view s) const {
+            return std::hash<std::wstring_view>{}(s);
+        }
+    };
+
+    constexpr size_t MAX_INTERNED_STRINGS = 8192;
+    constexpr size_t MAX_INTERNED_STRING_LENGTH = 512;
+
+    std::shared_mutex g_interned_strings_mtx{};
+    std::unordered_map<std::wstring, ::SystemString*, InternedStringHash, std::equal_to<>> g_interned_strings{};
+    }
+
+    ::SystemString* VM::create_managed_string_interned(std::wstring_view str) {
+        {
+            std::shared_lock _{detail::g_interned_strings_mtx};
+
+            if (auto it = detail::g_interned_strings.find(str); it != detail::g_interned_strings.end()) {
+                return it->second;
+            }
+        }
+
+        // Don't let the table grow forever from strings that only look constant.
+        if (str.length() > detail::MAX_INTERNED_STRING_LENGTH) {
+            return create_managed_string(str);
+        }
+
+        std::unique_lock _{detail::g_interned_strings_mtx};
+
+        if (auto it = detail::g_interned_strings.find(str); it != detail::g_interned_strings.end()) {
+            return it->second;
+        }
+
+        if (detail::g_interned_strings.size() >= detail::MAX_INTERNED_STRINGS) {
+            return create_managed_string(str);
+        }
+
+        auto out = create_managed_string(str);
+
+        if (out == nullptr) {
+            return nullptr;
+        }
+
+        // Never released, the GC leaves it alone for the rest of the process.
+        utility::re_managed_object::add_ref((::REManagedObject*)out);
+        detail::g_interned_strings.emplace(std::wstring{str}, out);
+
+        return out;
+    }
+
+    size_t VM::get_num_interned_strings() {
+        std::shared_lock _{detail::g_interned_strings_mtx};
+        return detail::g_interned_strings.size();
+    }
+
     sdk::SystemArray* VM::create_managed_array(::REManagedObject* runtime_type, uint32_t length) {
         static auto system_array_type = sdk::find_type_definition("System.Array");
         static auto create_instance_method = system_array_type->get_method("CreateInstance");
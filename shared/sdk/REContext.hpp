@@ -53,7 +53,12 @@ public:
     uint8_t* get_static_tbl_for_type(uint32_t type_index);
 
     static sdk::InvokeMethod* get_invoke_table();
-    static SystemString* create_managed_string(std::wstring_view str); // System.String
+    static SystemString* create_managed_string(std::wstring_view str); // System.String, thread safe
+
+    // Shared, immortal instance per distinct string (add_ref'd once, never released).
+    // For names that get passed to the engine over and over (joints, types, signatures), never mutate the result.
+    static SystemString* create_managed_string_interned(std::wstring_view str);
+    static size_t get_num_interned_strings();
     static sdk::SystemArray* create_managed_array(::REManagedObject* runtime_type, uint32_t length); // System.Array
 
     static ::REManagedObject* create_sbyte(int8_t value); // System.SByte
@@ -8,6 +8,7 @@
 #include "RETypeDB.hpp"
 #include "REType.hpp"
 #include "RETypes.hpp"
+#include "SceneManager.hpp"
 
 #include "REGlobals.hpp"
 
@@ -113,15 +114,22 @@ REGlobals::REGlobals() {
 
 std::vector<REManagedObject*> REGlobals::get_objects() {
     std::vector<REManagedObject*> out{};
+    get_objects(out);
+
+    return out;
+}
+
+std::vector<REManagedObject*>& REGlobals::get_objects(std::vector<REManagedObject*>& out) {
+    out.clear();
 
     if (!m_object_list.empty()) {
         for (auto obj_ptr : m_object_list) {
-            if (*obj_ptr != nullptr && !IsBadReadPtr(*obj_ptr, sizeof(void*))) {
+            if (*obj_ptr != nullptr && utility::re_managed_object::is_managed_object(*obj_ptr)) {
                 out.push_back(*obj_ptr);
             }
         }
     } else {
-        for (auto getter : m_getters) {
+        for (auto& getter : m_getters) {
             auto result = getter.second();
 
             if (result != nullptr) {
@@ -163,35 +171,81 @@ std::vector<::REType*>& REGlobals::get_native_singleton_types() {
     return m_native_singleton_types;
 }
 
-REManagedObject* REGlobals::get(std::string_view name) {
-    std::lock_guard _{ m_map_mutex };
+REManagedObject* REGlobals::find_object(std::string_view name) const {
+    const auto map = m_object_map.load(std::memory_order_acquire);
 
-    auto get_obj = [&]() -> REManagedObject* {
-        if (m_object_map.empty()) {
-            auto getter = m_getters.find(name.data());
+    if (map == nullptr) {
+        return nullptr;
+    }
 
-            if (getter != m_getters.end()) {
-                return getter->second();
-            }
-        }
+    if (auto it = map->find(name); it != map->end()) {
+        return *it->second;
+    }
+
+    return nullptr;
+}
+
+void REGlobals::update_scene_epoch() {
+    // Not created yet early on
+    if (sdk::get_scene_manager() == nullptr) {
+        return;
+    }
+
+    const auto scene = sdk::get_current_scene();
+
+    if (scene != m_last_scene) {
+        m_last_scene = scene;
+        m_scene_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+}
 
-        if (auto it = m_object_map.find(name.data()); it != m_object_map.end()) {
-            return *it->second;
+REManagedObject* REGlobals::get(std::string_view name) {
+    // The getters are only filled in at construction, no lock needed.
+    if (m_object_list.empty()) {
+        if (auto getter = m_getters.find(name); getter != m_getters.end()) {
+            return getter->second();
         }
+    }
 
-        return nullptr;
-    };
+    if (auto obj = find_object(name); obj != nullptr) {
+        return obj;
+    }
 
-    auto obj = get_obj();
+    std::lock_guard _{ m_map_mutex };
+
+    const auto now = GetTickCount64();
+    const auto scene_epoch = m_scene_epoch.load(std::memory_order_relaxed);
+
+    auto miss = m_misses.find(name);
+
+    if (miss != m_misses.end() && miss->second.scene_epoch == scene_epoch && now < miss->second.expires) {
+        return nullptr;
+    }
 
     // try to refresh the map if the object doesnt exist.
-    // assume the user knows this object exists.
-    if (obj == nullptr) {
+    // assume the user knows this object exists, so the first miss always refreshes.
+    const auto refresh_due = now - m_last_refresh_time >= REFRESH_INTERVAL_MS || m_last_refresh_scene_epoch != scene_epoch;
+
+    if (miss == m_misses.end() || refresh_due) {
         refresh_map();
     }
 
     // try again after refreshing the map
-    return obj == nullptr ? get_obj() : obj;
+    if (auto obj = find_object(name); obj != nullptr) {
+        if (miss != m_misses.end()) {
+            m_misses.erase(miss);
+        }
+
+        return obj;
+    }
+
+    if (miss != m_misses.end()) {
+        miss->second = Miss{now + MISS_LIFETIME_MS, scene_epoch};
+    } else {
+        m_misses.emplace(std::string{name}, Miss{now + MISS_LIFETIME_MS, scene_epoch});
+    }
+
+    return nullptr;
 }
 
 REManagedObject* REGlobals::operator[](std::string_view name) {
@@ -201,6 +255,7 @@ REManagedObject* REGlobals::operator[](std::string_view name) {
 void REGlobals::safe_refresh() {
     std::lock_guard _{ m_map_mutex };
     refresh_map();
+    m_misses.clear();
 }
 
 void REGlobals::safe_refresh_native() {
@@ -232,6 +287,9 @@ void REGlobals::refresh_natives() {
 }
 
 void REGlobals::refresh_map() {
+    const auto current = m_object_map.load(std::memory_order_acquire);
+    std::unique_ptr<ObjectMap> updated{};
+
     for (auto obj_ptr : m_objects) {
         auto obj = *obj_ptr;
 
@@ -240,11 +298,11 @@ void REGlobals::refresh_map() {
             continue;
         }
 
-        if (IsBadReadPtr(obj, sizeof(REManagedObject))) {
+        if (!utility::re_managed_object::is_managed_object(obj)) {
             continue;
         }
 
-        auto t = utility::re_managed_object::safe_get_type(obj);
+        auto t = utility::re_managed_object::get_type(obj);
 
         if (t == nullptr || t->name == nullptr) {
             continue;
@@ -257,6 +315,26 @@ void REGlobals::refresh_map() {
             m_acknowledged_objects.insert(obj_ptr);
         }
 
-        m_object_map[t->name] = obj_ptr;
+        static const ObjectMap empty_map{};
+        const ObjectMap* map = updated != nullptr ? updated.get() : (current != nullptr ? current : &empty_map);
+
+        if (auto it = map->find(std::string_view{t->name}); it != map->end() && it->second == obj_ptr) {
+            continue;
+        }
+
+        // Copy on first change
+        if (updated == nullptr) {
+            updated = current != nullptr ? std::make_unique<ObjectMap>(*current) : std::make_unique<ObjectMap>();
+        }
+
+        (*updated)[t->name] = obj_ptr;
+    }
+
+    m_last_refresh_time = GetTickCount64();
+    m_last_refresh_scene_epoch = m_scene_epoch.load(std::memory_order_relaxed);
+
+    if (updated != nullptr) {
+        m_object_map.store(updated.get(), std::memory_order_release);
+        m_object_maps.push_back(std::move(updated));
     }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -20,10 +22,15 @@ public:
 
     std::vector<REManagedObject*> get_objects();
 
+    // Same as above but reuses out's storage, returns out.
+    std::vector<REManagedObject*>& get_objects(std::vector<REManagedObject*>& out);
+
     REType* get_native(std::string_view name);
     std::vector<::REType*>& get_native_singleton_types();
 
     // Equivalent
+    // Lock-free when the singleton is known. Misses are remembered for a while (or until the scene changes)
+    // so polling for a singleton that doesn't exist doesn't rescan every global each time.
     REManagedObject* get(std::string_view name);
     REManagedObject* operator[](std::string_view name);
 
@@ -36,17 +43,52 @@ public:
     void safe_refresh();
     void safe_refresh_native();
 
+    // Bumps the scene epoch (which drops remembered misses) when the current scene changed.
+    // Calls into the VM, so only call it from the game thread once per frame, never from get().
+    void update_scene_epoch();
+
 private:
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    using ObjectMap = std::unordered_map<std::string, REManagedObject**, StringHash, std::equal_to<>>;
+
+    struct Miss {
+        uint64_t expires{};
+        uint32_t scene_epoch{};
+    };
+
+    static constexpr uint64_t REFRESH_INTERVAL_MS = 250;
+    static constexpr uint64_t MISS_LIFETIME_MS = 2000;
+
     void refresh_natives();
     void refresh_map();
+    REManagedObject* find_object(std::string_view name) const;
 
     // Class name to object like "app.foo.bar" -> 0xDEADBEEF
-    std::unordered_map<std::string, REManagedObject**> m_object_map;
+    // Published maps are immutable and only replaced when a refresh finds something new,
+    // which is rare enough that old ones are just kept alive instead of tracking readers.
+    std::atomic<const ObjectMap*> m_object_map{nullptr};
+    std::vector<std::unique_ptr<ObjectMap>> m_object_maps{};
+
+    // Guarded by m_map_mutex
+    std::unordered_map<std::string, Miss, StringHash, std::equal_to<>> m_misses{};
+    uint64_t m_last_refresh_time{};
+    uint32_t m_last_refresh_scene_epoch{};
+
+    // Written by update_scene_epoch only
+    REManagedObject* m_last_scene{nullptr};
+    std::atomic<uint32_t> m_scene_epoch{};
 
     // Raw list of objects (for if the type hasn't been fully initialized, we need to refresh the map)
     std::unordered_set<REManagedObject**> m_objects;
     std::vector<REManagedObject**> m_object_list;
-    std::unordered_map<std::string, std::function<REManagedObject* ()>> m_getters;
+    std::unordered_map<std::string, std::function<REManagedObject* ()>, StringHash, std::equal_to<>> m_getters;
 
     // List of objects we've already logged
     std::unordered_set<REManagedObject**> m_acknowledged_objects;
@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <shared_mutex>
+
+#include <windows.h>
 #include <spdlog/spdlog.h>
 
 #include "utility/Scan.hpp"
 #include "utility/Module.hpp"
 
 #include "ReClass.hpp"
+#include "RETypeDB.hpp"
 
 #include "REManagedObject.hpp"
 
@@ -227,33 +232,149 @@ void deserialize_native(::REManagedObject* object, const uint8_t* data, size_t s
     deserializer(object, &stream, &objects_array);
 }
 
+namespace detail {
+// Readable regions we've already seen, so validating pointers into the engine's heaps
+// is a binary search instead of a probe per pointer. Forgotten every REGION_CACHE_LIFETIME_MS
+// so regions that get freed or reprotected don't stay trusted for long.
+constexpr uint64_t REGION_CACHE_LIFETIME_MS = 1000;
+
+struct MemoryRegion {
+    uintptr_t start{};
+    uintptr_t end{};
+};
+
+std::shared_mutex g_region_mtx{};
+std::vector<MemoryRegion> g_regions{};
+uint64_t g_regions_time{};
+
+// Most lookups in a row land in the same heap region.
+thread_local MemoryRegion t_last_region{};
+thread_local uint64_t t_last_region_time{};
+
+bool is_readable_protection(DWORD protect) {
+    if ((protect & PAGE_GUARD) != 0 || (protect & PAGE_NOACCESS) != 0) {
+        return false;
+    }
+
+    constexpr DWORD readable = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    return (protect & readable) != 0;
+}
+
+bool is_readable_address(uintptr_t addr) {
+    const auto now = GetTickCount64();
+
+    if (addr >= t_last_region.start && addr < t_last_region.end && now - t_last_region_time < REGION_CACHE_LIFETIME_MS) {
+        return true;
+    }
+
+    {
+        std::shared_lock _{g_region_mtx};
+
+        if (now - g_regions_time < REGION_CACHE_LIFETIME_MS) {
+            auto it = std::upper_bound(g_regions.begin(), g_regions.end(), addr, [](uintptr_t a, const MemoryRegion& r) { return a < r.start; });
+
+            if (it != g_regions.begin() && addr < (--it)->end) {
+                t_last_region = *it;
+                t_last_region_time = g_regions_time;
+                return true;
+            }
+        }
+    }
+
+    // Not a region we know about, ask the kernel.
+    MEMORY_BASIC_INFORMATION mbi{};
+
+    if (VirtualQuery((LPCVOID)addr, &mbi, sizeof(mbi)) == 0 || mbi.State != MEM_COMMIT || !is_readable_protection(mbi.Protect)) {
+        return false;
+    }
+
+    const MemoryRegion region{(uintptr_t)mbi.BaseAddress, (uintptr_t)mbi.BaseAddress + mbi.RegionSize};
+
+    std::unique_lock _{g_region_mtx};
+
+    if (now - g_regions_time >= REGION_CACHE_LIFETIME_MS) {
+        g_regions.clear();
+        g_regions_time = now;
+    }
+
+    auto it = std::lower_bound(g_regions.begin(), g_regions.end(), region.start, [](const MemoryRegion& r, uintptr_t a) { return r.start < a; });
+
+    if (it == g_regions.end() || it->start != region.start) {
+        g_regions.insert(it, region);
+    }
+
+    t_last_region = region;
+    t_last_region_time = g_regions_time;
+
+    return true;
+}
+
+bool is_readable(const void* ptr, size_t size) {
+    const auto addr = (uintptr_t)ptr;
+
+    if (addr < 0x10000 || addr + size < addr) {
+        return false;
+    }
+
+    return is_readable_address(addr) && (size <= 1 || is_readable_address(addr + size - 1));
+}
+
+#if TDB_VER >= 71
+// Every valid classInfo points into the TDB's type array, so checking it is just arithmetic.
+bool is_type_definition(const void* ptr) {
+    static const auto [types_start, types_end] = []() -> std::pair<uintptr_t, uintptr_t> {
+        const auto tdb = sdk::RETypeDB::get();
+
+        if (tdb == nullptr || tdb->types == nullptr) {
+            return {0, 0};
+        }
+
+        const auto start = (uintptr_t)&(*tdb->types)[0];
+        return {start, start + (uintptr_t)tdb->get_num_types() * sizeof(sdk::RETypeDefinition)};
+    }();
+
+    const auto addr = (uintptr_t)ptr;
+
+    if (types_start == 0) {
+        return is_readable(ptr, sizeof(sdk::RETypeDefinition));
+    }
+
+    return addr >= types_start && addr < types_end && (addr - types_start) % sizeof(sdk::RETypeDefinition) == 0;
+}
+#endif
+}
+
 bool is_managed_object(Address address) {
-    if (address == nullptr) {
+    if (address == nullptr || (address.as<uintptr_t>() & (sizeof(void*) - 1)) != 0) {
         return false;
     }
 
-    if (IsBadReadPtr(address.ptr(), sizeof(void*))) {
+    if (!detail::is_readable(address.ptr(), sizeof(::REManagedObject))) {
         return false;
     }
 
     auto object = address.as<::REManagedObject*>();
 
-    if (object->info == nullptr || IsBadReadPtr(object->info, sizeof(void*))) {
+    if (object->info == nullptr || !detail::is_readable(object->info, sizeof(void*))) {
         return false;
     }
 
     auto class_info = object->info->classInfo;
 
-    if (class_info == nullptr || IsBadReadPtr(class_info, sizeof(void*))) {
+    if (class_info == nullptr) {
         return false;
     }
 
 #if TDB_VER >= 71
+    if (!detail::is_type_definition(class_info)) {
+        return false;
+    }
+
     const auto td = (sdk::RETypeDefinition*)class_info;
 
     if ((uintptr_t)td->managed_vt != (uintptr_t)object->info) {
         // This allows for cases when a vtable hook is being used to replace this pointer.
-        if (IsBadReadPtr(td->managed_vt, sizeof(void*)) || *(sdk::RETypeDefinition**)td->managed_vt != td) {
+        if (!detail::is_readable(td->managed_vt, sizeof(void*)) || *(sdk::RETypeDefinition**)td->managed_vt != td) {
             return false;
         }
     }
@@ -262,17 +383,21 @@ bool is_managed_object(Address address) {
         return false;
     }
 
-    if (IsBadReadPtr(td->type, sizeof(REType)) || td->type->name == nullptr) {
+    if (!detail::is_readable(td->type, sizeof(REType)) || td->type->name == nullptr) {
         return false;
     }
 
-    if (IsBadReadPtr(td->type->name, sizeof(void*))) {
+    if (!detail::is_readable(td->type->name, sizeof(void*))) {
         return false;
     }
 #elif TDB_VER > 49
+    if (!detail::is_readable(class_info, sizeof(void*))) {
+        return false;
+    }
+
     if (class_info->parentInfo != object->info) {
         // This allows for cases when a vtable hook is being used to replace this pointer.
-        if (IsBadReadPtr(class_info->parentInfo, sizeof(void*)) || class_info->parentInfo->classInfo != class_info) {
+        if (!detail::is_readable(class_info->parentInfo, sizeof(void*)) || class_info->parentInfo->classInfo != class_info) {
             return false;
         }
     }
@@ -281,33 +406,37 @@ bool is_managed_object(Address address) {
         return false;
     }
 
-    if (IsBadReadPtr(class_info->type, sizeof(REType)) || class_info->type->name == nullptr) {
+    if (!detail::is_readable(class_info->type, sizeof(REType)) || class_info->type->name == nullptr) {
         return false;
     }
 
-    if (IsBadReadPtr(class_info->type->name, sizeof(void*))) {
+    if (!detail::is_readable(class_info->type->name, sizeof(void*))) {
         return false;
     }
 #else
+    if (!detail::is_readable(class_info, sizeof(void*))) {
+        return false;
+    }
+
     auto info = object->info;
 
     if (info->type == nullptr) {
         return false;
     }
 
-    if (IsBadReadPtr(info->type, sizeof(REType)) || info->type->name == nullptr) {
+    if (!detail::is_readable(info->type, sizeof(REType)) || info->type->name == nullptr) {
         return false;
     }
 
-    if (IsBadReadPtr(info->type->name, sizeof(void*))) {
+    if (!detail::is_readable(info->type->name, sizeof(void*))) {
         return false;
     }
 
-    if (info->type->super != nullptr && IsBadReadPtr(info->type->super, sizeof(REType))) {
+    if (info->type->super != nullptr && !detail::is_readable(info->type->super, sizeof(REType))) {
         return false;
     }
 
-    if (info->type->classInfo != nullptr && IsBadReadPtr(info->type->classInfo, sizeof(REObjectInfo))) {
+    if (info->type->classInfo != nullptr && !detail::is_readable(info->type->classInfo, sizeof(REObjectInfo))) {
         return false;
     }
 
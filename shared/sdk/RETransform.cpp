@@ -1,27 +1,25 @@
+#include <algorithm>
+#include <shared_mutex>
+
 #include <sdk/REMath.hpp>
 #include <spdlog/spdlog.h>
 
 #include "Enums_Internal.hpp"
+#include "Method.hpp"
 #include "REString.hpp"
 #include "RETransform.hpp"
 
 namespace sdk {
 Vector4f sdk::get_transform_position(RETransform* transform) {
-    static auto get_position_method = sdk::find_type_definition("via.Transform")->get_method("get_Position");
-
-    Vector4f out{};
-    get_position_method->call<Vector4f*>(&out, sdk::get_thread_context(), transform);
+    static const sdk::Method<Vector4f(RETransform*)> get_position_method{"via.Transform", "get_Position"};
 
-    return out;
+    return get_position_method(transform);
 }
 
 glm::quat sdk::get_transform_rotation(RETransform* transform) {
-    static auto get_rotation_method = sdk::find_type_definition("via.Transform")->get_method("get_Rotation");
+    static const sdk::Method<glm::quat(RETransform*)> get_rotation_method{"via.Transform", "get_Rotation"};
 
-    glm::quat out{};
-    get_rotation_method->call<glm::quat*>(&out, sdk::get_thread_context(), transform);
-
-    return out;
+    return get_rotation_method(transform);
 }
 
 REJoint* get_transform_joint_by_hash(RETransform* transform, uint32_t hash) {
@@ -33,7 +31,7 @@ REJoint* get_transform_joint_by_hash(RETransform* transform, uint32_t hash) {
 REJoint* get_transform_joint_by_name(RETransform* transform, std::wstring_view name) {
     static auto get_joint_by_name_method = sdk::find_type_definition("via.Transform")->get_method("getJointByName");
 
-    return get_joint_by_name_method->call<REJoint*>(sdk::get_thread_context(), transform, sdk::VM::create_managed_string(name));
+    return get_joint_by_name_method->call<REJoint*>(sdk::get_thread_context(), transform, sdk::VM::create_managed_string_interned(name));
 }
 
 sdk::SystemArray* get_transform_joints(RETransform* transform) {
@@ -44,9 +42,9 @@ sdk::SystemArray* get_transform_joints(RETransform* transform) {
 
 void set_transform_position(RETransform* transform, const Vector4f& pos, bool no_dirty) {
     if (!no_dirty) {
-        static auto set_position_method = sdk::find_type_definition("via.Transform")->get_method("set_Position");
+        static const sdk::Method<void(RETransform*, const Vector4f*)> set_position_method{"via.Transform", "set_Position"};
 
-        set_position_method->call<void*>(sdk::get_thread_context(), transform, &pos);
+        set_position_method(transform, &pos);
     } else {
         static auto get_parent_method = sdk::find_type_definition("via.Transform")->get_method("get_Parent");
         const auto parent_transform = get_parent_method->call<RETransform*>(sdk::get_thread_context(), transform);
@@ -67,9 +65,9 @@ void set_transform_position(RETransform* transform, const Vector4f& pos, bool no
 }
 
 void set_transform_rotation(RETransform* transform, const glm::quat& rot) {
-    static auto set_rotation_method = sdk::find_type_definition("via.Transform")->get_method("set_Rotation");
+    static const sdk::Method<void(RETransform*, const glm::quat*)> set_rotation_method{"via.Transform", "set_Rotation"};
 
-    set_rotation_method->call<void*>(sdk::get_thread_context(), transform, &rot);
+    set_rotation_method(transform, &rot);
 }
 
 REJoint* sdk::get_joint_parent(REJoint* joint) {
@@ -104,63 +102,51 @@ uint32_t get_joint_hash(REJoint* joint) {
 }
 
 void sdk::set_joint_position(REJoint* joint, const Vector4f& position) {
-    static auto set_position_method = sdk::find_type_definition("via.Joint")->get_method("set_Position");
+    static const sdk::Method<void(REJoint*, const Vector4f*)> set_position_method{"via.Joint", "set_Position"};
 
-    set_position_method->call<void*>(sdk::get_thread_context(), joint, &position);
+    set_position_method(joint, &position);
 };
 
 void sdk::set_joint_rotation(REJoint* joint, const glm::quat& rotation) {
-    static auto set_rotation_method = sdk::find_type_definition("via.Joint")->get_method("set_Rotation");
+    static const sdk::Method<void(REJoint*, const glm::quat*)> set_rotation_method{"via.Joint", "set_Rotation"};
 
-    set_rotation_method->call<void*>(sdk::get_thread_context(), joint, &rotation);
+    set_rotation_method(joint, &rotation);
 };
 
 glm::quat sdk::get_joint_rotation(REJoint* joint) {
-    static auto get_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_Rotation");
-
-    glm::quat rotation{};
-    get_rotation_method->call<glm::quat*>(&rotation, sdk::get_thread_context(), joint);
+    static const sdk::Method<glm::quat(REJoint*)> get_rotation_method{"via.Joint", "get_Rotation"};
 
-    return rotation;
+    return get_rotation_method(joint);
 };
 
 Vector4f sdk::get_joint_position(REJoint* joint) {
-    static auto get_position_method = sdk::find_type_definition("via.Joint")->get_method("get_Position");
+    static const sdk::Method<Vector4f(REJoint*)> get_position_method{"via.Joint", "get_Position"};
 
-    Vector4f position{};
-    get_position_method->call<Vector4f*>(&position, sdk::get_thread_context(), joint);
-
-    return position;
+    return get_position_method(joint);
 };
 
 glm::quat sdk::get_joint_local_rotation(REJoint* joint) {
-    static auto get_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_LocalRotation");
-
-    glm::quat rotation{};
-    get_local_rotation_method->call<glm::quat*>(&rotation, sdk::get_thread_context(), joint);
+    static const sdk::Method<glm::quat(REJoint*)> get_local_rotation_method{"via.Joint", "get_LocalRotation"};
 
-    return rotation;
+    return get_local_rotation_method(joint);
 };
 
 Vector4f sdk::get_joint_local_position(REJoint* joint) {
-    static auto get_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_LocalPosition");
-
-    Vector4f position{};
-    get_local_position_method->call<Vector4f*>(&position, sdk::get_thread_context(), joint);
+    static const sdk::Method<Vector4f(REJoint*)> get_local_position_method{"via.Joint", "get_LocalPosition"};
 
-    return position;
+    return get_local_position_method(joint);
 };
 
 void sdk::set_joint_local_rotation(REJoint* joint, const glm::quat& rotation) {
-    static auto set_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("set_LocalRotation");
+    static const sdk::Method<void(REJoint*, const glm::quat*)> set_local_rotation_method{"via.Joint", "set_LocalRotation"};
 
-    set_local_rotation_method->call<void*>(sdk::get_thread_context(), joint, &rotation);
+    set_local_rotation_method(joint, &rotation);
 };
 
 void sdk::set_joint_local_position(REJoint* joint, const Vector4f& position) {
-    static auto set_local_position_method = sdk::find_type_definition("via.Joint")->get_method("set_LocalPosition");
+    static const sdk::Method<void(REJoint*, const Vector4f*)> set_local_position_method{"via.Joint", "set_LocalPosition"};
 
-    set_local_position_method->call<void*>(sdk::get_thread_context(), joint, &position);
+    set_local_position_method(joint, &position);
 };
 
 std::string sdk::get_joint_name(REJoint* joint) {
@@ -210,43 +196,26 @@ REJoint* get_joint(const ::RETransform& transform, uint32_t index) {
 }
 
 glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target) {
-    static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
-    static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
-
     if (target == nullptr) {
         return glm::identity<glm::mat4>();
     }
 
-    auto parent = target->info->parentJoint;
+    const auto skeleton = sdk::get_skeleton(transform);
 
-    if (parent == -1) {
+    if (skeleton == nullptr) {
         return glm::identity<glm::mat4>();
     }
 
-    auto parent_joint = get_joint(transform, parent);
+    const auto index = skeleton->find(target);
 
-    if (parent_joint == nullptr) {
+    if (index < 0) {
         return glm::identity<glm::mat4>();
     }
 
-    auto parent_transform = calculate_base_transform(transform, parent_joint);
-
-    glm::quat base_rotation{};
-    get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), target);
-
-    Vector4f base_position{};
-    get_base_local_position_method->call<Vector4f*>(&base_position, sdk::get_thread_context(), target);
-
-    // Convert to matrix
-    auto base_transform = glm::translate(glm::mat4(1.0f), glm::vec3(base_position.x, base_position.y, base_position.z)) * glm::mat4_cast(base_rotation);
-
-    return parent_transform * base_transform;
+    return skeleton->bind_pose[index];
 }
 
 void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out) {
-    static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
-    static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
-
     if (auto it = out.find(target); it != out.end()) {
         return;
     }
@@ -256,41 +225,18 @@ void calculate_base_transforms(const ::RETransform& transform, REJoint* target,
         return;
     }
 
-    auto parent = target->info->parentJoint;
+    const auto skeleton = sdk::get_skeleton(transform);
+    const auto index = skeleton != nullptr ? skeleton->find(target) : -1;
 
-    if (parent == -1) {
+    if (index < 0) {
         out[target] = glm::identity<glm::mat4>();
         return;
     }
 
-    auto parent_joint = get_joint(transform, parent);
-
-    if (parent_joint == nullptr) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
+    // Callers rely on the parents ending up in the map too.
+    for (auto i = index; i >= 0 && !out.contains(skeleton->joints[i]); i = skeleton->parents[i]) {
+        out[skeleton->joints[i]] = skeleton->bind_pose[i];
     }
-
-    calculate_base_transforms(transform, parent_joint, out);
-
-    auto it = out.find(parent_joint);
-
-    if (it == out.end()) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
-    }
-
-    const auto& parent_transform = it->second;
-
-    glm::quat base_rotation{};
-    get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), target);
-
-    Vector4f base_position{};
-    get_base_local_position_method->call<Vector4f*>(&base_position, sdk::get_thread_context(), target);
-
-    // Convert to matrix
-    const auto base_transform = glm::translate(glm::mat4(1.0f), glm::vec3(base_position.x, base_position.y, base_position.z)) * glm::mat4_cast(base_rotation);
-
-    out[target] = parent_transform * base_transform;
 }
 
 Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* joint, uint32_t depth) {
@@ -409,4 +355,289 @@ void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& j
         }
     }
 }
-}
\ No newline at end of file
+}
+namespace sdk {
+namespace detail {
+constexpr size_t MAX_CACHED_SKELETONS = 512;
+
+std::shared_mutex g_skeleton_mtx{};
+std::unordered_map<const ::RETransform*, std::shared_ptr<const Skeleton>> g_skeletons{};
+
+// nullptr if the transform has no joints.
+const void* get_joint_array(const ::RETransform& transform, int32_t& count) {
+    count = 0;
+
+#if TDB_VER < 69
+    const auto& joint_array = transform.joints;
+
+    if (joint_array.size <= 0 || joint_array.numAllocated <= 0 || joint_array.data == nullptr || joint_array.matrices == nullptr) {
+        return nullptr;
+    }
+
+    count = joint_array.size;
+    return joint_array.data;
+#else
+    if (transform.joints.data == nullptr || transform.joints.data->numElements <= 0) {
+        return nullptr;
+    }
+
+    count = transform.joints.data->numElements;
+    return transform.joints.data;
+#endif
+}
+
+REJoint* get_joint_from_array(const ::RETransform& transform, int32_t index) {
+#if TDB_VER < 69
+    return transform.joints.data->joints[index];
+#else
+    return utility::re_array::get_element<REJoint>(transform.joints.data, index);
+#endif
+}
+
+bool has_joint_matrices(const ::RETransform& transform) {
+#if TDB_VER >= 70 && (defined(RE2) || defined(RE3) || defined(RE7))
+    return transform.jointMatrices != nullptr;
+#else
+    return transform.joints.matrices != nullptr;
+#endif
+}
+
+glm::quat to_quat(const Vector4f& v) {
+    return glm::quat{v.w, v.x, v.y, v.z};
+}
+
+std::shared_ptr<Skeleton> build_skeleton(const ::RETransform& transform, const void* joint_array, int32_t count) {
+    static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
+    static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
+
+    auto out = std::make_shared<Skeleton>();
+    out->joint_array = joint_array;
+    out->joints.resize(count);
+    out->parents.resize(count, -1);
+    out->bind_pose.resize(count, glm::identity<glm::mat4>());
+
+    for (int32_t i = 0; i < count; ++i) {
+        out->joints[i] = get_joint_from_array(transform, i);
+    }
+
+    for (int32_t i = 0; i < count; ++i) {
+        const auto joint = out->joints[i];
+
+        if (joint == nullptr || joint->info == nullptr) {
+            continue;
+        }
+
+        const auto parent = (int32_t)joint->info->parentJoint;
+
+        if (parent >= 0 && parent < count && parent != i && out->joints[parent] != nullptr) {
+            out->parents[i] = parent;
+        }
+    }
+
+    // Parents aren't guaranteed to come before their children, so resolve each chain top down.
+    std::vector<bool> done(count, false);
+    std::vector<int32_t> chain{};
+
+    for (int32_t i = 0; i < count; ++i) {
+        chain.clear();
+
+        for (auto j = i; j >= 0 && !done[j] && chain.size() <= (size_t)count; j = out->parents[j]) {
+            chain.push_back(j);
+        }
+
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            const auto j = *it;
+            const auto parent = out->parents[j];
+
+            done[j] = true;
+
+            // Roots stay identity, same as the old recursive calculate_base_transform.
+            if (parent < 0) {
+                continue;
+            }
+
+            const auto joint = out->joints[j];
+
+            glm::quat base_rotation{};
+            get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), joint);
+
+            Vector4f base_position{};
+            get_base_local_position_method->call<Vector4f*>(&base_position, sdk::get_thread_context(), joint);
+
+            const auto base_transform = glm::translate(glm::mat4(1.0f), glm::vec3(base_position.x, base_position.y, base_position.z)) * glm::mat4_cast(base_rotation);
+
+            out->bind_pose[j] = out->bind_pose[parent] * base_transform;
+        }
+    }
+
+    return out;
+}
+
+bool is_current(const Skeleton& skeleton, const ::RETransform& transform, const void* joint_array, int32_t count) {
+    return skeleton.joint_array == joint_array 
+        && skeleton.size() == (size_t)count 
+        && skeleton.joints[0] == get_joint_from_array(transform, 0);
+}
+}
+
+int32_t Skeleton::find(std::wstring_view name) const {
+    for (size_t i = 0; i < joints.size(); ++i) {
+        const auto joint = joints[i];
+
+        if (joint == nullptr || joint->info == nullptr || joint->info->name == nullptr) {
+            continue;
+        }
+
+        if (name == joint->info->name) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+int32_t Skeleton::find(REJoint* joint) const {
+    if (joint == nullptr) {
+        return -1;
+    }
+
+    const auto index = ((sdk::Joint*)joint)->get_joint_index();
+
+    if (index >= 0 && (size_t)index < joints.size() && joints[index] == joint) {
+        return index;
+    }
+
+    const auto it = std::find(joints.begin(), joints.end(), joint);
+
+    return it != joints.end() ? (int32_t)std::distance(joints.begin(), it) : -1;
+}
+
+std::shared_ptr<const Skeleton> get_skeleton(const ::RETransform& transform) {
+    int32_t count{};
+    const auto joint_array = detail::get_joint_array(transform, count);
+
+    if (joint_array == nullptr) {
+        return nullptr;
+    }
+
+    {
+        std::shared_lock _{detail::g_skeleton_mtx};
+
+        if (auto it = detail::g_skeletons.find(&transform); it != detail::g_skeletons.end() && detail::is_current(*it->second, transform, joint_array, count)) {
+            return it->second;
+        }
+    }
+
+    // Built outside of the lock, a racing thread building the same skeleton just wastes some work.
+    std::shared_ptr<const Skeleton> skeleton = detail::build_skeleton(transform, joint_array, count);
+
+    std::unique_lock _{detail::g_skeleton_mtx};
+
+    // Entries for dead transforms are never looked at again, so just start over.
+    if (detail::g_skeletons.size() >= detail::MAX_CACHED_SKELETONS) {
+        detail::g_skeletons.clear();
+    }
+
+    detail::g_skeletons[&transform] = skeleton;
+
+    return skeleton;
+}
+
+bool read_skeleton_pose(const ::RETransform& transform, SkeletonPose& out, uint32_t flags) {
+    auto skeleton = get_skeleton(transform);
+
+    if (skeleton == nullptr) {
+        return false;
+    }
+
+    const auto count = skeleton->size();
+
+    if ((flags & SkeletonPoseFlags::WORLD) != 0 && !detail::has_joint_matrices(transform)) {
+        return false;
+    }
+
+    if ((flags & SkeletonPoseFlags::LOCAL) != 0) {
+        out.local_positions.resize(count);
+        out.local_rotations.resize(count);
+        out.local_scales.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto joint = (sdk::Joint*)skeleton->joints[i];
+
+            if (joint == nullptr) {
+                out.local_positions[i] = Vector4f{0.0f, 0.0f, 0.0f, 1.0f};
+                out.local_rotations[i] = glm::identity<glm::quat>();
+                out.local_scales[i] = Vector4f{1.0f, 1.0f, 1.0f, 1.0f};
+                continue;
+            }
+
+            out.local_positions[i] = joint->LocalPosition;
+            out.local_rotations[i] = detail::to_quat(joint->LocalRotation);
+            out.local_scales[i] = joint->LocalScale;
+        }
+    }
+
+    if ((flags & SkeletonPoseFlags::WORLD) != 0) {
+        out.world_matrices.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            out.world_matrices[i] = utility::re_transform::get_joint_matrix_by_index(transform, (uint32_t)i);
+        }
+    }
+
+    out.skeleton = std::move(skeleton);
+    return true;
+}
+
+bool write_skeleton_pose(::RETransform& transform, const SkeletonPose& pose, uint32_t flags) {
+    static auto set_local_position_method = sdk::find_type_definition("via.Joint")->get_method("set_LocalPosition");
+    static auto set_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("set_LocalRotation");
+    static auto set_local_scale_method = sdk::find_type_definition("via.Joint")->get_method("set_LocalScale");
+
+    if (pose.skeleton == nullptr || get_skeleton(transform) != pose.skeleton) {
+        return false;
+    }
+
+    const auto count = pose.size();
+
+    if ((flags & SkeletonPoseFlags::LOCAL) != 0) {
+        if (pose.local_positions.size() != count || pose.local_rotations.size() != count || pose.local_scales.size() != count) {
+            return false;
+        }
+
+        const auto context = sdk::get_thread_context();
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto joint = (sdk::Joint*)pose.skeleton->joints[i];
+
+            if (joint == nullptr) {
+                continue;
+            }
+
+            if (joint->LocalPosition != pose.local_positions[i]) {
+                set_local_position_method->call<void*>(context, joint, &pose.local_positions[i]);
+            }
+
+            if (detail::to_quat(joint->LocalRotation) != pose.local_rotations[i]) {
+                set_local_rotation_method->call<void*>(context, joint, &pose.local_rotations[i]);
+            }
+
+            if (set_local_scale_method != nullptr && joint->LocalScale != pose.local_scales[i]) {
+                set_local_scale_method->call<void*>(context, joint, &pose.local_scales[i]);
+            }
+        }
+    }
+
+    if ((flags & SkeletonPoseFlags::WORLD) != 0) {
+        if (pose.world_matrices.size() != count || !detail::has_joint_matrices(transform)) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            utility::re_transform::get_joint_matrix_by_index(transform, (uint32_t)i) = pose.world_matrices[i];
+        }
+    }
+
+    return true;
+}
+}
@@ -2,6 +2,10 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Math.hpp"
 #include "TDBVer.hpp"
@@ -274,4 +278,56 @@ Vector4f get_joint_local_position(REJoint* joint);
 void set_joint_local_rotation(REJoint* joint, const glm::quat& rotation);
 void set_joint_local_position(REJoint* joint, const Vector4f& position);
 std::string get_joint_name(REJoint* joint);
-}
\ No newline at end of file
+}
+namespace sdk {
+// Joint layout of a transform, resolved once from its joint array and cached per transform.
+// Indices match the joint array, the joint matrix array and REJointDesc::parentJoint.
+struct Skeleton {
+    std::vector<REJoint*> joints{};
+    std::vector<int32_t> parents{};      // -1 for roots
+    std::vector<Matrix4x4f> bind_pose{}; // Model space T-pose, same convention as calculate_base_transform (roots are identity)
+
+    size_t size() const {
+        return joints.size();
+    }
+
+    // -1 if not found
+    int32_t find(std::wstring_view name) const;
+    int32_t find(REJoint* joint) const;
+
+    // Used to detect the transform's joints being rebuilt, or the transform being freed and reused
+    const void* joint_array{};
+};
+
+enum SkeletonPoseFlags : uint32_t {
+    LOCAL = 1 << 0, // Local position, rotation and scale
+    WORLD = 1 << 1, // Joint world matrices
+    ALL = LOCAL | WORLD,
+};
+
+// Every joint's pose in one array per property, indexed like Skeleton.
+struct SkeletonPose {
+    std::shared_ptr<const Skeleton> skeleton{};
+    std::vector<Vector4f> local_positions{};
+    std::vector<glm::quat> local_rotations{};
+    std::vector<Vector4f> local_scales{};
+    std::vector<Matrix4x4f> world_matrices{};
+
+    size_t size() const {
+        return skeleton != nullptr ? skeleton->size() : 0;
+    }
+};
+
+// nullptr if the transform has no joints. The bind pose is built on the first call,
+// which needs a thread context, every call after that only checks the cached skeleton is still current.
+std::shared_ptr<const Skeleton> get_skeleton(const ::RETransform& transform);
+
+// Copies every joint's pose straight out of the joint objects and the joint matrix array, no VM calls.
+// Buffers in out are reused between calls.
+bool read_skeleton_pose(const ::RETransform& transform, SkeletonPose& out, uint32_t flags = SkeletonPoseFlags::ALL);
+
+// LOCAL goes through the via.Joint setters so the engine updates the hierarchy, but only for joints whose values changed.
+// WORLD is stored directly into the joint matrix array, so it only sticks if done after the engine's own update.
+// Fails if pose was read from a different skeleton.
+bool write_skeleton_pose(::RETransform& transform, const SkeletonPose& pose, uint32_t flags = SkeletonPoseFlags::LOCAL);
+}
@@ -4,6 +4,7 @@
 
 #include "reframework/API.hpp"
 #include "RETypeDB.hpp"
+#include "TDBWarmup.hpp"
 
 namespace sdk {
 RETypeDB* RETypeDB::get() {
@@ -69,6 +70,73 @@ sdk::RETypeDefinition* RETypeDB::find_type(std::string_view name) const {
     return g_tdb_type_map[name.data()];
 }
 
+size_t RETypeDB::find_types(std::span<const std::string_view> names, std::span<sdk::RETypeDefinition*> out) const {
+    const auto count = std::min(names.size(), out.size());
+    std::unordered_map<std::string_view, std::vector<size_t>> misses{};
+    size_t found{};
+
+    {
+        std::shared_lock _{ g_tdb_type_mtx };
+
+        for (size_t i = 0; i < count; ++i) {
+            if (auto it = g_tdb_type_map.find(std::string{names[i]}); it != g_tdb_type_map.end()) {
+                out[i] = it->second;
+                found += it->second != nullptr ? 1 : 0;
+            } else {
+                out[i] = nullptr;
+                misses[names[i]].push_back(i);
+            }
+        }
+    }
+
+    if (misses.empty()) {
+        return found;
+    }
+
+    size_t num_resolved{};
+
+    for (uint32_t i = 0; i < this->numTypes && num_resolved < misses.size(); ++i) {
+        auto t = get_type(i);
+        const auto full_name = t->get_full_name();
+
+        if (auto it = misses.find(full_name); it != misses.end()) {
+            // First match wins, same as find_type.
+            if (out[it->second.front()] != nullptr) {
+                continue;
+            }
+
+            for (const auto index : it->second) {
+                out[index] = t;
+                ++found;
+            }
+
+            ++num_resolved;
+        }
+    }
+
+    std::unique_lock _{ g_tdb_type_mtx };
+
+    for (const auto& [name, indices] : misses) {
+        const auto t = out[indices.front()];
+
+        if (!g_tdb_type_map.contains(std::string{name})) {
+            g_tdb_type_map[std::string{name}] = t;
+        }
+    }
+
+    return found;
+}
+
+void detail::publish_type_names(std::span<std::vector<std::pair<std::string, sdk::RETypeDefinition*>>> chunks) {
+    std::unique_lock _{ g_tdb_type_mtx };
+
+    for (auto& chunk : chunks) {
+        for (auto& [name, t] : chunk) {
+            g_tdb_type_map.try_emplace(std::move(name), t);
+        }
+    }
+}
+
 sdk::RETypeDefinition* RETypeDB::find_type_by_fqn(uint32_t fqn) const {
     for (uint32_t i = 0; i< this->numTypes; ++i) {
         auto t = get_type(i);
@@ -570,21 +638,31 @@ reframework::InvokeRet sdk::REMethodDefinition::invoke(void* object, const std::
     return out;
 }
 
-void sdk::REMethodDefinition::invoke(void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const {
-    const auto num_params = get_num_params();
+#if TDB_VER > 49
+sdk::REMethodDefinition::InvokePlan sdk::REMethodDefinition::get_invoke_plan() const {
+    InvokePlan plan{};
+    plan.wrapper = (void*)sdk::get_invoke_table()[get_invoke_id()];
+    plan.num_params = get_num_params();
 
-    if (num_params != args.size()) {
-        //throw std::runtime_error("Invalid number of arguments");
+    // vec3 and stuff that is > sizeof(void*) requires special handling
+    // by preallocating the output buffer
+    const auto ret_ty = get_return_type();
+
+    if (ret_ty != nullptr && ret_ty->is_value_type()) {
+        plan.out_is_ptr = !(ret_ty->get_valuetype_size() > sizeof(void*) || (!ret_ty->is_primitive() && !ret_ty->is_enum()));
+    }
+
+    return plan;
+}
+
+void sdk::REMethodDefinition::invoke(const InvokePlan& plan, void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const {
+    if (plan.num_params != args.size()) {
         const auto declaring_type = get_declaring_type();
         const auto decltype_name = declaring_type != nullptr ? declaring_type->get_full_name() : "unknownclass";
         spdlog::warn("Invalid number of arguments passed to REMethodDefinition::invoke for {}.{}", decltype_name, get_name());
         return;
     }
 
-#if TDB_VER > 49
-    const auto invoke_tbl = sdk::get_invoke_table();
-    auto invoke_wrapper = invoke_tbl[get_invoke_id()];
-
     struct StackFrame {
         char pad_0000[8+8]; //0x0000
         const sdk::REMethodDefinition* method;
@@ -599,23 +677,8 @@ void sdk::REMethodDefinition::invoke(void* object, const std::span<void*>& args,
     stack_frame.object_ptr = object;
     stack_frame.in_data = (void*)args.data();
     
-    auto ret_ty = get_return_type();
-    bool is_ptr = false;
- 
-    // vec3 and stuff that is > sizeof(void*) requires special handling
-    // by preallocating the output buffer
-    if (ret_ty != nullptr && ret_ty->is_value_type()) {
-        if (ret_ty->get_valuetype_size() > sizeof(void*) || (!ret_ty->is_primitive() && !ret_ty->is_enum())) {
-            stack_frame.out_data = &out;
-            is_ptr = false;
-        } else {
-            stack_frame.out_data = nullptr;
-            is_ptr = true;
-        }
-    } else {
-        stack_frame.out_data = nullptr;
-        is_ptr = true;
-    }
+    const auto is_ptr = plan.out_is_ptr;
+    stack_frame.out_data = is_ptr ? nullptr : &out;
     
     {
         auto context = sdk::get_thread_context();
@@ -624,7 +687,7 @@ void sdk::REMethodDefinition::invoke(void* object, const std::span<void*>& args,
         bool corrupted_before_call = context->unkPtr != nullptr && context->unkPtr->unkPtr != nullptr;
 
         try {
-            invoke_wrapper((void*)&stack_frame, context);
+            ((sdk::InvokeMethod)plan.wrapper)((void*)&stack_frame, context);
             out.exception_thrown = false;
 
             // exception pointer
@@ -673,9 +736,35 @@ void sdk::REMethodDefinition::invoke(void* object, const std::span<void*>& args,
 
     if (stack_frame.out_data != &out) {
         out.ptr = stack_frame.out_data;
+    }
+}
+#else
+sdk::REMethodDefinition::InvokePlan sdk::REMethodDefinition::get_invoke_plan() const {
+    // No invoke wrappers here, invoke() does all of its own setup.
+    InvokePlan plan{};
+    plan.num_params = get_num_params();
+
+    return plan;
+}
+
+void sdk::REMethodDefinition::invoke(const InvokePlan& plan, void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const {
+    invoke(object, args, out);
+}
+#endif
+
+void sdk::REMethodDefinition::invoke(void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const {
+    const auto num_params = get_num_params();
+
+    if (num_params != args.size()) {
+        //throw std::runtime_error("Invalid number of arguments");
+        const auto declaring_type = get_declaring_type();
+        const auto decltype_name = declaring_type != nullptr ? declaring_type->get_full_name() : "unknownclass";
+        spdlog::warn("Invalid number of arguments passed to REMethodDefinition::invoke for {}.{}", decltype_name, get_name());
         return;
     }
 
+#if TDB_VER > 49
+    invoke(get_invoke_plan(), object, args, out);
     return;
 #else
     // RE7 doesn't have the invoke wrappers that the newer games use...
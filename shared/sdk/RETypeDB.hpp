@@ -897,6 +897,11 @@ struct RETypeDB : public sdk::RETypeDB_ {
 
     sdk::RETypeDefinition* find_type(std::string_view name) const;
     sdk::RETypeDefinition* find_type_by_fqn(uint32_t fqn) const;
+
+    // find_type for several names at once, out[i] is nullptr if names[i] wasn't found.
+    // Names that aren't cached yet are resolved together in a single pass over the types.
+    // Returns how many were found.
+    size_t find_types(std::span<const std::string_view> names, std::span<sdk::RETypeDefinition*> out) const;
     sdk::RETypeDefinition* get_type(uint32_t index) const;
     sdk::REMethodDefinition* get_method(uint32_t index) const;
     sdk::REField* get_field(uint32_t index) const;
@@ -1145,6 +1150,17 @@ struct REMethodDefinition : public sdk::REMethodDefinition_ {
     void invoke(void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const;
     ::reframework::InvokeRet invoke(void* object, const std::span<void*>& args) const;
 
+    // Everything invoke() looks up in the TDB before each call, resolved once
+    // for callers that invoke the same method over and over.
+    struct InvokePlan {
+        void* wrapper{nullptr}; // Entry in the invoke table
+        uint32_t num_params{};
+        bool out_is_ptr{true};  // Return value is passed back through out.ptr instead of being written to out.bytes
+    };
+
+    InvokePlan get_invoke_plan() const;
+    void invoke(const InvokePlan& plan, void* object, const std::span<void*>& args, ::reframework::InvokeRet& out) const;
+
     template<size_t N>
     ::reframework::InvokeRet invoke(void* object, std::array<void*, N>& args) const {
         return invoke(object, std::span<void*>(args));
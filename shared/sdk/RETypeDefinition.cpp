@@ -9,6 +9,7 @@
 
 #include "RETypeDB.hpp"
 #include "RETypeDefinition.hpp"
+#include "TDBWarmup.hpp"
 
 namespace sdk {
 struct RETypeDefinition;
@@ -141,30 +142,15 @@ const char* RETypeDefinition::get_name() const {
 static std::unordered_map<uint32_t, std::string> g_full_names{};
 static std::shared_mutex g_full_name_mtx{};
 
-std::string RETypeDefinition::get_full_name() const {
-    auto tdb = RETypeDB::get();
-
-#if TDB_VER <= 49
-    return tdb->get_string(this->full_name_offset); // uhh thanks?
-#else
-    {
-        std::shared_lock _{ g_full_name_mtx };
-
-        if (auto it = g_full_names.find(this->get_index()); it != g_full_names.end()) {
-            return it->second;
-        }
-    }
-
+// Namespace and declaring types joined with dots, without generic arguments.
+static std::string build_declared_name(const sdk::RETypeDefinition* t) {
     std::deque<std::string> names{};
     std::string full_name{};
 
-    // because using normal find_type will loop back to this function and cause a deadlock
-    static auto system_runtime_type = sdk::RETypeDB::get()->find_type_by_fqn(0x99ff88e6);
-
-    if (this->declaring_typeid > 0 && this->declaring_typeid != this->get_index()) {
+    if (t->declaring_typeid > 0 && t->declaring_typeid != t->get_index()) {
         std::unordered_set<const sdk::RETypeDefinition*> seen_classes{};
 
-        for (auto owner = this; owner != nullptr; owner = owner->get_declaring_type()) {
+        for (auto owner = t; owner != nullptr; owner = owner->get_declaring_type()) {
             if (seen_classes.count(owner) > 0) {
                 break;
             }
@@ -176,7 +162,7 @@ std::string RETypeDefinition::get_full_name() const {
             }
 
             // uh.
-            if (owner->get_declaring_type() == this) {
+            if (owner->get_declaring_type() == t) {
                 break;
             }
 
@@ -184,12 +170,12 @@ std::string RETypeDefinition::get_full_name() const {
         }
     } else {
         // namespace
-        if (!std::string{this->get_namespace()}.empty()) {
-            names.push_front(this->get_namespace());
+        if (!std::string{t->get_namespace()}.empty()) {
+            names.push_front(t->get_namespace());
         }
 
         // actual class name
-        names.push_back(this->get_name());
+        names.push_back(t->get_name());
     }
 
     for (auto f = 0; f < names.size(); ++f) {
@@ -200,12 +186,44 @@ std::string RETypeDefinition::get_full_name() const {
         full_name += names[f];
     }
 
-    // Set this here at this point in-case get_full_name runs into it
+    return full_name;
+}
+
+std::string RETypeDefinition::get_full_name() const {
+    auto tdb = RETypeDB::get();
+
+#if TDB_VER <= 49
+    return tdb->get_string(this->full_name_offset); // uhh thanks?
+#else
+    // Names this thread is still resolving, without their generic arguments yet.
+    // Kept out of g_full_names so other threads never see (or bake into their own names) a partial name.
+    thread_local std::unordered_map<uint32_t, std::string> in_progress_names{};
+
+    if (auto it = in_progress_names.find(this->get_index()); it != in_progress_names.end()) {
+        return it->second;
+    }
+
     {
-        std::unique_lock _{g_full_name_mtx};
-        g_full_names[this->get_index()] = full_name;
+        std::shared_lock _{ g_full_name_mtx };
+
+        if (auto it = g_full_names.find(this->get_index()); it != g_full_names.end()) {
+            return it->second;
+        }
     }
 
+    // because using normal find_type will loop back to this function and cause a deadlock
+    static auto system_runtime_type = sdk::RETypeDB::get()->find_type_by_fqn(0x99ff88e6);
+
+    auto full_name = build_declared_name(this);
+
+    // Set this here at this point in-case get_full_name runs into it
+    in_progress_names[this->get_index()] = full_name;
+
+    struct InProgressGuard {
+        uint32_t index;
+        ~InProgressGuard() { in_progress_names.erase(index); }
+    } in_progress_guard{this->get_index()};
+
     auto generate_full_name_via_reflection = [&]() {
         struct FakeRuntimeType : public ::REManagedObject {
             const sdk::RETypeDefinition* t{nullptr};
@@ -453,43 +471,43 @@ sdk::REField* RETypeDefinition::get_field(std::string_view name) const {
 static std::shared_mutex g_method_mtx{};
 static std::unordered_map<const sdk::RETypeDefinition*, std::unordered_map<size_t, sdk::REMethodDefinition*>> g_method_map{};
 
-sdk::REMethodDefinition* RETypeDefinition::get_method(std::string_view name) const {
-    const auto name_hash = std::hash<std::string_view>{}(name);
-
-    {
-        std::shared_lock _{g_method_mtx};
+// This is probably a hacky way of doing it but whatever.
+// I haven't checked if IsGenericMethodDefinition is implemented.
+static bool is_generic_method_definition(const sdk::REMethodDefinition& m) {
+    const auto return_type = m.get_return_type();
 
-        if (auto it = g_method_map.find(this); it != g_method_map.end()) {
-            if (auto it2 = it->second.find(name_hash); it2 != it->second.end()) {
-                return it2->second;
-            }
+    if (return_type != nullptr && return_type->get_name() != nullptr) {
+        if (std::string_view{return_type->get_name()}.contains("!")) {
+            return true;
         }
     }
 
-    // This is probably a hacky way of doing it but whatever.
-    // I haven't checked if IsGenericMethodDefinition is implemented.
-    auto is_generic_method_definition = [](sdk::REMethodDefinition& m) {
-        const auto return_type = m.get_return_type();
+    const auto method_param_types = m.get_param_types();
 
-        if (return_type != nullptr && return_type->get_name() != nullptr) {
-            if (std::string_view{return_type->get_name()}.contains("!")) {
+    // Go through any of the params and look for ! in the name
+    for (auto& param : method_param_types) {
+        if (param != nullptr && param->get_name() != nullptr) {
+            if (std::string_view{param->get_name()}.contains("!")) {
                 return true;
             }
         }
+    }
 
-        const auto method_param_types = m.get_param_types();
+    return false;
+}
 
-        // Go through any of the params and look for ! in the name
-        for (auto& param : method_param_types) {
-            if (param != nullptr && param->get_name() != nullptr) {
-                if (std::string_view{param->get_name()}.contains("!")) {
-                    return true;
-                }
+sdk::REMethodDefinition* RETypeDefinition::get_method(std::string_view name) const {
+    const auto name_hash = std::hash<std::string_view>{}(name);
+
+    {
+        std::shared_lock _{g_method_mtx};
+
+        if (auto it = g_method_map.find(this); it != g_method_map.end()) {
+            if (auto it2 = it->second.find(name_hash); it2 != it->second.end()) {
+                return it2->second;
             }
         }
-
-        return false;
-    };
+    }
 
     for (auto super = this; super != nullptr; super = super->get_parent_type()) {
         for (auto& m : super->get_methods()) {
@@ -544,6 +562,124 @@ sdk::REMethodDefinition* RETypeDefinition::get_method(std::string_view name) con
     return g_method_map[this][name_hash] = nullptr;
 }
 
+// Serves every name it can from cache under one shared lock, the rest go through lookup.
+template <typename T, typename Fn>
+static size_t find_cached(const sdk::RETypeDefinition* t, std::shared_mutex& mtx, const std::unordered_map<const sdk::RETypeDefinition*, std::unordered_map<size_t, T*>>& cache,
+                          std::span<const std::string_view> names, std::span<T*> out, Fn&& lookup) 
+{
+    const auto count = std::min(names.size(), out.size());
+    std::vector<size_t> misses{};
+    size_t found{};
+
+    {
+        std::shared_lock _{mtx};
+
+        const auto it = cache.find(t);
+
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = nullptr;
+
+            if (it == cache.end()) {
+                misses.push_back(i);
+                continue;
+            }
+
+            if (auto it2 = it->second.find(std::hash<std::string_view>{}(names[i])); it2 != it->second.end()) {
+                out[i] = it2->second;
+                found += out[i] != nullptr ? 1 : 0;
+            } else {
+                misses.push_back(i);
+            }
+        }
+    }
+
+    for (const auto i : misses) {
+        out[i] = lookup(names[i]);
+        found += out[i] != nullptr ? 1 : 0;
+    }
+
+    return found;
+}
+
+size_t RETypeDefinition::find_methods(std::span<const std::string_view> names, std::span<sdk::REMethodDefinition*> out) const {
+    return find_cached(this, g_method_mtx, g_method_map, names, out, [this](std::string_view name) { return get_method(name); });
+}
+
+size_t RETypeDefinition::find_fields(std::span<const std::string_view> names, std::span<sdk::REField*> out) const {
+    return find_cached(this, g_field_mtx, g_field_map, names, out, [this](std::string_view name) { return get_field(name); });
+}
+
+void detail::collect_type_caches(uint32_t begin, uint32_t end, TypeCacheBatch& out) {
+    const auto tdb = RETypeDB::get();
+
+    for (auto i = begin; i < end; ++i) {
+        const auto t = tdb->get_type(i);
+
+        if (t == nullptr) {
+            continue;
+        }
+
+#if TDB_VER > 49
+        // Same split as get_full_name, anything generic or nameless is left to it.
+        if (t->get_generic_data() == nullptr) {
+            if (auto name = build_declared_name(t); !name.empty()) {
+                out.full_names.emplace_back(i, std::move(name));
+            } else {
+                ++out.num_deferred_names;
+            }
+        } else {
+            ++out.num_deferred_names;
+        }
+#endif
+
+        // Declaration order, so the first one per name is what get_method/get_field would find.
+        for (auto& m : t->get_methods()) {
+            if (m.get_name() != nullptr && !is_generic_method_definition(m)) {
+                out.methods.push_back({t, std::hash<std::string_view>{}(m.get_name()), &m});
+            }
+        }
+
+        for (auto f : t->get_fields()) {
+            if (f != nullptr && f->get_name() != nullptr) {
+                out.fields.push_back({t, std::hash<std::string_view>{}(f->get_name()), f});
+            }
+        }
+    }
+}
+
+void detail::publish_type_caches(std::span<TypeCacheBatch> batches) {
+    // Existing entries win, they were resolved the same way.
+    {
+        std::unique_lock _{g_full_name_mtx};
+
+        for (auto& batch : batches) {
+            for (auto& [index, name] : batch.full_names) {
+                g_full_names.try_emplace(index, std::move(name));
+            }
+        }
+    }
+
+    {
+        std::unique_lock _{g_method_mtx};
+
+        for (const auto& batch : batches) {
+            for (const auto& entry : batch.methods) {
+                g_method_map[entry.owner].try_emplace(entry.name_hash, entry.method);
+            }
+        }
+    }
+
+    {
+        std::unique_lock _{g_field_mtx};
+
+        for (const auto& batch : batches) {
+            for (const auto& entry : batch.fields) {
+                g_field_map[entry.owner].try_emplace(entry.name_hash, entry.field);
+            }
+        }
+    }
+}
+
 std::vector<sdk::REMethodDefinition*> RETypeDefinition::get_methods(std::string_view name) const {
     std::vector<sdk::REMethodDefinition*> out{};
 
@@ -948,7 +1084,7 @@ static std::shared_mutex g_runtime_type_mtx{};
     }
 
     const auto assembly_count = assemblies->get_size();
-    const auto managed_string = sdk::VM::create_managed_string(utility::widen(this->get_full_name()));
+    const auto managed_string = sdk::VM::create_managed_string_interned(utility::widen(this->get_full_name()));
 
     for (auto i = 0; i < assembly_count; ++i) {
         auto assembly = (REManagedObject*)assemblies->get_element(i);
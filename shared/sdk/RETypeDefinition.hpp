@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -321,6 +322,11 @@ struct RETypeDefinition : public sdk::RETypeDefinition_ {
     sdk::REField* get_field(std::string_view name) const;
     sdk::REMethodDefinition* get_method(std::string_view name) const;
     std::vector<sdk::REMethodDefinition*> get_methods(std::string_view name) const;
+
+    // get_method/get_field for several names at once, taking the cache lock once instead of per name.
+    // out[i] is nullptr if names[i] wasn't found, returns how many were found.
+    size_t find_methods(std::span<const std::string_view> names, std::span<sdk::REMethodDefinition*> out) const;
+    size_t find_fields(std::span<const std::string_view> names, std::span<sdk::REField*> out) const;
     std::vector<sdk::RETypeDefinition*> get_generic_argument_types() const;
     sdk::GenericListData* get_generic_data() const;
 
@@ -0,0 +1,169 @@
+#include <spdlog/spdlog.h>
+
+#include "ReClass.hpp"
+#include "SceneManager.hpp"
+#include "SceneQuery.hpp"
+
+namespace sdk {
+namespace detail {
+// The lists we walk are owned by the engine and can be modified while we're walking them,
+// so put a hard cap on how far we're willing to go before giving up.
+constexpr size_t MAX_SCENE_WALK = 1 << 20;
+
+class TypeMatchCache {
+public:
+    bool matches(sdk::RETypeDefinition* t, sdk::RETypeDefinition* target) {
+        if (t == nullptr) {
+            return false;
+        }
+
+        if (target != m_target) {
+            m_target = target;
+            m_results.clear();
+        }
+
+        const auto index = t->get_index();
+
+        if (index >= m_results.size()) {
+            const auto tdb = sdk::RETypeDB::get();
+            m_results.resize(std::max<size_t>(index + 1, tdb != nullptr ? tdb->get_num_types() : 0), UNKNOWN);
+        }
+
+        auto& result = m_results[index];
+
+        if (result == UNKNOWN) {
+            result = t->is_a(target) ? MATCH : NO_MATCH;
+        }
+
+        return result == MATCH;
+    }
+
+private:
+    static constexpr int8_t UNKNOWN = -1;
+    static constexpr int8_t NO_MATCH = 0;
+    static constexpr int8_t MATCH = 1;
+
+    sdk::RETypeDefinition* m_target{nullptr};
+    std::vector<int8_t> m_results{};
+};
+}
+
+::RETransform* get_first_transform(::REManagedObject* scene) {
+    if (scene == nullptr) {
+        scene = sdk::get_current_scene();
+    }
+
+    if (scene == nullptr) {
+        return nullptr;
+    }
+
+    static auto scene_def = sdk::find_type_definition("via.Scene");
+    static auto get_first_transform_method = scene_def != nullptr ? scene_def->get_method("get_FirstTransform") : nullptr;
+
+    if (get_first_transform_method == nullptr) {
+        return nullptr;
+    }
+
+    return get_first_transform_method->call<::RETransform*>(sdk::get_thread_context(), scene);
+}
+
+void query_scene(const SceneQuery& query, std::vector<SceneQueryResult>& out) {
+    const auto first_transform = get_first_transform();
+
+    if (first_transform == nullptr) {
+        return;
+    }
+
+    // One cache per thread, the type index lookup table is reused across queries for the same type.
+    thread_local detail::TypeMatchCache type_cache{};
+    thread_local std::vector<::RETransform*> stack{};
+
+    const auto radius_sq = query.radius * query.radius;
+    const auto start_size = out.size();
+
+    auto is_full = [&]() {
+        return query.max_results > 0 && out.size() - start_size >= query.max_results;
+    };
+
+    auto visit = [&](::RETransform* transform) {
+        const auto& position = transform->worldTransform[3];
+
+        if (query.use_radius) {
+            const auto delta = Vector3f{position} - query.origin;
+
+            if (glm::dot(delta, delta) > radius_sq) {
+                return;
+            }
+        }
+
+        const auto owner = transform->ownerGameObject;
+
+        if (query.component_type == nullptr) {
+            out.push_back(SceneQueryResult{
+                .object = transform,
+                .game_object = owner,
+                .type = utility::re_managed_object::get_type_definition(transform),
+                .position = position
+            });
+
+            return;
+        }
+
+        // The transform is the head of the GameObject's component list.
+        size_t count = 0;
+        for (::REComponent* comp = transform; comp != nullptr && count < detail::MAX_SCENE_WALK; ++count) {
+            const auto t = utility::re_managed_object::get_type_definition(comp);
+
+            if (type_cache.matches(t, query.component_type)) {
+                out.push_back(SceneQueryResult{
+                    .object = comp,
+                    .game_object = owner,
+                    .type = t,
+                    .position = position
+                });
+
+                if (is_full()) {
+                    return;
+                }
+            }
+
+            comp = comp->childComponent;
+
+            if (comp == transform) {
+                break;
+            }
+        }
+    };
+
+    stack.clear();
+    stack.push_back(first_transform);
+
+    size_t visited = 0;
+
+    while (!stack.empty() && !is_full()) {
+        auto transform = stack.back();
+        stack.pop_back();
+
+        // Walk the sibling list, deferring each child list to the stack.
+        for (; transform != nullptr && visited < detail::MAX_SCENE_WALK && !is_full(); transform = transform->next, ++visited) {
+            visit(transform);
+
+            if (query.recursive && transform->child != nullptr) {
+                stack.push_back(transform->child);
+            }
+        }
+
+        if (visited >= detail::MAX_SCENE_WALK) {
+            spdlog::error("[SceneQuery] Scene walk exceeded {} transforms, aborting", detail::MAX_SCENE_WALK);
+            break;
+        }
+    }
+}
+
+std::vector<SceneQueryResult> query_scene(const SceneQuery& query) {
+    std::vector<SceneQueryResult> out{};
+    query_scene(query, out);
+
+    return out;
+}
+} // namespace sdk
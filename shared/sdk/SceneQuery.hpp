@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Math.hpp"
+
+class REManagedObject;
+class REGameObject;
+class RETransform;
+
+namespace sdk {
+struct RETypeDefinition;
+
+// One entry per match, kept flat so a whole query can be handed around
+// (to Lua, to other native code) as a single contiguous array.
+struct SceneQueryResult {
+    ::REManagedObject* object{nullptr}; // The transform, or the matching component
+    ::REGameObject* game_object{nullptr};
+    sdk::RETypeDefinition* type{nullptr};
+    Vector4f position{}; // World position of the owning transform
+};
+
+struct SceneQuery {
+    // nullptr means "just the transforms", otherwise every component that is_a this type
+    sdk::RETypeDefinition* component_type{nullptr};
+
+    // Walk the children of each root transform, not just the roots
+    bool recursive{true};
+
+    bool use_radius{false};
+    Vector3f origin{};
+    float radius{0.0f};
+
+    // 0 = unlimited
+    uint32_t max_results{0};
+};
+
+::RETransform* get_first_transform(::REManagedObject* scene = nullptr);
+
+// Walks the native transform/component lists of the current scene directly,
+// instead of calling get_Next/get_Child/get_GameObject/get_Position through the VM per transform.
+// Results are appended to out, which is not cleared first.
+void query_scene(const SceneQuery& query, std::vector<SceneQueryResult>& out);
+std::vector<SceneQueryResult> query_scene(const SceneQuery& query);
+} // namespace sdk
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+#include "MethodIndex.hpp"
+#include "TDBWarmup.hpp"
+#include "TypeSearch.hpp"
+
+namespace sdk {
+namespace detail {
+enum class WarmupState {
+    IDLE,
+    RUNNING,
+    FINISHED,
+};
+
+std::mutex g_warmup_mtx{};
+std::condition_variable g_warmup_cv{};
+WarmupState g_warmup_state{WarmupState::IDLE};
+
+constexpr uint32_t WARMUP_TYPES_PER_CHUNK = 1024;
+
+// The game is still loading while this runs, so leave it at least half of the cores.
+constexpr uint32_t MAX_WARMUP_WORKERS = 8;
+
+void local_frame_gc() {
+    // get_full_name can create managed strings through reflection.
+    if (auto context = sdk::get_thread_context(); context != nullptr) try {
+        context->local_frame_gc();
+    } catch(...) {
+        spdlog::error("[TDBWarmup] Failed to run local frame GC.");
+    }
+}
+
+// Runs fn(chunk) for every chunk, spread over num_threads threads including the calling one.
+template <typename Fn>
+void for_each_chunk(size_t num_chunks, uint32_t num_threads, Fn&& fn) {
+    std::atomic<size_t> next_chunk{0};
+
+    const auto work = [&]() {
+        for (auto chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) try {
+            fn(chunk);
+        } catch(...) {
+            // Whatever was in the chunk resolves lazily instead.
+            spdlog::error("[TDBWarmup] Exception in chunk {}", chunk);
+        }
+    };
+
+    std::vector<std::jthread> workers{};
+
+    for (uint32_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([&]() {
+            work();
+            local_frame_gc();
+        });
+    }
+
+    work();
+}
+
+void warm_up(sdk::RETypeDB* tdb) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    const auto num_types = tdb->get_num_types();
+    const auto num_chunks = (num_types + WARMUP_TYPES_PER_CHUNK - 1) / WARMUP_TYPES_PER_CHUNK;
+    const auto num_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_WARMUP_WORKERS);
+
+    const auto chunk_begin = [&](size_t chunk) { return (uint32_t)(chunk * WARMUP_TYPES_PER_CHUNK); };
+    const auto chunk_end = [&](size_t chunk) { return std::min<uint32_t>(chunk_begin(chunk) + WARMUP_TYPES_PER_CHUNK, num_types); };
+
+    // Plain type names and members, nothing in here calls into the game.
+    size_t num_deferred_names{};
+    size_t num_methods{};
+    size_t num_fields{};
+
+    {
+        std::vector<TypeCacheBatch> batches(num_chunks);
+
+        for_each_chunk(num_chunks, num_threads, [&](size_t chunk) {
+            collect_type_caches(chunk_begin(chunk), chunk_end(chunk), batches[chunk]);
+        });
+
+        for (const auto& batch : batches) {
+            num_deferred_names += batch.num_deferred_names;
+            num_methods += batch.methods.size();
+            num_fields += batch.fields.size();
+        }
+
+        publish_type_caches(batches);
+    }
+
+    // Generic instances and arrays go through get_full_name as usual, everything else hits the cache.
+    // Then every full name gets its find_type entry.
+    {
+        std::vector<std::vector<std::pair<std::string, sdk::RETypeDefinition*>>> names(num_chunks);
+
+        for_each_chunk(num_chunks, num_threads, [&](size_t chunk) {
+            auto& out = names[chunk];
+            out.reserve(chunk_end(chunk) - chunk_begin(chunk));
+
+            for (auto i = chunk_begin(chunk); i < chunk_end(chunk); ++i) {
+                if (auto t = tdb->get_type(i); t != nullptr) {
+                    out.emplace_back(t->get_full_name(), t);
+                }
+            }
+        });
+
+        publish_type_names(names);
+    }
+
+#if TDB_VER >= 71
+    // Resolves the encoded function base, a scan that otherwise happens on the first call to anything.
+    for (uint32_t i = 0; i < tdb->get_num_methods(); ++i) {
+        if (auto m = tdb->get_method(i); m != nullptr && m->encoded_offset != 0) {
+            m->get_function();
+            break;
+        }
+    }
+#endif
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    spdlog::info("[TDBWarmup] Warmed up {} types ({} generic or arrays), {} methods and {} fields in {}ms on {} threads",
+        num_types, num_deferred_names, num_methods, num_fields, std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), num_threads);
+}
+} // namespace detail
+
+void TDBWarmup::start() {
+    const auto tdb = sdk::RETypeDB::get();
+
+    if (tdb == nullptr) {
+        return;
+    }
+
+    {
+        std::scoped_lock _{detail::g_warmup_mtx};
+
+        if (detail::g_warmup_state != detail::WarmupState::IDLE) {
+            return;
+        }
+
+        detail::g_warmup_state = detail::WarmupState::RUNNING;
+    }
+
+    spdlog::info("[TDBWarmup] Starting");
+
+    std::thread{[tdb] {
+        try {
+            detail::warm_up(tdb);
+        } catch(...) {
+            spdlog::error("[TDBWarmup] Exception during warm-up, the remaining lookups will resolve lazily");
+        }
+
+        detail::local_frame_gc();
+
+        // Both indices read every full name, which are all cached by now.
+        // Their Lua bindings report them as building until then instead of blocking the game thread.
+        sdk::TypeSearchIndex::build_async();
+        sdk::MethodAddressIndex::build_async();
+
+        std::scoped_lock _{detail::g_warmup_mtx};
+        detail::g_warmup_state = detail::WarmupState::FINISHED;
+        detail::g_warmup_cv.notify_all();
+    }}.detach();
+}
+
+void TDBWarmup::wait() {
+    std::unique_lock lock{detail::g_warmup_mtx};
+    detail::g_warmup_cv.wait(lock, [] { return detail::g_warmup_state != detail::WarmupState::RUNNING; });
+}
+
+bool TDBWarmup::is_finished() {
+    std::scoped_lock _{detail::g_warmup_mtx};
+    return detail::g_warmup_state == detail::WarmupState::FINISHED;
+}
+} // namespace sdk
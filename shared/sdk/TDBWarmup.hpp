@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+struct RETypeDefinition;
+struct REMethodDefinition;
+struct REField;
+
+namespace detail {
+// Everything a warm-up worker found in a range of types, published into the lookup caches in one go.
+// Only a type's own members are collected, the same entries get_method/get_field would cache
+// for names declared on the type itself.
+struct TypeCacheBatch {
+    struct Method {
+        const sdk::RETypeDefinition* owner{};
+        size_t name_hash{};
+        sdk::REMethodDefinition* method{};
+    };
+
+    struct Field {
+        const sdk::RETypeDefinition* owner{};
+        size_t name_hash{};
+        sdk::REField* field{};
+    };
+
+    std::vector<std::pair<uint32_t, std::string>> full_names{}; // Types whose name doesn't need generics or reflection
+    size_t num_deferred_names{};                                 // The rest, left to get_full_name
+    std::vector<Method> methods{};
+    std::vector<Field> fields{};
+};
+
+// RETypeDefinition.cpp
+void collect_type_caches(uint32_t begin, uint32_t end, TypeCacheBatch& out);
+void publish_type_caches(std::span<TypeCacheBatch> batches);
+
+// RETypeDB.cpp, chunks in type index order so the first type with a name wins like in find_type.
+void publish_type_names(std::span<std::vector<std::pair<std::string, sdk::RETypeDefinition*>>> chunks);
+}
+
+// Pre-populates the type, full name, method and field lookup caches on background threads
+// once the TDB is available, so the first scripts to run don't pay for the linear scans.
+// Nothing depends on it finishing, whatever isn't warmed up yet still resolves lazily.
+// Starts building the TypeSearchIndex and MethodAddressIndex once it's done.
+class TDBWarmup {
+public:
+    // Does nothing if already started or the TDB isn't available yet.
+    static void start();
+
+    // Returns immediately if the warm-up was never started.
+    static void wait();
+
+    static bool is_finished();
+};
+} // namespace sdk
@@ -0,0 +1,565 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+#include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+#include "TypeSearch.hpp"
+
+namespace sdk {
+namespace detail {
+enum class IndexState {
+    IDLE,
+    BUILDING,
+    BUILT,
+};
+
+std::mutex g_search_index_mtx{};
+std::condition_variable g_search_index_cv{};
+std::shared_ptr<const TypeSearchIndex> g_search_index{};
+IndexState g_search_index_state{IndexState::IDLE};
+
+std::string to_lower(std::string_view s) {
+    std::string out{s};
+
+    for (auto& c : out) {
+        if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+    }
+
+    return out;
+}
+
+uint32_t make_trigram(const char* s) {
+    return ((uint32_t)(uint8_t)s[0] << 16) | ((uint32_t)(uint8_t)s[1] << 8) | (uint32_t)(uint8_t)s[2];
+}
+
+bool is_boundary(char c) {
+    switch (c) {
+    case '.': case '_': case '`': case '<': case '>': case ',': case '+': case '/': case ' ': case '[':
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_subsequence(std::string_view pattern, std::string_view name) {
+    size_t j = 0;
+
+    for (size_t i = 0; i < name.size() && j < pattern.size(); ++i) {
+        if (name[i] == pattern[j]) {
+            ++j;
+        }
+    }
+
+    return j == pattern.size();
+}
+
+// Higher is better, -1 means no match. Substring matches always outrank fuzzy ones.
+constexpr int32_t SCORE_EXACT = 1000;
+constexpr int32_t SCORE_PREFIX = 900;
+constexpr int32_t SCORE_LAST_SEGMENT = 800;
+constexpr int32_t SCORE_BOUNDARY = 700;
+constexpr int32_t SCORE_SUBSTRING = 500;
+constexpr int32_t SCORE_FUZZY = 300;
+
+int32_t score_name(std::string_view name, std::string_view pattern, TypeSearchIndex::Mode mode) {
+    if (name == pattern) {
+        return SCORE_EXACT;
+    }
+
+    const auto pos = name.find(pattern);
+
+    if (pos == 0) {
+        return SCORE_PREFIX;
+    }
+
+    if (mode == TypeSearchIndex::Mode::PREFIX) {
+        return -1;
+    }
+
+    if (pos != std::string_view::npos) {
+        // e.g. "player" in "app.ropeway.PlayerManager" should beat "app.ropeway.player.Foo"
+        if (name[pos - 1] == '.' && name.find('.', pos) == std::string_view::npos) {
+            return SCORE_LAST_SEGMENT;
+        }
+
+        return is_boundary(name[pos - 1]) ? SCORE_BOUNDARY : SCORE_SUBSTRING;
+    }
+
+    if (mode == TypeSearchIndex::Mode::SUBSTRING) {
+        return -1;
+    }
+
+    int32_t score = SCORE_FUZZY;
+    size_t j = 0;
+    size_t last = std::string_view::npos;
+
+    for (size_t i = 0; i < name.size() && j < pattern.size(); ++i) {
+        if (name[i] != pattern[j]) {
+            continue;
+        }
+
+        if (last != std::string_view::npos) {
+            score -= (int32_t)std::min<size_t>(i - last - 1, 10);
+        }
+
+        if (i > 0 && is_boundary(name[i - 1])) {
+            score += 5;
+        }
+
+        last = i;
+        ++j;
+    }
+
+    if (j < pattern.size()) {
+        return -1;
+    }
+
+    return std::clamp(score, 1, SCORE_SUBSTRING - 1);
+}
+} // namespace detail
+
+sdk::RETypeDefinition* TypeSearchIndex::Result::get_type() const {
+    return kind == Kind::TYPE ? sdk::RETypeDB::get()->get_type(index) : nullptr;
+}
+
+sdk::REMethodDefinition* TypeSearchIndex::Result::get_method() const {
+    return kind == Kind::METHOD ? sdk::RETypeDB::get()->get_method(index) : nullptr;
+}
+
+sdk::REField* TypeSearchIndex::Result::get_field() const {
+    return kind == Kind::FIELD ? sdk::RETypeDB::get()->get_field(index) : nullptr;
+}
+
+sdk::RETypeDefinition* TypeSearchIndex::Result::get_owner() const {
+    switch (kind) {
+    case Kind::TYPE:
+        return get_type();
+    case Kind::METHOD:
+        return get_method()->get_declaring_type();
+    case Kind::FIELD:
+        return get_field()->get_declaring_type();
+    default:
+        return nullptr;
+    }
+}
+
+std::string TypeSearchIndex::Result::get_display_name() const {
+    const auto owner = get_owner();
+    const auto owner_name = owner != nullptr ? owner->get_full_name() : std::string{"<unknown>"};
+
+    switch (kind) {
+    case Kind::TYPE:
+        return owner_name;
+    case Kind::METHOD:
+        return owner_name + "." + get_method()->get_name();
+    case Kind::FIELD:
+        return owner_name + "." + get_field()->get_name();
+    default:
+        return owner_name;
+    }
+}
+
+std::shared_ptr<const TypeSearchIndex> TypeSearchIndex::get() {
+    std::scoped_lock _{detail::g_search_index_mtx};
+    return detail::g_search_index;
+}
+
+void TypeSearchIndex::build_async() {
+    {
+        std::scoped_lock _{detail::g_search_index_mtx};
+
+        if (detail::g_search_index_state != detail::IndexState::IDLE) {
+            return;
+        }
+
+        detail::g_search_index_state = detail::IndexState::BUILDING;
+    }
+
+    std::thread{[] {
+        std::shared_ptr<const TypeSearchIndex> index = build();
+
+        std::scoped_lock _{detail::g_search_index_mtx};
+        detail::g_search_index = std::move(index);
+
+        // Go back to idle if the TDB wasn't ready so the next caller retries.
+        detail::g_search_index_state = detail::g_search_index != nullptr ? detail::IndexState::BUILT : detail::IndexState::IDLE;
+        detail::g_search_index_cv.notify_all();
+    }}.detach();
+}
+
+std::shared_ptr<const TypeSearchIndex> TypeSearchIndex::wait() {
+    std::unique_lock lock{detail::g_search_index_mtx};
+
+    if (detail::g_search_index_state == detail::IndexState::IDLE) {
+        detail::g_search_index_state = detail::IndexState::BUILDING;
+        lock.unlock();
+
+        std::shared_ptr<const TypeSearchIndex> index = build();
+
+        lock.lock();
+        detail::g_search_index = std::move(index);
+        detail::g_search_index_state = detail::g_search_index != nullptr ? detail::IndexState::BUILT : detail::IndexState::IDLE;
+        detail::g_search_index_cv.notify_all();
+
+        return detail::g_search_index;
+    }
+
+    detail::g_search_index_cv.wait(lock, [] { return detail::g_search_index_state != detail::IndexState::BUILDING; });
+    return detail::g_search_index;
+}
+
+std::unique_ptr<TypeSearchIndex> TypeSearchIndex::build() try {
+    const auto tdb = sdk::RETypeDB::get();
+
+    if (tdb == nullptr) {
+        return nullptr;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    auto out = std::make_unique<TypeSearchIndex>();
+
+    std::unordered_map<std::string, uint32_t> name_ids{};
+    std::vector<std::pair<uint32_t, Entry>> raw_entries{};
+
+    raw_entries.reserve(tdb->get_num_types() + tdb->get_num_methods() + tdb->get_num_fields());
+
+    const auto add = [&](const char* name, Kind kind, uint32_t index) {
+        if (name == nullptr || name[0] == '\0') {
+            return;
+        }
+
+        auto [it, inserted] = name_ids.try_emplace(detail::to_lower(name), (uint32_t)name_ids.size());
+        raw_entries.emplace_back(it->second, Entry{kind, index});
+    };
+
+    for (uint32_t i = 0; i < tdb->get_num_types(); ++i) {
+        if (auto t = tdb->get_type(i); t != nullptr) {
+            add(t->get_full_name().c_str(), Kind::TYPE, i);
+        }
+    }
+
+    for (uint32_t i = 0; i < tdb->get_num_methods(); ++i) {
+        if (auto m = tdb->get_method(i); m != nullptr) {
+            add(m->get_name(), Kind::METHOD, i);
+        }
+    }
+
+    for (uint32_t i = 0; i < tdb->get_num_fields(); ++i) {
+        if (auto f = tdb->get_field(i); f != nullptr) {
+            add(f->get_name(), Kind::FIELD, i);
+        }
+    }
+
+    // Names
+    out->m_names.resize(name_ids.size());
+
+    size_t total_length = 0;
+
+    for (const auto& [name, id] : name_ids) {
+        total_length += name.size();
+    }
+
+    out->m_text.reserve(total_length);
+
+    for (const auto& [name, id] : name_ids) {
+        out->m_names[id].offset = (uint32_t)out->m_text.size();
+        out->m_names[id].length = (uint32_t)name.size();
+        out->m_text += name;
+    }
+
+    name_ids.clear();
+
+    // Entries, grouped by name with a counting sort
+    for (const auto& [id, entry] : raw_entries) {
+        ++out->m_names[id].num_entries;
+    }
+
+    uint32_t running = 0;
+
+    for (auto& name : out->m_names) {
+        name.first_entry = running;
+        running += name.num_entries;
+        name.num_entries = 0;
+    }
+
+    out->m_entries.resize(raw_entries.size());
+
+    for (const auto& [id, entry] : raw_entries) {
+        auto& name = out->m_names[id];
+        out->m_entries[name.first_entry + name.num_entries++] = entry;
+    }
+
+    raw_entries.clear();
+    raw_entries.shrink_to_fit();
+
+    // Prefix order
+    out->m_sorted.resize(out->m_names.size());
+    std::iota(out->m_sorted.begin(), out->m_sorted.end(), 0);
+    std::sort(out->m_sorted.begin(), out->m_sorted.end(), [&](uint32_t a, uint32_t b) { return out->get_name(a) < out->get_name(b); });
+
+    // Trigrams
+    std::vector<uint64_t> pairs{};
+    pairs.reserve(total_length);
+
+    for (uint32_t id = 0; id < out->m_names.size(); ++id) {
+        const auto name = out->get_name(id);
+
+        for (size_t i = 0; i + 3 <= name.size(); ++i) {
+            pairs.push_back(((uint64_t)detail::make_trigram(name.data() + i) << 32) | id);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    out->m_trigram_postings.reserve(pairs.size());
+
+    for (const auto pair : pairs) {
+        const auto trigram = (uint32_t)(pair >> 32);
+
+        if (out->m_trigrams.empty() || out->m_trigrams.back() != trigram) {
+            out->m_trigrams.push_back(trigram);
+            out->m_trigram_offsets.push_back((uint32_t)out->m_trigram_postings.size());
+        }
+
+        out->m_trigram_postings.push_back((uint32_t)pair);
+    }
+
+    out->m_trigram_offsets.push_back((uint32_t)out->m_trigram_postings.size());
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    spdlog::info("[TypeSearch] Indexed {} names ({} types/methods/fields, {} trigrams) in {}ms",
+        out->m_names.size(), out->m_entries.size(), out->m_trigrams.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+
+    return out;
+} catch (const std::exception& e) {
+    spdlog::error("[TypeSearch] Failed to build index: {}", e.what());
+    return nullptr;
+} catch (...) {
+    spdlog::error("[TypeSearch] Failed to build index: unknown exception");
+    return nullptr;
+}
+
+bool TypeSearchIndex::collect_candidates(std::string_view lower_pattern, Mode mode, std::vector<uint32_t>& out) const {
+    out.clear();
+
+    if (mode == Mode::PREFIX) {
+        const auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), lower_pattern,
+            [&](uint32_t id, std::string_view p) { return get_name(id) < p; });
+
+        for (auto i = it; i != m_sorted.end() && get_name(*i).starts_with(lower_pattern); ++i) {
+            out.push_back(*i);
+        }
+
+        return true;
+    }
+
+    if (mode == Mode::FUZZY || lower_pattern.size() < 3) {
+        return false;
+    }
+
+    // Substring: every name containing the pattern contains all of its trigrams.
+    std::vector<std::pair<const uint32_t*, const uint32_t*>> lists{};
+
+    for (size_t i = 0; i + 3 <= lower_pattern.size(); ++i) {
+        const auto trigram = detail::make_trigram(lower_pattern.data() + i);
+        const auto it = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), trigram);
+
+        if (it == m_trigrams.end() || *it != trigram) {
+            return true; // nothing can match
+        }
+
+        const auto slot = std::distance(m_trigrams.begin(), it);
+        lists.emplace_back(m_trigram_postings.data() + m_trigram_offsets[slot], m_trigram_postings.data() + m_trigram_offsets[slot + 1]);
+    }
+
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) { return (a.second - a.first) < (b.second - b.first); });
+
+    out.assign(lists[0].first, lists[0].second);
+
+    for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+        std::erase_if(out, [&](uint32_t id) { return !std::binary_search(lists[i].first, lists[i].second, id); });
+    }
+
+    return true;
+}
+
+void TypeSearchIndex::rank(const Query& query, std::string_view lower_pattern, Mode mode, std::span<const uint32_t> name_ids, std::vector<Result>& out) const {
+    struct Scored {
+        int32_t score;
+        uint32_t length;
+        uint32_t name_id;
+        uint32_t entry;
+    };
+
+    std::vector<Scored> scored{};
+    int32_t best = -1;
+
+    const auto visit = [&](uint32_t name_id) {
+        const auto& name = m_names[name_id];
+        const auto score = detail::score_name(get_name(name_id), lower_pattern, mode);
+
+        if (score < 0) {
+            return;
+        }
+
+        for (auto i = name.first_entry; i < name.first_entry + name.num_entries; ++i) {
+            if ((query.kinds & (1 << (uint8_t)m_entries[i].kind)) == 0) {
+                continue;
+            }
+
+            scored.push_back({score, name.length, name_id, i});
+            best = std::max(best, score);
+        }
+    };
+
+    if (name_ids.empty()) {
+        for (uint32_t id = 0; id < m_names.size(); ++id) {
+            visit(id);
+        }
+    } else {
+        for (const auto id : name_ids) {
+            visit(id);
+        }
+    }
+
+    // In AUTO mode fuzzy matches are only shown when nothing contains the pattern.
+    if (mode == Mode::AUTO && best >= detail::SCORE_SUBSTRING) {
+        std::erase_if(scored, [](const Scored& s) { return s.score < detail::SCORE_SUBSTRING; });
+    }
+
+    const auto better = [this](const Scored& a, const Scored& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+
+        if (a.length != b.length) {
+            return a.length < b.length;
+        }
+
+        if (a.name_id != b.name_id) {
+            return get_name(a.name_id) < get_name(b.name_id);
+        }
+
+        return a.entry < b.entry;
+    };
+
+    const auto count = query.max_results != 0 ? std::min(query.max_results, scored.size()) : scored.size();
+
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(), better);
+
+    out.clear();
+    out.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& entry = m_entries[scored[i].entry];
+        out.push_back({entry.kind, entry.index, scored[i].score});
+    }
+}
+
+void TypeSearchIndex::search(const Query& query, std::vector<Result>& out) const {
+    const auto lower_pattern = detail::to_lower(query.pattern);
+
+    out.clear();
+
+    if (lower_pattern.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> candidates{};
+
+    if (collect_candidates(lower_pattern, query.mode, candidates)) {
+        if (!candidates.empty()) {
+            rank(query, lower_pattern, query.mode, candidates, out);
+        }
+
+        if (!out.empty() || query.mode != Mode::AUTO) {
+            return;
+        }
+    }
+
+    rank(query, lower_pattern, query.mode, {}, out);
+}
+
+void TypeSearchIndex::search(const Query& query, std::span<const uint32_t> name_ids, std::vector<Result>& out) const {
+    const auto lower_pattern = detail::to_lower(query.pattern);
+
+    out.clear();
+
+    if (lower_pattern.empty()) {
+        return;
+    }
+
+    rank(query, lower_pattern, query.mode, name_ids, out);
+}
+
+void TypeSearchIndex::filter_names(std::string_view lower_pattern, std::span<const uint32_t> name_ids, std::vector<uint32_t>& out) const {
+    if (name_ids.empty()) {
+        for (uint32_t id = 0; id < m_names.size(); ++id) {
+            if (detail::is_subsequence(lower_pattern, get_name(id))) {
+                out.push_back(id);
+            }
+        }
+
+        return;
+    }
+
+    for (const auto id : name_ids) {
+        if (detail::is_subsequence(lower_pattern, get_name(id))) {
+            out.push_back(id);
+        }
+    }
+}
+
+const std::vector<TypeSearchIndex::Result>* TypeSearchSession::update(const TypeSearchIndex::Query& query) {
+    if (m_index == nullptr) {
+        m_index = TypeSearchIndex::get();
+
+        if (m_index == nullptr) {
+            TypeSearchIndex::build_async();
+            return nullptr;
+        }
+    }
+
+    const auto lower_pattern = detail::to_lower(query.pattern);
+
+    m_results.clear();
+
+    if (lower_pattern.empty()) {
+        m_pattern.clear();
+        m_candidates.clear();
+        return &m_results;
+    }
+
+    // Anything that matches the new pattern also matched the old one if the old one is contained in it.
+    const auto can_narrow = !m_pattern.empty() && lower_pattern.find(m_pattern) != std::string::npos;
+
+    m_scratch.clear();
+
+    // An empty span means "all names" to filter_names, so don't widen a search that already found nothing.
+    if (!can_narrow || !m_candidates.empty()) {
+        m_index->filter_names(lower_pattern, can_narrow ? std::span<const uint32_t>{m_candidates} : std::span<const uint32_t>{}, m_scratch);
+    }
+
+    m_candidates.swap(m_scratch);
+    m_pattern = lower_pattern;
+
+    if (!m_candidates.empty()) {
+        m_index->search(query, m_candidates, m_results);
+    }
+
+    return &m_results;
+}
+} // namespace sdk
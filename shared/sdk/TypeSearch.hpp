@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdk {
+struct RETypeDefinition;
+struct REMethodDefinition;
+struct REField;
+
+// Name index over every type, method and field in the TDB.
+// Built once on a background thread, immutable afterwards, so it can be searched from any thread.
+// All matching is case-insensitive.
+class TypeSearchIndex {
+public:
+    enum class Kind : uint8_t {
+        TYPE,
+        METHOD,
+        FIELD,
+    };
+
+    enum KindMask : uint8_t {
+        TYPES = 1 << (uint8_t)Kind::TYPE,
+        METHODS = 1 << (uint8_t)Kind::METHOD,
+        FIELDS = 1 << (uint8_t)Kind::FIELD,
+        ALL = TYPES | METHODS | FIELDS,
+    };
+
+    enum class Mode : uint8_t {
+        AUTO,      // Substring, falls back to fuzzy if nothing contains the pattern
+        PREFIX,
+        SUBSTRING,
+        FUZZY,     // Pattern characters appear in order
+    };
+
+    struct Query {
+        std::string_view pattern{};
+        uint8_t kinds{KindMask::ALL};
+        Mode mode{Mode::AUTO};
+        size_t max_results{1000}; // 0 = unlimited
+    };
+
+    struct Result {
+        Kind kind{};
+        uint32_t index{}; // TDB index of the type, method or field
+        int32_t score{};
+
+        sdk::RETypeDefinition* get_type() const;
+        sdk::REMethodDefinition* get_method() const;
+        sdk::REField* get_field() const;
+
+        // The type itself for TYPE, the declaring type otherwise
+        sdk::RETypeDefinition* get_owner() const;
+
+        // Full name for types, Declaring.Type.member for members
+        std::string get_display_name() const;
+    };
+
+    // nullptr until the index has been built.
+    static std::shared_ptr<const TypeSearchIndex> get();
+
+    // Starts building on a background thread. Does nothing if already started or built.
+    static void build_async();
+
+    // Builds on the calling thread if nobody started a build yet, otherwise waits for it.
+    static std::shared_ptr<const TypeSearchIndex> wait();
+
+    // Results are ranked (best first) and replace the contents of out.
+    void search(const Query& query, std::vector<Result>& out) const;
+
+    // Same as search but only considers the given names (all of them if empty), see TypeSearchSession.
+    void search(const Query& query, std::span<const uint32_t> name_ids, std::vector<Result>& out) const;
+
+    // Appends every name (out of name_ids, or all names if empty) containing the
+    // characters of lower_pattern in order. Every match of any mode is in this set.
+    void filter_names(std::string_view lower_pattern, std::span<const uint32_t> name_ids, std::vector<uint32_t>& out) const;
+
+    size_t get_num_names() const { return m_names.size(); }
+    size_t get_num_entries() const { return m_entries.size(); }
+
+private:
+    struct Name {
+        uint32_t offset{};
+        uint32_t length{};
+        uint32_t first_entry{};
+        uint32_t num_entries{};
+    };
+
+    struct Entry {
+        Kind kind{};
+        uint32_t index{};
+    };
+
+    static std::unique_ptr<TypeSearchIndex> build();
+
+    std::string_view get_name(uint32_t name_id) const {
+        const auto& n = m_names[name_id];
+        return std::string_view{m_text.data() + n.offset, n.length};
+    }
+
+    // Returns false if every name is a candidate.
+    bool collect_candidates(std::string_view lower_pattern, Mode mode, std::vector<uint32_t>& out) const;
+    void rank(const Query& query, std::string_view lower_pattern, Mode mode, std::span<const uint32_t> name_ids, std::vector<Result>& out) const;
+
+    std::string m_text{};              // Lowercased names, back to back
+    std::vector<Name> m_names{};
+    std::vector<Entry> m_entries{};    // Grouped by name
+    std::vector<uint32_t> m_sorted{};  // Name ids in lexicographic order, for prefix queries
+
+    // Trigram -> name ids containing it, stored as CSR.
+    std::vector<uint32_t> m_trigrams{};
+    std::vector<uint32_t> m_trigram_offsets{};
+    std::vector<uint32_t> m_trigram_postings{};
+};
+
+// Search state for a text box. When the new pattern contains the previous one,
+// only the names that matched last time are considered again.
+class TypeSearchSession {
+public:
+    // Returns nullptr if the index isn't built yet (a build is started if needed).
+    const std::vector<TypeSearchIndex::Result>* update(const TypeSearchIndex::Query& query);
+
+    void reset() {
+        m_pattern.clear();
+        m_candidates.clear();
+        m_results.clear();
+    }
+
+private:
+    std::shared_ptr<const TypeSearchIndex> m_index{};
+    std::string m_pattern{};
+    std::vector<uint32_t> m_candidates{};
+    std::vector<uint32_t> m_scratch{};
+    std::vector<TypeSearchIndex::Result> m_results{};
+};
+} // namespace sdk
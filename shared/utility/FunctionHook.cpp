@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include <spdlog/spdlog.h>
 
 #include <safetyhook/inline_hook.hpp>
@@ -18,6 +20,10 @@ FunctionHook::~FunctionHook() {
 }
 
 bool FunctionHook::create() {
+    // Mods can be initialized in parallel, installing the hooks themselves is kept one at a time.
+    static std::mutex install_mutex{};
+
+    std::scoped_lock install_lock{ install_mutex };
     std::unique_lock _{ m_initialization_mutex };
 
     if (m_target == 0 || m_destination == 0 ) {
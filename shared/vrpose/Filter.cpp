@@ -0,0 +1,270 @@
+#include <numbers>
+
+#include "Filter.hpp"
+
+namespace vrpose {
+namespace detail {
+float one_euro_alpha(float cutoff, float dt) {
+    const auto tau = 1.0f / (2.0f * std::numbers::pi_v<float> * cutoff);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+PoseSample extrapolate(const PoseSample& pose, int64_t target_time_ns, const Settings& settings) {
+    auto out = pose;
+    out.time_ns = target_time_ns;
+
+    const auto dt = std::clamp((float)(target_time_ns - pose.time_ns) * 1e-9f, 0.0f, settings.max_prediction_ms * 1e-3f);
+
+    if (dt > 0.0f) {
+        out.position = pose.position + pose.velocity * dt;
+        out.orientation = (Quat::from_rotation_vector(pose.angular_velocity * dt) * pose.orientation).normalized();
+    }
+
+    return out;
+}
+}
+
+Vec3 OneEuroVec3::filter(const Vec3& value, float dt, const Settings& settings) {
+    if (!m_initialized) {
+        m_value = value;
+        m_derivative = {};
+        m_initialized = true;
+        return m_value;
+    }
+
+    if (dt <= 0.0f) {
+        return m_value;
+    }
+
+    const auto raw_derivative = (value - m_value) * (1.0f / dt);
+    m_derivative = lerp(m_derivative, raw_derivative, detail::one_euro_alpha(settings.d_cutoff, dt));
+
+    const auto cutoff = settings.min_cutoff + settings.beta * m_derivative.length();
+    m_value = lerp(m_value, value, detail::one_euro_alpha(cutoff, dt));
+
+    return m_value;
+}
+
+Quat OneEuroQuat::filter(const Quat& value, float dt, const Settings& settings) {
+    if (!m_initialized) {
+        m_value = value;
+        m_angular_velocity = {};
+        m_initialized = true;
+        return m_value;
+    }
+
+    if (dt <= 0.0f) {
+        return m_value;
+    }
+
+    const auto raw_angular_velocity = (value * m_value.conjugate()).to_rotation_vector() * (1.0f / dt);
+    m_angular_velocity = lerp(m_angular_velocity, raw_angular_velocity, detail::one_euro_alpha(settings.d_cutoff, dt));
+
+    const auto cutoff = settings.min_cutoff + settings.beta * m_angular_velocity.length();
+    m_value = slerp(m_value, value, detail::one_euro_alpha(cutoff, dt));
+
+    return m_value;
+}
+
+void KalmanVec3::predict(float dt, const Settings& settings) {
+    const auto q = settings.process_noise;
+    const auto dt2 = dt * dt;
+
+    for (auto& a : m_axes) {
+        a.p += a.v * dt;
+        a.pp += 2.0f * dt * a.pv + dt2 * a.vv + q * dt2 * dt2 * 0.25f;
+        a.pv += dt * a.vv + q * dt2 * dt * 0.5f;
+        a.vv += q * dt2;
+    }
+}
+
+void KalmanVec3::update_position(const Vec3& position, const Settings& settings) {
+    const std::array<float, 3> z{position.x, position.y, position.z};
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto& a = m_axes[i];
+        const auto s = a.pp + settings.measurement_noise;
+        const auto kp = a.pp / s;
+        const auto kv = a.pv / s;
+        const auto y = z[i] - a.p;
+
+        a.p += kp * y;
+        a.v += kv * y;
+        a.vv -= kv * a.pv;
+        a.pp *= 1.0f - kp;
+        a.pv *= 1.0f - kp;
+    }
+}
+
+void KalmanVec3::update_velocity(const Vec3& velocity, const Settings& settings) {
+    const std::array<float, 3> z{velocity.x, velocity.y, velocity.z};
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto& a = m_axes[i];
+        const auto s = a.vv + settings.velocity_measurement_noise;
+        const auto kp = a.pv / s;
+        const auto kv = a.vv / s;
+        const auto y = z[i] - a.v;
+
+        a.p += kp * y;
+        a.v += kv * y;
+        a.pp -= kp * a.pv;
+        a.pv *= 1.0f - kv;
+        a.vv *= 1.0f - kv;
+    }
+}
+
+void KalmanVec3::reset(const Vec3& position, const Vec3& velocity) {
+    m_axes[0] = Axis{position.x, velocity.x};
+    m_axes[1] = Axis{position.y, velocity.y};
+    m_axes[2] = Axis{position.z, velocity.z};
+}
+
+void DeviceProcessor::seed(const PoseSample& sample) {
+    m_position_filter.reset();
+    m_orientation_filter.reset();
+    m_position_filter.filter(sample.position, 0.0f, Settings{});
+    m_orientation_filter.filter(sample.orientation, 0.0f, Settings{});
+    m_kalman.reset(sample.position, sample.has_velocity ? sample.velocity : Vec3{});
+
+    m_last_input = sample;
+    m_last_output = sample;
+
+    if (!sample.has_velocity) {
+        m_last_output.velocity = {};
+        m_last_output.angular_velocity = {};
+    }
+
+    m_rejections = 0;
+    m_initialized = true;
+}
+
+PoseSample DeviceProcessor::process(const PoseSample& sample, int64_t target_time_ns, const Settings& settings) {
+    ++m_stats.samples;
+
+    if (!m_initialized) {
+        seed(sample);
+        return detail::extrapolate(m_last_output, target_time_ns, settings);
+    }
+
+    const auto dt = (float)(sample.time_ns - m_last_input.time_ns) * 1e-9f;
+
+    // Same sample as last time, nothing new to filter.
+    if (dt <= 0.0f) {
+        return detail::extrapolate(m_last_output, target_time_ns, settings);
+    }
+
+    if (settings.reject_outliers) {
+        // Against the last accepted sample rather than the filtered pose, so smoothing lag doesn't look like a glitch.
+        const auto speed = (sample.position - m_last_input.position).length() / dt;
+        const auto angular_speed = angle_between(sample.orientation, m_last_input.orientation) / dt;
+
+        if (speed > settings.max_speed || angular_speed > settings.max_angular_speed) {
+            if (++m_rejections <= settings.max_rejections) {
+                ++m_stats.rejected;
+                return detail::extrapolate(m_last_output, target_time_ns, settings);
+            }
+
+            // Not a glitch, the device really is somewhere else now (tracking regained, recenter...)
+            ++m_stats.resets;
+            seed(sample);
+            return detail::extrapolate(m_last_output, target_time_ns, settings);
+        }
+    }
+
+    m_rejections = 0;
+
+    PoseSample out{};
+    out.time_ns = sample.time_ns;
+    out.has_velocity = true;
+
+    switch (settings.smoothing) {
+    case Smoothing::ONE_EURO:
+        out.position = m_position_filter.filter(sample.position, dt, settings);
+        out.orientation = m_orientation_filter.filter(sample.orientation, dt, settings);
+        out.velocity = sample.has_velocity ? sample.velocity : m_position_filter.get_derivative();
+        out.angular_velocity = sample.has_velocity ? sample.angular_velocity : m_orientation_filter.get_angular_velocity();
+        break;
+
+    case Smoothing::KALMAN:
+        m_kalman.predict(dt, settings);
+        m_kalman.update_position(sample.position, settings);
+
+        if (sample.has_velocity) {
+            m_kalman.update_velocity(sample.velocity, settings);
+        }
+
+        out.position = m_kalman.get_position();
+        out.velocity = m_kalman.get_velocity();
+        out.orientation = m_orientation_filter.filter(sample.orientation, dt, settings);
+        out.angular_velocity = sample.has_velocity ? sample.angular_velocity : m_orientation_filter.get_angular_velocity();
+        break;
+
+    default:
+        out.position = sample.position;
+        out.orientation = sample.orientation;
+
+        if (sample.has_velocity) {
+            out.velocity = sample.velocity;
+            out.angular_velocity = sample.angular_velocity;
+        } else {
+            out.velocity = (sample.position - m_last_input.position) * (1.0f / dt);
+            out.angular_velocity = (sample.orientation * m_last_input.orientation.conjugate()).to_rotation_vector() * (1.0f / dt);
+        }
+
+        break;
+    }
+
+    m_last_input = sample;
+    m_last_output = out;
+
+    return detail::extrapolate(out, target_time_ns, settings);
+}
+
+void DeviceProcessor::reset() {
+    m_initialized = false;
+    m_rejections = 0;
+}
+
+PoseSample PoseProcessor::process(uint32_t device, const PoseSample& sample, int64_t target_time_ns) {
+    if (device >= m_devices.size()) {
+        m_devices.resize(device + 1);
+    }
+
+    return m_devices[device].process(sample, target_time_ns, m_settings);
+}
+
+void PoseProcessor::set_settings(const Settings& settings) {
+    const auto& s = m_settings;
+    const auto filter_changed = s.smoothing != settings.smoothing || s.min_cutoff != settings.min_cutoff || s.beta != settings.beta ||
+                                s.d_cutoff != settings.d_cutoff || s.process_noise != settings.process_noise ||
+                                s.measurement_noise != settings.measurement_noise ||
+                                s.velocity_measurement_noise != settings.velocity_measurement_noise ||
+                                s.reject_outliers != settings.reject_outliers;
+
+    m_settings = settings;
+
+    if (filter_changed) {
+        reset();
+    }
+}
+
+void PoseProcessor::reset() {
+    for (auto& device : m_devices) {
+        device.reset();
+    }
+}
+
+DeviceProcessor::Stats PoseProcessor::get_total_stats() const {
+    DeviceProcessor::Stats out{};
+
+    for (const auto& device : m_devices) {
+        const auto& stats = device.get_stats();
+        out.samples += stats.samples;
+        out.rejected += stats.rejected;
+        out.resets += stats.resets;
+    }
+
+    return out;
+}
+} // namespace vrpose
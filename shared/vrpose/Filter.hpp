@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Pose.hpp"
+
+namespace vrpose {
+enum class Smoothing : uint8_t {
+    NONE,
+    ONE_EURO,
+    KALMAN, // Constant velocity Kalman filter on position, One-Euro on orientation
+};
+
+struct Settings {
+    Smoothing smoothing{Smoothing::NONE};
+
+    // How far past the sample time the output is extrapolated when no target time is given.
+    // Extrapolation never goes further than max_prediction_ms.
+    float prediction_ms{0.0f};
+    float max_prediction_ms{50.0f};
+
+    // One-Euro
+    float min_cutoff{1.0f}; // Hz, lower = smoother at rest
+    float beta{10.0f};      // Higher = less lag when moving fast
+    float d_cutoff{1.0f};   // Hz, for the speed estimate
+
+    // Kalman, in meters
+    float process_noise{50.0f};          // Acceleration variance
+    float measurement_noise{1e-6f};      // Position variance
+    float velocity_measurement_noise{1e-3f};
+
+    // Samples implying a speed above these are treated as tracking glitches and replaced by the prediction,
+    // until max_rejections of them in a row make the filter snap to the new pose.
+    bool reject_outliers{true};
+    float max_speed{10.0f};         // m/s
+    float max_angular_speed{60.0f}; // rad/s
+    uint32_t max_rejections{5};
+};
+
+class OneEuroVec3 {
+public:
+    Vec3 filter(const Vec3& value, float dt, const Settings& settings);
+    void reset() { m_initialized = false; }
+
+    const Vec3& get_value() const { return m_value; }
+    const Vec3& get_derivative() const { return m_derivative; }
+
+private:
+    Vec3 m_value{};
+    Vec3 m_derivative{};
+    bool m_initialized{false};
+};
+
+class OneEuroQuat {
+public:
+    Quat filter(const Quat& value, float dt, const Settings& settings);
+    void reset() { m_initialized = false; }
+
+    const Quat& get_value() const { return m_value; }
+    const Vec3& get_angular_velocity() const { return m_angular_velocity; }
+
+private:
+    Quat m_value{};
+    Vec3 m_angular_velocity{};
+    bool m_initialized{false};
+};
+
+// Independent constant velocity filter per axis.
+class KalmanVec3 {
+public:
+    void predict(float dt, const Settings& settings);
+    void update_position(const Vec3& position, const Settings& settings);
+    void update_velocity(const Vec3& velocity, const Settings& settings);
+    void reset(const Vec3& position, const Vec3& velocity);
+
+    Vec3 get_position() const { return {m_axes[0].p, m_axes[1].p, m_axes[2].p}; }
+    Vec3 get_velocity() const { return {m_axes[0].v, m_axes[1].v, m_axes[2].v}; }
+
+private:
+    struct Axis {
+        float p{}, v{};
+        float pp{1.0f}, pv{0.0f}, vv{1.0f}; // Covariance
+    };
+
+    std::array<Axis, 3> m_axes{};
+};
+
+// Filters and predicts the samples of one tracked device. No allocations, meant to run once per pose update.
+class DeviceProcessor {
+public:
+    struct Stats {
+        uint64_t samples{};
+        uint64_t rejected{};
+        uint64_t resets{};
+    };
+
+    // Returns the filtered pose extrapolated to target_time_ns (time_ns of the result is set to it).
+    PoseSample process(const PoseSample& sample, int64_t target_time_ns, const Settings& settings);
+    void reset();
+
+    const Stats& get_stats() const { return m_stats; }
+
+private:
+    void seed(const PoseSample& sample);
+
+    OneEuroVec3 m_position_filter{};
+    OneEuroQuat m_orientation_filter{};
+    KalmanVec3 m_kalman{};
+
+    PoseSample m_last_input{};
+    PoseSample m_last_output{}; // Filtered, at the time of the last accepted sample
+    uint32_t m_rejections{};
+    bool m_initialized{false};
+    Stats m_stats{};
+};
+
+// Per device state for everything a runtime tracks. Not thread safe, the owner serializes access.
+class PoseProcessor {
+public:
+    PoseSample process(uint32_t device, const PoseSample& sample, int64_t target_time_ns);
+
+    // Predicts prediction_ms past the sample.
+    PoseSample process(uint32_t device, const PoseSample& sample) {
+        return process(device, sample, sample.time_ns + (int64_t)(m_settings.prediction_ms * 1'000'000.0f));
+    }
+
+    // Resets all filter state if anything but the prediction changed.
+    void set_settings(const Settings& settings);
+    const Settings& get_settings() const { return m_settings; }
+
+    void reset();
+
+    DeviceProcessor::Stats get_total_stats() const;
+
+private:
+    Settings m_settings{};
+    std::vector<DeviceProcessor> m_devices{};
+};
+} // namespace vrpose
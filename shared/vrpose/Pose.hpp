@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Just enough vector/quaternion math for pose filtering, so this library can be built and
+// replayed anywhere without the game side's dependencies.
+namespace vrpose {
+struct Vec3 {
+    float x{}, y{}, z{};
+
+    Vec3 operator+(const Vec3& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3 operator-(const Vec3& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3 operator*(float s) const { return {x * s, y * s, z * s}; }
+
+    float dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+    float length() const { return std::sqrt(dot(*this)); }
+};
+
+inline Vec3 lerp(const Vec3& a, const Vec3& b, float t) {
+    return a + (b - a) * t;
+}
+
+struct Quat {
+    float x{}, y{}, z{}, w{1.0f};
+
+    Quat operator*(const Quat& o) const {
+        return {
+            w * o.x + x * o.w + y * o.z - z * o.y,
+            w * o.y - x * o.z + y * o.w + z * o.x,
+            w * o.z + x * o.y - y * o.x + z * o.w,
+            w * o.w - x * o.x - y * o.y - z * o.z,
+        };
+    }
+
+    float dot(const Quat& o) const { return x * o.x + y * o.y + z * o.z + w * o.w; }
+    Quat conjugate() const { return {-x, -y, -z, w}; }
+
+    Quat normalized() const {
+        const auto len = std::sqrt(dot(*this));
+
+        if (len <= 0.0f) {
+            return {};
+        }
+
+        return {x / len, y / len, z / len, w / len};
+    }
+
+    // Rotation of angle |v| radians around v.
+    static Quat from_rotation_vector(const Vec3& v) {
+        const auto angle = v.length();
+
+        if (angle < 1e-8f) {
+            return Quat{v.x * 0.5f, v.y * 0.5f, v.z * 0.5f, 1.0f}.normalized();
+        }
+
+        const auto s = std::sin(angle * 0.5f) / angle;
+        return {v.x * s, v.y * s, v.z * s, std::cos(angle * 0.5f)};
+    }
+
+    // Inverse of from_rotation_vector, picking the short way around.
+    Vec3 to_rotation_vector() const {
+        auto q = w < 0.0f ? Quat{-x, -y, -z, -w} : *this;
+        const auto s = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+
+        if (s < 1e-8f) {
+            return Vec3{q.x, q.y, q.z} * 2.0f;
+        }
+
+        const auto angle = 2.0f * std::atan2(s, q.w);
+        return Vec3{q.x, q.y, q.z} * (angle / s);
+    }
+};
+
+// Smallest angle in radians between two orientations.
+inline float angle_between(const Quat& a, const Quat& b) {
+    const auto d = std::min(std::abs(a.dot(b)), 1.0f);
+    return 2.0f * std::acos(d);
+}
+
+inline Quat slerp(const Quat& a, Quat b, float t) {
+    auto d = a.dot(b);
+
+    if (d < 0.0f) {
+        b = Quat{-b.x, -b.y, -b.z, -b.w};
+        d = -d;
+    }
+
+    if (d > 0.9995f) {
+        return Quat{a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t}.normalized();
+    }
+
+    const auto theta = std::acos(d);
+    const auto sin_theta = std::sin(theta);
+    const auto wa = std::sin((1.0f - t) * theta) / sin_theta;
+    const auto wb = std::sin(t * theta) / sin_theta;
+
+    return {a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb};
+}
+
+// Everything is in the tracking space of the runtime, velocities are per second and angular velocity is in radians.
+struct PoseSample {
+    int64_t time_ns{};
+    Vec3 position{};
+    Quat orientation{};
+    Vec3 velocity{};
+    Vec3 angular_velocity{};
+    bool has_velocity{false}; // false when the runtime doesn't report velocities for the device (OpenXR HMD)
+};
+} // namespace vrpose
@@ -0,0 +1,187 @@
+#include <cstring>
+
+#include "Recorder.hpp"
+
+namespace vrpose {
+namespace detail {
+constexpr uint32_t RECORDING_MAGIC = 0x53505256; // "VRPS"
+constexpr uint32_t RECORDING_VERSION = 1;
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+// device, time, position, orientation, velocity, angular velocity, flags
+constexpr size_t RECORD_SIZE = sizeof(uint32_t) + sizeof(int64_t) + sizeof(float) * 13 + sizeof(uint8_t);
+
+template <typename T>
+void append(std::vector<uint8_t>& buffer, const T& value) {
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T take(const uint8_t*& data) {
+    T out{};
+    memcpy(&out, data, sizeof(T));
+    data += sizeof(T);
+    return out;
+}
+
+void serialize(std::vector<uint8_t>& buffer, uint32_t device, const PoseSample& s) {
+    append(buffer, device);
+    append(buffer, s.time_ns);
+
+    for (const auto v : {s.position.x, s.position.y, s.position.z,
+                         s.orientation.x, s.orientation.y, s.orientation.z, s.orientation.w,
+                         s.velocity.x, s.velocity.y, s.velocity.z,
+                         s.angular_velocity.x, s.angular_velocity.y, s.angular_velocity.z})
+    {
+        append(buffer, v);
+    }
+
+    append(buffer, (uint8_t)(s.has_velocity ? 1 : 0));
+}
+
+RecordedSample deserialize(const uint8_t* data) {
+    RecordedSample out{};
+    auto& s = out.sample;
+
+    out.device = take<uint32_t>(data);
+    s.time_ns = take<int64_t>(data);
+
+    for (auto v : {&s.position.x, &s.position.y, &s.position.z,
+                   &s.orientation.x, &s.orientation.y, &s.orientation.z, &s.orientation.w,
+                   &s.velocity.x, &s.velocity.y, &s.velocity.z,
+                   &s.angular_velocity.x, &s.angular_velocity.y, &s.angular_velocity.z})
+    {
+        *v = take<float>(data);
+    }
+
+    s.has_velocity = take<uint8_t>(data) != 0;
+
+    return out;
+}
+
+void set_error(std::string* error, std::string message) {
+    if (error != nullptr) {
+        *error = std::move(message);
+    }
+}
+}
+
+bool Recorder::open(const std::filesystem::path& path) {
+    std::scoped_lock _{m_mtx};
+
+    if (m_open) {
+        flush();
+        m_stream.close();
+    }
+
+    m_stream.open(path, std::ios::binary | std::ios::trunc);
+
+    if (!m_stream) {
+        m_open = false;
+        return false;
+    }
+
+    m_buffer.clear();
+    m_buffer.reserve(detail::FLUSH_THRESHOLD + detail::RECORD_SIZE);
+    detail::append(m_buffer, detail::RECORDING_MAGIC);
+    detail::append(m_buffer, detail::RECORDING_VERSION);
+
+    m_sample_count = 0;
+    m_open = true;
+
+    return true;
+}
+
+void Recorder::close() {
+    std::scoped_lock _{m_mtx};
+
+    if (!m_open) {
+        return;
+    }
+
+    flush();
+    m_stream.close();
+    m_open = false;
+}
+
+void Recorder::record(uint32_t device, const PoseSample& sample) {
+    if (!m_open) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (!m_open) {
+        return;
+    }
+
+    detail::serialize(m_buffer, device, sample);
+    ++m_sample_count;
+
+    if (m_buffer.size() >= detail::FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void Recorder::flush() {
+    m_stream.write((const char*)m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+
+bool load_recording(const std::filesystem::path& path, std::vector<RecordedSample>& out, std::string* error) {
+    std::ifstream stream{path, std::ios::binary};
+
+    if (!stream) {
+        detail::set_error(error, "Failed to open " + path.string());
+        return false;
+    }
+
+    const std::vector<uint8_t> data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+    if (data.size() < sizeof(uint32_t) * 2) {
+        detail::set_error(error, "Recording is too small");
+        return false;
+    }
+
+    const uint8_t* ptr = data.data();
+    const auto magic = detail::take<uint32_t>(ptr);
+    const auto version = detail::take<uint32_t>(ptr);
+
+    if (magic != detail::RECORDING_MAGIC || version != detail::RECORDING_VERSION) {
+        detail::set_error(error, "Not a pose recording or unsupported recording version");
+        return false;
+    }
+
+    const auto count = (data.size() - sizeof(uint32_t) * 2) / detail::RECORD_SIZE;
+    out.reserve(out.size() + count);
+
+    // A recording cut short (game closed while recording) just loses its last partial record.
+    for (size_t i = 0; i < count; ++i, ptr += detail::RECORD_SIZE) {
+        out.push_back(detail::deserialize(ptr));
+    }
+
+    return true;
+}
+
+bool save_recording(const std::filesystem::path& path, const std::vector<RecordedSample>& samples) {
+    std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+
+    if (!stream) {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer{};
+    buffer.reserve(sizeof(uint32_t) * 2 + samples.size() * detail::RECORD_SIZE);
+    detail::append(buffer, detail::RECORDING_MAGIC);
+    detail::append(buffer, detail::RECORDING_VERSION);
+
+    for (const auto& s : samples) {
+        detail::serialize(buffer, s.device, s.sample);
+    }
+
+    stream.write((const char*)buffer.data(), buffer.size());
+    return (bool)stream;
+}
+} // namespace vrpose
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Pose.hpp"
+
+namespace vrpose {
+struct RecordedSample {
+    uint32_t device{};
+    PoseSample sample{};
+};
+
+// Streams raw samples to a .vrpose file so they can be replayed through the filters offline.
+// record() only appends to a buffer that gets written out every few thousand samples.
+class Recorder {
+public:
+    ~Recorder() {
+        close();
+    }
+
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    bool is_open() const {
+        return m_open;
+    }
+
+    void record(uint32_t device, const PoseSample& sample);
+
+    uint64_t get_sample_count() const {
+        return m_sample_count;
+    }
+
+private:
+    void flush();
+
+    std::mutex m_mtx{};
+    std::ofstream m_stream{};
+    std::vector<uint8_t> m_buffer{};
+    std::atomic<uint64_t> m_sample_count{0};
+    std::atomic<bool> m_open{false};
+};
+
+bool load_recording(const std::filesystem::path& path, std::vector<RecordedSample>& out, std::string* error = nullptr);
+bool save_recording(const std::filesystem::path& path, const std::vector<RecordedSample>& samples);
+} // namespace vrpose
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+
+#include "Replay.hpp"
+
+namespace vrpose {
+ReplayResult replay(const std::vector<RecordedSample>& samples, const Settings& settings, float horizon_ms) {
+    ReplayResult result{};
+
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::vector<uint32_t> order(samples.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (samples[a].device != samples[b].device) {
+            return samples[a].device < samples[b].device;
+        }
+
+        return samples[a].sample.time_ns < samples[b].sample.time_ns;
+    });
+
+    const auto horizon_ns = (int64_t)(horizon_ms * 1'000'000.0f);
+
+    // Process everything first so the timing doesn't include the evaluation.
+    PoseProcessor processor{};
+    processor.set_settings(settings);
+
+    std::vector<PoseSample> outputs(samples.size());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto& s = samples[order[i]];
+        outputs[i] = processor.process(s.device, s.sample, s.sample.time_ns + horizon_ns);
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    result.ns_per_sample = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)samples.size();
+    result.stats = processor.get_total_stats();
+
+    double position_error_sum{}, position_error_sq_sum{}, angle_error_sum{}, jitter_sum{};
+    uint64_t jitter_count{};
+
+    for (size_t begin = 0; begin < order.size();) {
+        const auto device = samples[order[begin]].device;
+        auto end = begin;
+
+        while (end < order.size() && samples[order[end]].device == device) {
+            ++end;
+        }
+
+        auto truth = begin;
+
+        for (auto i = begin; i < end; ++i) {
+            const auto target = samples[order[i]].sample.time_ns + horizon_ns;
+
+            while (truth < end && samples[order[truth]].sample.time_ns < target) {
+                ++truth;
+            }
+
+            if (i >= begin + 2) {
+                const auto d2 = outputs[i].position - outputs[i - 1].position * 2.0f + outputs[i - 2].position;
+                jitter_sum += d2.length();
+                ++jitter_count;
+            }
+
+            if (truth >= end) {
+                continue;
+            }
+
+            const auto& b = samples[order[truth]].sample;
+            auto expected_position = b.position;
+            auto expected_orientation = b.orientation;
+
+            if (truth > begin && b.time_ns != target) {
+                const auto& a = samples[order[truth - 1]].sample;
+                const auto t = (float)(target - a.time_ns) / (float)(b.time_ns - a.time_ns);
+
+                expected_position = lerp(a.position, b.position, t);
+                expected_orientation = slerp(a.orientation, b.orientation, t);
+            }
+
+            const auto position_error = (double)(outputs[i].position - expected_position).length();
+            const auto angle_error = (double)angle_between(outputs[i].orientation, expected_orientation);
+
+            position_error_sum += position_error;
+            position_error_sq_sum += position_error * position_error;
+            angle_error_sum += angle_error;
+            result.max_position_error = std::max(result.max_position_error, position_error);
+            result.max_angle_error = std::max(result.max_angle_error, angle_error);
+            ++result.samples;
+        }
+
+        begin = end;
+    }
+
+    if (result.samples > 0) {
+        result.mean_position_error = position_error_sum / (double)result.samples;
+        result.rms_position_error = std::sqrt(position_error_sq_sum / (double)result.samples);
+        result.mean_angle_error = angle_error_sum / (double)result.samples;
+    }
+
+    if (jitter_count > 0) {
+        result.jitter = jitter_sum / (double)jitter_count;
+    }
+
+    return result;
+}
+
+std::vector<RecordedSample> generate_recording(const GenerateOptions& options) {
+    std::vector<RecordedSample> out{};
+
+    if (options.rate_hz <= 0.0f || options.seconds <= 0.0f) {
+        return out;
+    }
+
+    std::mt19937 rng{options.seed};
+    std::normal_distribution<float> noise{0.0f, options.noise_mm * 0.001f};
+    std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+
+    const auto count = (size_t)(options.seconds * options.rate_hz);
+    const auto period_ns = (int64_t)(1e9 / options.rate_hz);
+
+    out.reserve(count * options.devices);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto time_ns = (int64_t)i * period_ns;
+        const auto t = (float)time_ns * 1e-9f;
+
+        for (uint32_t device = 0; device < options.devices; ++device) {
+            // Slow head motion, faster and bigger swings for the hands.
+            const auto amplitude = device == 0 ? 0.05f : 0.3f;
+            const auto frequency = device == 0 ? 0.4f : 1.1f + 0.3f * (float)device;
+            const auto w = 2.0f * 3.14159265f * frequency;
+            const auto phase = (float)device;
+
+            RecordedSample s{};
+            s.device = device;
+            s.sample.time_ns = time_ns;
+
+            // Lissajous figure around a rest position
+            const Vec3 rest{device == 2 ? 0.2f : (device == 1 ? -0.2f : 0.0f), device == 0 ? 1.7f : 1.2f, -0.3f * (device != 0 ? 1.0f : 0.0f)};
+            s.sample.position = rest + Vec3{amplitude * std::sin(w * t + phase), amplitude * 0.5f * std::sin(2.0f * w * t), amplitude * 0.7f * std::cos(w * t)};
+            s.sample.velocity = Vec3{amplitude * w * std::cos(w * t + phase), amplitude * w * std::cos(2.0f * w * t), -amplitude * 0.7f * w * std::sin(w * t)};
+
+            // Yaw/pitch oscillation
+            const auto yaw_amplitude = device == 0 ? 0.6f : 1.2f;
+            const auto yaw_rate = yaw_amplitude * w * std::cos(w * t);
+            const auto yaw = Quat::from_rotation_vector(Vec3{0.0f, yaw_amplitude * std::sin(w * t), 0.0f});
+            const auto pitch = Quat::from_rotation_vector(Vec3{0.2f * std::sin(0.5f * w * t), 0.0f, 0.0f});
+            s.sample.orientation = (yaw * pitch).normalized();
+
+            // Approximate, ignores the pitch's contribution
+            s.sample.angular_velocity = Vec3{0.0f, yaw_rate, 0.0f};
+            s.sample.has_velocity = device != 0;
+
+            if (!s.sample.has_velocity) {
+                s.sample.velocity = {};
+                s.sample.angular_velocity = {};
+            }
+
+            s.sample.position = s.sample.position + Vec3{noise(rng), noise(rng), noise(rng)};
+
+            if (options.outlier_rate > 0.0f && unit(rng) < options.outlier_rate) {
+                s.sample.position = s.sample.position + Vec3{0.5f, -0.3f, 0.4f};
+            }
+
+            out.push_back(s);
+        }
+    }
+
+    return out;
+}
+} // namespace vrpose
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Filter.hpp"
+#include "Recorder.hpp"
+
+namespace vrpose {
+struct ReplayResult {
+    uint64_t samples{};   // Samples that had something to compare against
+    double mean_position_error{}; // Meters
+    double rms_position_error{};
+    double max_position_error{};
+    double mean_angle_error{}; // Radians
+    double max_angle_error{};
+    double jitter{}; // Mean length of the second difference of the output positions, meters
+    double ns_per_sample{};
+    DeviceProcessor::Stats stats{};
+};
+
+// Runs each device's samples through a fresh PoseProcessor, predicting horizon_ms past every sample,
+// and compares the output to the recording itself interpolated at that time.
+// Recorded noise ends up in the error of every configuration equally, so results are meant to be compared
+// against each other (e.g. against settings with no smoothing and no prediction), not read as absolute accuracy.
+ReplayResult replay(const std::vector<RecordedSample>& samples, const Settings& settings, float horizon_ms);
+
+struct GenerateOptions {
+    float seconds{60.0f};
+    float rate_hz{90.0f};
+    float noise_mm{0.5f};
+    float outlier_rate{0.001f}; // Fraction of samples replaced by a tracking glitch
+    uint32_t devices{3};
+    uint32_t seed{1};
+};
+
+// Synthetic head and hand motion for exercising the filters without a recording.
+// Device 0 reports no velocities, like the OpenXR HMD.
+std::vector<RecordedSample> generate_recording(const GenerateOptions& options);
+} // namespace vrpose
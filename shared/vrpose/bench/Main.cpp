@@ -0,0 +1,106 @@
+// Replays a pose recording through every filter configuration and reports prediction error, jitter and cost.
+// Usage: vrpose_bench <recording.vrpose> [horizon_ms]
+//        vrpose_bench --generate <out.vrpose> [seconds] [noise_mm]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <vrpose/Replay.hpp>
+
+namespace {
+void print_result(const char* name, const vrpose::ReplayResult& r) {
+    constexpr auto RAD_TO_DEG = 57.2957795;
+
+    std::printf("%-22s  pos mean %6.2fmm rms %6.2fmm max %8.2fmm  ang mean %6.3fdeg max %7.3fdeg  jitter %6.3fmm  %6.1fns/sample  %llu rejected %llu resets\n",
+        name, r.mean_position_error * 1000.0, r.rms_position_error * 1000.0, r.max_position_error * 1000.0,
+        r.mean_angle_error * RAD_TO_DEG, r.max_angle_error * RAD_TO_DEG, r.jitter * 1000.0, r.ns_per_sample,
+        (unsigned long long)r.stats.rejected, (unsigned long long)r.stats.resets);
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("Usage: %s <recording.vrpose> [horizon_ms]\n", argv[0]);
+        std::printf("       %s --generate <out.vrpose> [seconds] [noise_mm]\n", argv[0]);
+        return 1;
+    }
+
+    if (std::strcmp(argv[1], "--generate") == 0) {
+        if (argc < 3) {
+            std::printf("Missing output path\n");
+            return 1;
+        }
+
+        vrpose::GenerateOptions options{};
+
+        if (argc > 3) {
+            options.seconds = (float)std::atof(argv[3]);
+        }
+
+        if (argc > 4) {
+            options.noise_mm = (float)std::atof(argv[4]);
+        }
+
+        const auto samples = vrpose::generate_recording(options);
+
+        if (!vrpose::save_recording(argv[2], samples)) {
+            std::printf("Failed to write %s\n", argv[2]);
+            return 1;
+        }
+
+        std::printf("Wrote %zu samples to %s\n", samples.size(), argv[2]);
+        return 0;
+    }
+
+    std::vector<vrpose::RecordedSample> samples{};
+    std::string error{};
+
+    if (!vrpose::load_recording(argv[1], samples, &error)) {
+        std::printf("Failed to load recording: %s\n", error.c_str());
+        return 1;
+    }
+
+    const auto horizon_ms = argc > 2 ? (float)std::atof(argv[2]) : 20.0f;
+
+    std::printf("Loaded %zu samples, predicting %.1fms ahead\n", samples.size(), horizon_ms);
+
+    struct Config {
+        const char* name;
+        vrpose::Settings settings;
+        float horizon_ms;
+    };
+
+    vrpose::Settings raw{};
+    raw.reject_outliers = false;
+
+    auto predicted = raw;
+    auto rejecting = raw;
+    rejecting.reject_outliers = true;
+
+    auto one_euro = rejecting;
+    one_euro.smoothing = vrpose::Smoothing::ONE_EURO;
+
+    auto kalman = rejecting;
+    kalman.smoothing = vrpose::Smoothing::KALMAN;
+
+    // "raw" doesn't predict at all: the error it shows is what using the sample as is costs at this latency.
+    const std::vector<Config> configs{
+        {"raw", raw, 0.0f},
+        {"predict", predicted, horizon_ms},
+        {"predict+reject", rejecting, horizon_ms},
+        {"one-euro+predict", one_euro, horizon_ms},
+        {"kalman+predict", kalman, horizon_ms},
+    };
+
+    for (const auto& config : configs) {
+        // The output is always compared horizon_ms past the sample, only the prediction amount changes.
+        auto settings = config.settings;
+        settings.max_prediction_ms = config.horizon_ms;
+
+        print_result(config.name, vrpose::replay(samples, settings, horizon_ms));
+    }
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <windows.h>
 #include <DbgHelp.h>
 #include <ShlObj.h>
+#include <array>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 
@@ -10,6 +11,8 @@
 
 #include "utility/Exceptions.hpp"
 
+#include <sdk/MethodIndex.hpp>
+
 #include "REFramework.hpp"
 #include "ExceptionHandler.hpp"
 
@@ -47,6 +50,40 @@ LONG WINAPI reframework::global_exception_handler(struct _EXCEPTION_POINTERS* ei
 
     utility::exceptions::dump_callstack(ei);
 
+    // Game code has no symbols, so name the managed methods we were in using the TDB.
+    // Names are formatted on the stack, the crash may have happened with the heap or a TDB cache locked.
+    if (const auto method_index = sdk::MethodAddressIndex::get(); method_index != nullptr) {
+        std::array<char, 512> symbol_name{};
+
+        if (const auto symbol = method_index->find(ei->ContextRecord->Rip); symbol) {
+            spdlog::error("Method: {}", symbol->format(symbol_name));
+        }
+
+        ULONG_PTR stack_low{}, stack_high{};
+        GetCurrentThreadStackLimits(&stack_low, &stack_high);
+
+        const auto rsp = (uintptr_t)ei->ContextRecord->Rsp;
+
+        if (rsp >= stack_low && rsp < stack_high) {
+            constexpr size_t MAX_STACK_SLOTS = 1024;
+            constexpr size_t MAX_STACK_METHODS = 32;
+            size_t num_found = 0;
+
+            // Anything on the stack that lands inside a method is likely a return address.
+            for (auto slot = (uintptr_t*)rsp; (uintptr_t)(slot + 1) <= stack_high && slot < (uintptr_t*)rsp + MAX_STACK_SLOTS; ++slot) {
+                const auto symbol = method_index->find(*slot);
+
+                if (symbol && symbol->offset != 0) {
+                    spdlog::error("Stack+0x{:x}: {} ({:x})", (uintptr_t)slot - rsp, symbol->format(symbol_name), *slot);
+
+                    if (++num_found >= MAX_STACK_METHODS) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     const auto module_within = utility::get_module_within(ei->ContextRecord->Rip);
 
     if (module_within) {
@@ -4,11 +4,15 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
 #include <climits>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -17,9 +21,11 @@
 #include <stack>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace genny {
@@ -159,6 +165,17 @@ public:
         }
     }
 
+    // Same as above but in tree order, for anything that ends up in generated output.
+    template <typename T> void get_all_in_children(std::vector<T*>& objects) const {
+        if (is_a<T>()) {
+            objects.emplace_back((T*)this);
+        }
+
+        for (auto&& child : m_children) {
+            child->get_all_in_children(objects);
+        }
+    }
+
     template <typename T> bool has_any() const {
         return std::any_of(m_children.cbegin(), m_children.cend(), [](const auto& child) { return child->is_a<T>(); });
     }
@@ -1269,11 +1286,132 @@ public:
         return this;
     }
 
-    void generate(const std::filesystem::path& sdk_path) const {
-        // erase the file_list.txt
-        std::filesystem::remove(sdk_path / "file_list.txt");
+    struct GenerateStats {
+        size_t written{};   // New or changed files
+        size_t unchanged{}; // Identical to what the manifest says is already on disk
+        size_t removed{};   // Listed in the previous manifest but no longer generated
+    };
+
+    // Generates every header (and source) under sdk_path. Each file's content is hashed and compared against
+    // the manifest left by the previous run, files that didn't change aren't rewritten (so their timestamps
+    // don't invalidate anything that includes them) and files of types that no longer exist are deleted.
+    // Files are rendered and written on num_threads workers (hardware concurrency if 0).
+    GenerateStats generate(const std::filesystem::path& sdk_path, uint32_t num_threads = 0) const {
+        std::vector<std::variant<Enum*, Struct*>> objects{};
+        collect_namespace(m_global_ns.get(), objects);
+
+        const auto old_manifest = load_manifest(sdk_path);
+
+        // Generated relative paths and hashes, per object so the file list keeps the tree's order.
+        std::vector<std::vector<std::pair<std::filesystem::path, uint64_t>>> outputs(objects.size());
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> written{0};
+        std::atomic<size_t> unchanged{0};
+
+        const auto emit = [&](std::vector<std::pair<std::filesystem::path, uint64_t>>& out, const std::filesystem::path& rel_path,
+                              const std::string& content) {
+            const auto hash = hash_content(content);
+            const auto path = sdk_path / rel_path;
+            const auto it = old_manifest.find(rel_path.generic_string());
+
+            out.emplace_back(rel_path, hash);
+
+            if (it != old_manifest.end() && it->second == hash && std::filesystem::exists(path)) {
+                ++unchanged;
+                return;
+            }
+
+            // Workers race to create shared directories, which is fine.
+            std::error_code ec{};
+            std::filesystem::create_directories(path.parent_path(), ec);
+            std::ofstream{path, std::ios::binary | std::ios::trunc}.write(content.data(), content.size());
+            ++written;
+        };
+
+        // Objects whose paths only differ by case end up in the same file on Windows, each group goes to a
+        // single worker so they're written one after the other (last one wins) instead of concurrently.
+        std::vector<std::vector<size_t>> groups{};
+        {
+            std::unordered_map<std::string, size_t> group_of_path{};
+
+            for (size_t i = 0; i < objects.size(); ++i) {
+                auto key = std::visit([&](auto obj) { return path_for_object(obj).generic_string(); }, objects[i]);
+                std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+                auto [it, inserted] = group_of_path.try_emplace(std::move(key), groups.size());
+
+                if (inserted) {
+                    groups.emplace_back();
+                }
+
+                groups[it->second].emplace_back(i);
+            }
+        }
+
+        const auto worker = [&] {
+            std::ostringstream os{};
+
+            for (auto g = next.fetch_add(1); g < groups.size(); g = next.fetch_add(1)) {
+                for (auto i : groups[g]) {
+                    std::visit(
+                        [&](auto obj) {
+                            auto& out = outputs[i];
+
+                            os.str("");
+                            generate_header(os, obj);
+                            emit(out, include_path_for_object(obj), os.str());
+
+                            if (should_generate_source(obj)) {
+                                os.str("");
+                                generate_source(os, obj);
+                                emit(out, source_path_for_object(obj), os.str());
+                            }
+                        },
+                        objects[i]);
+                }
+            }
+        };
+
+        if (num_threads == 0) {
+            num_threads = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        std::vector<std::thread> threads{};
+
+        for (uint32_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto&& t : threads) {
+            t.join();
+        }
+
+        GenerateStats stats{written.load(), unchanged.load(), 0};
+        std::unordered_set<std::string> generated{};
+        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::trunc};
+        std::ofstream manifest{sdk_path / "manifest.txt", std::ios::trunc};
+
+        for (auto&& out : outputs) {
+            for (auto&& [rel_path, hash] : out) {
+                file_list << "\"" << (sdk_path / rel_path).string() << "\" \\\n";
+                manifest << std::hex << std::setw(16) << std::setfill('0') << hash << " " << rel_path.generic_string() << "\n";
+                generated.emplace(rel_path.generic_string());
+            }
+        }
+
+        for (auto&& [rel_path, _] : old_manifest) {
+            if (!generated.contains(rel_path)) {
+                std::error_code ec{};
+
+                if (std::filesystem::remove(sdk_path / rel_path, ec)) {
+                    ++stats.removed;
+                }
+            }
+        }
 
-        generate_namespace(sdk_path, m_global_ns.get());
+        return stats;
     }
 
     const auto& header_extension() const { return m_header_extension; }
@@ -1342,13 +1480,39 @@ protected:
         return rel_path;
     }
 
-    template <typename T> void generate_header(const std::filesystem::path& sdk_path, T* obj) const {
-        auto obj_inc_path = sdk_path / include_path_for_object(obj);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
-        file_list << "\"" << obj_inc_path.string() << "\" \\\n";
-        std::filesystem::create_directories(obj_inc_path.parent_path());
-        std::ofstream os{obj_inc_path};
+    // The type sets are keyed by pointer, so sort before writing anything out or the output (and its manifest
+    // hash) changes every time the tree is rebuilt.
+    std::vector<std::pair<std::filesystem::path, Type*>> sorted_includes(Object* from, const std::unordered_set<Type*>& types) const {
+        std::vector<std::pair<std::filesystem::path, Type*>> out{};
+        out.reserve(types.size());
 
+        for (auto&& type : types) {
+            out.emplace_back(include_path(from, type), type);
+        }
+
+        std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        return out;
+    }
+
+    static std::string full_name(Object* obj) {
+        std::string name{};
+        auto owners = obj->owners<Object>();
+
+        std::reverse(owners.begin(), owners.end());
+
+        for (auto&& owner : owners) {
+            if (owner->name().empty()) {
+                continue;
+            }
+
+            name += owner->name();
+            name += "::";
+        }
+
+        return name + obj->name();
+    }
+
+    template <typename T> void generate_header(std::ostream& os, T* obj) const {
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
             std::string line{};
@@ -1446,11 +1610,19 @@ protected:
             }
         }
 
-        for (auto&& type : types_to_include) {
-            os << "#include \"" << include_path(obj, type).string() << "\"\n";
+        for (auto&& [path, _] : sorted_includes(obj, types_to_include)) {
+            os << "#include \"" << path.string() << "\"\n";
         }
 
+        std::vector<std::pair<std::string, Struct*>> forward_decls{};
+
         for (auto&& type : structs_to_forward_decl) {
+            forward_decls.emplace_back(full_name(type), type);
+        }
+
+        std::sort(forward_decls.begin(), forward_decls.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (auto&& [_, type] : forward_decls) {
             // Only forward decl structs we haven't already included.
             if (types_to_include.find(type) == types_to_include.end() && !type->is_child_of(obj)) {
                 auto owners = type->owners<Namespace>();
@@ -1523,33 +1695,23 @@ protected:
         }
     }
 
-    template <typename T> void generate_source(const std::filesystem::path& sdk_path, T* obj) const {
+    template <typename T> bool should_generate_source(T* obj) const {
         // Skip generating a source file for an object with no functions.
         if (!obj->has_any<Function>()) {
-            return;
+            return false;
         }
 
         // Skip generating a source file for an object if the functions it does have are all undefined.
-        auto any_defined = false;
-
         for (auto&& fn : obj->get_all<Function>()) {
             if (fn->defined()) {
-                any_defined = true;
-                break;
+                return true;
             }
         }
 
-        if (!any_defined) {
-            return;
-        }
-
-        auto obj_src_path = sdk_path / source_path_for_object(obj);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
-        file_list << "\"" << obj_src_path.string() << "\" \\\n";
-
-        std::filesystem::create_directories(obj_src_path.parent_path());
-        std::ofstream os{obj_src_path};
+        return false;
+    }
 
+    template <typename T> void generate_source(std::ostream& os, T* obj) const {
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
             std::string line{};
@@ -1560,7 +1722,7 @@ protected:
         }
 
         std::unordered_set<Variable*> variables{};
-        std::unordered_set<Function*> functions{};
+        std::vector<Function*> functions{};
         std::unordered_set<Type*> types_to_include{};
         std::function<void(Type*)> add_type = [&](Type* t) {
             if (auto ref = dynamic_cast<Reference*>(t)) {
@@ -1600,9 +1762,9 @@ protected:
             add_type(fn->returns());
         }
 
-        for (auto&& type : types_to_include) {
+        for (auto&& [path, type] : sorted_includes(obj, types_to_include)) {
             if (!type->is_child_of(obj)) {
-                os << "#include \"" << include_path(obj, type).string() << "\"\n";
+                os << "#include \"" << path.string() << "\"\n";
             }
         }
 
@@ -1625,20 +1787,49 @@ protected:
         }
     }
 
-    template <typename T> void generate(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        for (auto&& obj : ns->get_all<T>()) {
-            generate_header(sdk_path, obj);
-            generate_source(sdk_path, obj);
+    void collect_namespace(Namespace* ns, std::vector<std::variant<Enum*, Struct*>>& objects) const {
+        for (auto&& e : ns->get_all<Enum>()) {
+            objects.emplace_back(e);
         }
-    }
 
-    void generate_namespace(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        generate<Enum>(sdk_path, ns);
-        generate<Struct>(sdk_path, ns);
+        for (auto&& s : ns->get_all<Struct>()) {
+            objects.emplace_back(s);
+        }
 
         for (auto&& child : ns->get_all<Namespace>()) {
-            generate_namespace(sdk_path, child);
+            collect_namespace(child, objects);
+        }
+    }
+
+    // FNV-1a
+    static uint64_t hash_content(std::string_view content) {
+        uint64_t hash{0xcbf29ce484222325};
+
+        for (auto c : content) {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3;
         }
+
+        return hash;
+    }
+
+    // Relative path -> content hash, written by the previous generate().
+    static std::unordered_map<std::string, uint64_t> load_manifest(const std::filesystem::path& sdk_path) {
+        std::unordered_map<std::string, uint64_t> manifest{};
+        std::ifstream is{sdk_path / "manifest.txt"};
+        std::string line{};
+
+        while (std::getline(is, line)) {
+            const auto space = line.find(' ');
+
+            if (space == std::string::npos) {
+                continue;
+            }
+
+            manifest[line.substr(space + 1)] = std::strtoull(line.c_str(), nullptr, 16);
+        }
+
+        return manifest;
     }
 };
 } // namespace genny
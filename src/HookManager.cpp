@@ -1,8 +1,11 @@
+#include <bit>
 #include <ranges>
 
 #include <hde64.h>
 #include <spdlog/spdlog.h>
 
+#include "sdk/REManagedObject.hpp"
+
 #include "HookManager.hpp"
 
 namespace detail {
@@ -44,6 +47,99 @@ void* get_actual_function(void* possible_fn) {
 
     return actual_fn;
 }
+
+template <typename T>
+bool compare(T lhs, T rhs, HookManager::HookFilter::Op op) {
+    using Op = HookManager::HookFilter::Op;
+
+    switch (op) {
+    case Op::EQ:
+        return lhs == rhs;
+    case Op::NE:
+        return lhs != rhs;
+    case Op::LT:
+        return lhs < rhs;
+    case Op::LE:
+        return lhs <= rhs;
+    case Op::GT:
+        return lhs > rhs;
+    case Op::GE:
+        return lhs >= rhs;
+    default:
+        return false;
+    }
+}
+}
+
+bool HookManager::HookFilter::type_matches(sdk::RETypeDefinition* t) const {
+    if (t == nullptr) {
+        return false;
+    }
+
+    if (t == m_last_match.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    if (t == m_last_miss.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const auto result = t->is_a(this_type);
+    (result ? m_last_match : m_last_miss).store(t, std::memory_order_relaxed);
+
+    return result;
+}
+
+bool HookManager::HookFilter::matches(const std::vector<uintptr_t>& args_impl) const {
+    if (!this_ptrs.empty() || this_type != nullptr) {
+        if (args_impl.size() < 2) {
+            return false;
+        }
+
+        const auto this_ptr = args_impl[1];
+
+        if (!this_ptrs.empty() && !this_ptrs.contains(this_ptr)) {
+            return false;
+        }
+
+        if (this_type != nullptr) {
+            if (this_ptr == 0 || !type_matches(utility::re_managed_object::get_type_definition((::REManagedObject*)this_ptr))) {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& cmp : args) {
+        if (cmp.index >= args_impl.size()) {
+            return false;
+        }
+
+        const auto raw = (uint64_t)args_impl[cmp.index];
+        bool result{};
+
+        switch (cmp.kind) {
+        case Kind::SIGNED: {
+            // mask is the width of the argument here, sign extend from its top bit.
+            const auto shift = std::countl_zero(cmp.mask);
+            result = detail::compare<int64_t>((int64_t)((raw & cmp.mask) << shift) >> shift, (int64_t)cmp.value, cmp.op);
+        } break;
+        case Kind::FLOAT:
+            result = detail::compare<float>(*(float*)&raw, *(float*)&cmp.value, cmp.op);
+            break;
+        case Kind::DOUBLE:
+            result = detail::compare<double>(*(double*)&raw, *(double*)&cmp.value, cmp.op);
+            break;
+        default:
+            result = detail::compare<uint64_t>(raw & cmp.mask, cmp.value, cmp.op);
+            break;
+        }
+
+        if (!result) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 HookManager::HookedFn::HookedFn(HookManager& hm) : hookman{hm} {
@@ -87,8 +183,17 @@ HookManager::PreHookResult HookManager::HookedFn::on_pre_hook() {
 
     ++storage->pre_depth;
     const auto ret_addr_pre = storage->ret_addr_pre;
+    uint64_t filtered{0};
+
+    for (size_t i = 0; i < cbs.size(); ++i) {
+        const auto& cb = cbs[i];
+
+        // Filters past the 64th callback can't be remembered for the post hook, those callbacks always run.
+        if (cb.filter != nullptr && i < 64 && !cb.filter->matches(storage->args_impl)) {
+            filtered |= 1ull << i;
+            continue;
+        }
 
-    for (const auto& cb : cbs) {
         if (cb.pre_fn) {
             if (cb.pre_fn(storage->args_impl, arg_tys, ret_addr_pre) == PreHookResult::SKIP_ORIGINAL) {
                 any_skipped = true;
@@ -96,6 +201,7 @@ HookManager::PreHookResult HookManager::HookedFn::on_pre_hook() {
         }
     }
 
+    storage->filtered_stack.push(filtered);
     ++storage->overall_depth;
     --storage->pre_depth;
 
@@ -129,9 +235,22 @@ void HookManager::HookedFn::on_post_hook() {
     auto& ret_val = storage->ret_val;
     //auto& ret_addr = storage->ret_addr_post;
 
+    uint64_t filtered{0};
+
+    if (!storage->filtered_stack.empty()) {
+        filtered = storage->filtered_stack.top();
+        storage->filtered_stack.pop();
+    }
+
     // Iterate in reverse because it helps with the hook storage we use in Lua
     // It should help with any other system that wants to use a stack-based storage system.
-    for (const auto& cb : cbs | std::views::reverse) {
+    for (size_t i = cbs.size(); i-- > 0;) {
+        const auto& cb = cbs[i];
+
+        if (i < 64 && (filtered & (1ull << i)) != 0) {
+            continue;
+        }
+
         if (cb.post_fn) {
             // Valid return address in recursion scenario is no longer supported with this API.
             // We just pass ret_addr_pre for now, even though it's not accurate.
@@ -540,7 +659,7 @@ void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedF
     *(uintptr_t*)(hook->facilitator_fn + code.labelOffsetFromBase(orig_label)) = hook_initialization();
 }
 
-HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::PreHookFn pre_fn, HookManager::PostHookFn post_fn, bool ignore_jmp) {
+HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::PreHookFn pre_fn, HookManager::PostHookFn post_fn, bool ignore_jmp, std::shared_ptr<const HookFilter> filter) {
     if (fn == nullptr) {
         //throw std::exception{"[HookManager] Cannot add nullptr function"};
         spdlog::error("[HookManager] Cannot add nullptr function");
@@ -566,7 +685,7 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
 
         spdlog::info("[HookManager] Hook assigned ID {}", hook_id);
 
-        hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+        hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn), filter);
 
         spdlog::info("[HookManager] Hook {} added for '{}' @ {:p}", hook_id, fn->get_name(), target_fn);
 
@@ -584,7 +703,7 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
     spdlog::info("[HookManager] Hook assigned ID {}", hook_id);
 
     hook->target_fn = target_fn;
-    hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+    hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn), filter);
     hook->arg_tys = fn->get_param_types();
     hook->ret_ty = fn->get_return_type();
     
@@ -614,7 +733,7 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
     return hook_id;
 }
 
-HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn) {
+HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn, std::shared_ptr<const HookFilter> filter) {
 #if TDB_VER == 49
     throw std::runtime_error("VTable hooks are not supported in TDB 49");
 #endif
@@ -673,7 +792,7 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
         std::unique_lock _{hook_fn->access_mux};
 
         auto hook_id = m_next_hook_id++;
-        hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+        hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn), filter);
 
         spdlog::info("[HookManager] VT Hook {} added for '{}' @ {:p}", hook_id, fn->get_name(), fn->get_function());
 
@@ -692,7 +811,7 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
     spdlog::info("[HookManager] VT Hook assigned ID {}", hook_id);
 
     hook_fn->target_fn = fn->get_function();
-    hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+    hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn), filter);
     hook_fn->arg_tys = fn->get_param_types();
     hook_fn->ret_ty = fn->get_return_type();
     
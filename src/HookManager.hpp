@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <unordered_set>
 
 #include <asmjit/asmjit.h>
 
@@ -27,10 +29,53 @@ public:
     using PostHookFn = std::function<void(uintptr_t& ret_val, sdk::RETypeDefinition* ret_ty, uintptr_t ret_addr)>;
     using HookId = size_t;
 
+    // Checked natively before a callback runs, calls that don't match skip both its pre and post function.
+    // Every condition that is set has to match.
+    struct HookFilter {
+        enum class Op : uint8_t {
+            EQ,
+            NE,
+            LT,
+            LE,
+            GT,
+            GE,
+        };
+
+        enum class Kind : uint8_t {
+            UNSIGNED,
+            SIGNED,
+            FLOAT,
+            DOUBLE,
+        };
+
+        // args is laid out like the pre function's args: 0 is the thread context, 1 is this for non-static methods.
+        struct ArgCompare {
+            uint32_t index{};
+            Op op{Op::EQ};
+            Kind kind{Kind::UNSIGNED};
+            uint64_t mask{~0ull}; // Applied to the argument before comparing, integers only. Has to be the argument's width for SIGNED
+            uint64_t value{};     // Raw bits, the float/double representation for floating point kinds
+        };
+
+        std::unordered_set<uintptr_t> this_ptrs{};
+        sdk::RETypeDefinition* this_type{nullptr}; // this has to be a managed object that is_a this_type
+        std::vector<ArgCompare> args{};
+
+        bool matches(const std::vector<uintptr_t>& args_impl) const;
+
+    private:
+        bool type_matches(sdk::RETypeDefinition* t) const;
+
+        // Last types that did/didn't pass the is_a check, most hot hooks only ever see a couple of types.
+        mutable std::atomic<sdk::RETypeDefinition*> m_last_match{nullptr};
+        mutable std::atomic<sdk::RETypeDefinition*> m_last_miss{nullptr};
+    };
+
     struct HookCallback {
         HookId id{};
         PreHookFn pre_fn{};
         PostHookFn post_fn{};
+        std::shared_ptr<const HookFilter> filter{};
     };
 
     struct HookedFn;
@@ -72,6 +117,7 @@ public:
             uintptr_t ret_val{};
             
             std::stack<uintptr_t> ptr_stack{}; // full storage for pointer-sized values. Supports recursion.
+            std::stack<uint64_t> filtered_stack{}; // Bit i set if cbs[i] was filtered out in the pre hook. Supports recursion.
             std::vector<size_t> args_impl{};
 
             uint32_t pre_depth{0};
@@ -139,19 +185,19 @@ public:
         __declspec(noinline) static void on_post_hook_static(HookedFn* fn) { fn->on_post_hook(); }
     };
 
-    HookId add(sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn, bool ignore_jmp = false);
-    HookId add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn);
+    HookId add(sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn, bool ignore_jmp = false, std::shared_ptr<const HookFilter> filter = nullptr);
+    HookId add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn, std::shared_ptr<const HookFilter> filter = nullptr);
 
     struct EitherOr {
         ::REManagedObject* obj{nullptr};
         sdk::REMethodDefinition* fn{nullptr};
         bool ignore_jmp{false};
     };
-    HookId add_either_or(const EitherOr& either_or, PreHookFn pre_fn, PostHookFn post_fn) {
+    HookId add_either_or(const EitherOr& either_or, PreHookFn pre_fn, PostHookFn post_fn, std::shared_ptr<const HookFilter> filter = nullptr) {
         if (either_or.obj == nullptr) {
-            return add(either_or.fn, pre_fn, post_fn, either_or.ignore_jmp);
+            return add(either_or.fn, pre_fn, post_fn, either_or.ignore_jmp, std::move(filter));
         } else {
-            return add_vtable(either_or.obj, either_or.fn, pre_fn, post_fn);
+            return add_vtable(either_or.obj, either_or.fn, pre_fn, post_fn, std::move(filter));
         }
     }
     void remove(sdk::REMethodDefinition* fn, HookId id);
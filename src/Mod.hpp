@@ -4,6 +4,7 @@
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -26,6 +27,9 @@ public:
     virtual void draw_value(std::string_view name) = 0;
     virtual void config_load(const utility::Config& cfg) = 0;
     virtual void config_save(utility::Config& cfg) = 0;
+
+    // Whether the value changed since it was last loaded from or saved to a config
+    virtual bool is_dirty() const = 0;
 };
 
 // Convenience classes for imgui
@@ -41,7 +45,8 @@ public:
     ModValue(std::string_view config_name, T default_value) 
         : m_config_name{ config_name },
         m_value{ default_value }, 
-        m_default_value{ default_value }
+        m_default_value{ default_value },
+        m_saved_value{ default_value }
     {
     }
 
@@ -53,12 +58,20 @@ public:
         if (v) {
             m_value = *v;
         }
+
+        m_saved_value = m_value;
     };
 
     virtual void config_save(utility::Config& cfg) override {
         cfg.set<T>(m_config_name, m_value);
+        m_saved_value = m_value;
     };
 
+    // Compared rather than flagged, the value is mostly written to through references.
+    virtual bool is_dirty() const override {
+        return m_value != m_saved_value;
+    }
+
     operator T&() {
         return m_value;
     }
@@ -78,6 +91,7 @@ public:
 protected:
     T m_value{};
     T m_default_value{};
+    T m_saved_value{};
     std::string m_config_name{ "Default_ModValue" };
 };
 
@@ -361,6 +375,10 @@ class Mod {
 protected:
     using ValueList = std::vector<std::reference_wrapper<IModValue>>;
 
+    static bool is_any_dirty(const ValueList& values) {
+        return std::any_of(values.begin(), values.end(), [](const IModValue& value) { return value.is_dirty(); });
+    }
+
 public:
     virtual ~Mod() {};
     virtual std::string_view get_name() const { return "UnknownMod"; };
@@ -372,6 +390,12 @@ public:
     // Returns an error string if it fails
     virtual std::optional<std::string> on_initialize() { return std::nullopt; };
     virtual std::optional<std::string> on_initialize_d3d_thread() { return std::nullopt; };
+
+    // Names of the mods whose on_initialize has to finish before this one's runs.
+    // Mods that declare their dependencies get initialized on the worker pool, concurrently with anything
+    // they don't depend on, so on_initialize must not touch state belonging to other mods (hook creation is fine, it's serialized).
+    // std::nullopt waits for every mod before this one in the list, which is also the order the old serial startup used.
+    virtual std::optional<std::vector<std::string_view>> get_initialize_dependencies() const { return std::nullopt; };
     virtual void on_lua_state_created(sol::state& lua) {};
     virtual void on_lua_state_destroyed(sol::state& lua) {};
 
@@ -391,6 +415,10 @@ public:
     virtual void on_config_load(const utility::Config& cfg) {};
     virtual void on_config_save(utility::Config& cfg) {};
 
+    // REFramework::save_config only calls on_config_save on mods that report a change here,
+    // other mods keep what they wrote last time. Mods that save anything should override this.
+    virtual bool is_config_dirty() { return false; }
+
     // Game-specific callbacks
     virtual void on_pre_update_transform(RETransform* transform) {};
     virtual void on_update_transform(RETransform* transform) {};
@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include <spdlog/spdlog.h>
 
 #include "mods/APIProxy.hpp"
@@ -17,8 +23,67 @@
 #include "mods/LooseFileLoader.hpp"
 #include "mods/vr/games/RE8VR.hpp"
 
+#include "StartupTimeline.hpp"
 #include "Mods.hpp"
 
+namespace detail {
+constexpr uint32_t MAX_INITIALIZE_WORKERS = 4;
+
+// Indices of the mods each mod has to wait for before its on_initialize can run.
+std::vector<std::vector<size_t>> resolve_initialize_dependencies(const std::vector<std::shared_ptr<Mod>>& mods) {
+    std::unordered_map<std::string_view, size_t> indices{};
+
+    for (size_t i = 0; i < mods.size(); ++i) {
+        indices[mods[i]->get_name()] = i;
+    }
+
+    std::vector<std::vector<size_t>> out(mods.size());
+
+    for (size_t i = 0; i < mods.size(); ++i) {
+        const auto dependencies = mods[i]->get_initialize_dependencies();
+
+        if (!dependencies) {
+            for (size_t j = 0; j < i; ++j) {
+                out[i].push_back(j);
+            }
+
+            continue;
+        }
+
+        for (const auto name : *dependencies) {
+            // Not every mod is built into every game.
+            if (auto it = indices.find(name); it != indices.end()) {
+                out[i].push_back(it->second);
+            } else {
+                spdlog::info("{:s} depends on {:s}, which isn't loaded", mods[i]->get_name().data(), name);
+            }
+        }
+    }
+
+    return out;
+}
+
+std::optional<std::string> initialize_mod(Mod& mod) try {
+    const auto mod_phase = StartupTimeline::get().scope(fmt::format("{:s}::on_initialize()", mod.get_name().data()));
+
+    spdlog::info("{:s}::on_initialize()", mod.get_name().data());
+
+    auto e = mod.on_initialize();
+
+    if (e) {
+        spdlog::info("{:s}::on_initialize() has failed: {:s}", mod.get_name().data(), *e);
+    }
+
+    return e;
+} catch (const std::exception& e) {
+    spdlog::error("{:s}::on_initialize() threw an exception: {:s}", mod.get_name().data(), e.what());
+    return e.what();
+} catch (...) {
+    spdlog::error("{:s}::on_initialize() threw an unknown exception", mod.get_name().data());
+    return std::string{"An exception has occurred during initialization of "} + mod.get_name().data();
+}
+}
+
 Mods::Mods() {
     m_mods.emplace_back(REFrameworkConfig::get());
 
@@ -72,16 +137,135 @@ Mods::Mods() {
     m_mods.emplace_back(ScriptRunner::get());
 }
 
+// Mods run as soon as everything they depend on has finished. Mods with declared dependencies are picked up
+// by whichever thread is free, the rest only ever run on the calling thread so they see the same
+// environment the old serial startup gave them.
+// Most of the time spent here is the IntegrityCheckBypass -> Hooks chain, which has to stay in that order;
+// only the light mods overlap with it. Check reframework_startup.txt before moving more mods onto the pool,
+// VR's heavy setup for example happens in on_initialize_d3d_thread, not here.
 std::optional<std::string> Mods::on_initialize() const {
-    for (auto& mod : m_mods) {
-        spdlog::info("{:s}::on_initialize()", mod->get_name().data());
+    const auto dependencies = detail::resolve_initialize_dependencies(m_mods);
+
+    std::vector<bool> runs_on_pool(m_mods.size());
+
+    for (size_t i = 0; i < m_mods.size(); ++i) {
+        runs_on_pool[i] = m_mods[i]->get_initialize_dependencies().has_value();
+    }
 
-        if (auto e = mod->on_initialize(); e != std::nullopt) {
-            spdlog::info("{:s}::on_initialize() has failed: {:s}", mod->get_name().data(), *e);
+    enum class State : uint8_t {
+        PENDING,
+        RUNNING,
+        DONE,
+    };
+
+    std::mutex mtx{};
+    std::condition_variable cv{};
+    std::vector<State> states(m_mods.size(), State::PENDING);
+    std::vector<std::optional<std::string>> errors(m_mods.size());
+    std::optional<std::string> scheduling_error{};
+    size_t running{0};
+    size_t remaining{m_mods.size()};
+    bool failed{false};
+
+    // The calling thread takes the mods only it can run first, so they don't end up waiting behind pool work.
+    const auto find_ready = [&](bool is_calling_thread) -> std::optional<size_t> {
+        const auto is_ready = [&](size_t i) {
+            const auto& deps = dependencies[i];
+
+            return states[i] == State::PENDING && std::all_of(deps.begin(), deps.end(), [&](size_t j) { return states[j] == State::DONE; });
+        };
+
+        for (size_t i = 0; i < m_mods.size(); ++i) {
+            if (runs_on_pool[i] != is_calling_thread && is_ready(i)) {
+                return i;
+            }
+        }
+
+        if (is_calling_thread) {
+            for (size_t i = 0; i < m_mods.size(); ++i) {
+                if (is_ready(i)) {
+                    return i;
+                }
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    const auto work = [&](bool is_calling_thread) {
+        std::unique_lock lock{mtx};
+
+        while (!failed && remaining > 0) {
+            const auto next = find_ready(is_calling_thread);
+
+            if (!next) {
+                // Only the calling thread can see every mod, so it's the one that decides we're stuck.
+                if (is_calling_thread && running == 0) {
+                    scheduling_error = "Mod initialization dependencies contain a cycle";
+                    spdlog::error("{:s}", *scheduling_error);
+                    failed = true;
+                    cv.notify_all();
+                    break;
+                }
+
+                cv.wait(lock);
+                continue;
+            }
+
+            states[*next] = State::RUNNING;
+            ++running;
+
+            lock.unlock();
+            auto e = detail::initialize_mod(*m_mods[*next]);
+            lock.lock();
+
+            states[*next] = State::DONE;
+            --running;
+            --remaining;
+
+            if (e) {
+                errors[*next] = std::move(e);
+                failed = true;
+            }
+
+            cv.notify_all();
+        }
+    };
+
+    {
+        const auto startup_phase = StartupTimeline::get().scope("Mods::on_initialize()");
+
+        const auto num_workers = std::clamp(std::thread::hardware_concurrency(), 1u, detail::MAX_INITIALIZE_WORKERS) - 1;
+        std::vector<std::jthread> workers{};
+
+        for (uint32_t i = 0; i < num_workers; ++i) {
+            workers.emplace_back([&]() {
+                work(false);
+
+                // Same as the game data thread, nothing else cleans up after our own threads.
+                if (auto context = sdk::get_thread_context(); context != nullptr) try {
+                    context->local_frame_gc();
+                } catch(...) {
+                    spdlog::error("Failed to run local frame GC.");
+                }
+            });
+        }
+
+        work(true);
+    }
+
+    for (auto& e : errors) {
+        if (e) {
             return e;
         }
     }
 
+    if (scheduling_error) {
+        return scheduling_error;
+    }
+
+    const auto config_phase = StartupTimeline::get().scope("Mods::on_config_load()");
+
     utility::Config cfg{ (REFramework::get_persistent_dir() / "re2_fw_config.txt").string() };
 
     for (auto& mod : m_mods) {
@@ -96,6 +280,8 @@ std::optional<std::string> Mods::on_initialize() const {
 std::optional<std::string> Mods::on_initialize_d3d_thread() const {
     std::scoped_lock _{g_framework->get_hook_monitor_mutex()};
 
+    const auto startup_phase = StartupTimeline::get().scope("Mods::on_initialize_d3d_thread()");
+
     utility::Config cfg{ (REFramework::get_persistent_dir() / "re2_fw_config.txt").string() };
 
     // once here to at least setup the values
@@ -107,6 +293,8 @@ std::optional<std::string> Mods::on_initialize_d3d_thread() const {
     for (auto& mod : m_mods) {
         spdlog::info("{:s}::on_initialize_d3d_thread()", mod->get_name().data());
 
+        const auto mod_phase = StartupTimeline::get().scope(fmt::format("{:s}::on_initialize_d3d_thread()", mod->get_name().data()));
+
         if (auto e = mod->on_initialize_d3d_thread(); e != std::nullopt) {
             spdlog::info("{:s}::on_initialize_d3d_thread() has failed: {:s}", mod->get_name().data(), *e);
             return e;
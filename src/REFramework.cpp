@@ -32,9 +32,12 @@ extern "C" {
 #include "sdk/REGlobals.hpp"
 #include "sdk/Application.hpp"
 #include "sdk/SDK.hpp"
+#include "sdk/TDBWarmup.hpp"
+#include "sdk/MethodIndex.hpp"
 
 #include "ExceptionHandler.hpp"
 #include "LicenseStrings.hpp"
+#include "StartupTimeline.hpp"
 #include "mods/REFrameworkConfig.hpp"
 #include "mods/IntegrityCheckBypass.hpp"
 #include "CommitHash.autogenerated"
@@ -237,6 +240,8 @@ REFramework::REFramework(HMODULE reframework_module)
 
     s_reframework_module = reframework_module;
 
+    const auto startup_phase = StartupTimeline::get().scope("REFramework::REFramework()");
+
     std::scoped_lock __{m_startup_mutex};
 
     spdlog::set_default_logger(m_logger);
@@ -643,6 +648,10 @@ REFramework::REFramework(HMODULE reframework_module)
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
         }
     });
+
+    m_config_writer_thread = std::make_unique<std::jthread>([this](std::stop_token stop_token) {
+        config_writer_thread(stop_token);
+    });
 }
 
 bool REFramework::hook_d3d11() {
@@ -733,6 +742,19 @@ REFramework::~REFramework() {
 
     m_d3d_monitor_thread.reset();
 
+    if (m_config_writer_thread != nullptr) {
+        m_config_writer_thread->request_stop();
+        if (m_config_writer_thread->joinable()) {
+            m_config_writer_thread->join();
+        }
+
+        m_config_writer_thread.reset();
+    }
+
+    // On process exit the writer thread has already been terminated by the time we get here,
+    // so whatever is still queued gets written from this thread.
+    flush_config();
+
     if (m_is_d3d11) {
         deinit_d3d11();
     }
@@ -1309,19 +1331,107 @@ std::filesystem::path REFramework::get_persistent_dir() {
 void REFramework::save_config() {
     std::scoped_lock _{m_config_mtx};
 
-    spdlog::info("Saving config re2_fw_config.txt");
-
-    utility::Config cfg{};
+    bool any_saved = false;
 
     for (auto& mod : m_mods->get_mods()) {
-        mod->on_config_save(cfg);
+        if (m_config_cache_valid && !mod->is_config_dirty()) {
+            continue;
+        }
+
+        mod->on_config_save(m_config_cache);
+        any_saved = true;
+    }
+
+    if (!any_saved && m_config_cache_valid) {
+        return;
+    }
+
+    m_config_cache_valid = true;
+
+    {
+        std::scoped_lock __{m_config_write_mtx};
+
+        const auto now = std::chrono::steady_clock::now();
+
+        // Keep pushing the write back while saves keep coming in, up to CONFIG_MAX_SAVE_DELAY after the first one.
+        if (!m_pending_config) {
+            m_config_write_deadline = now + CONFIG_MAX_SAVE_DELAY;
+        }
+
+        m_config_write_deadline = std::min(m_config_write_deadline, now + CONFIG_SAVE_DELAY);
+        m_pending_config = m_config_cache;
+    }
+
+    m_config_write_cv.notify_all();
+}
+
+void REFramework::config_writer_thread(std::stop_token stop_token) {
+    std::unique_lock lock{m_config_write_mtx};
+
+    while (true) {
+        // Returns false only when a stop was requested with nothing left to write.
+        if (!m_config_write_cv.wait(lock, stop_token, [this] { return m_pending_config.has_value(); })) {
+            break;
+        }
+
+        // The deadline can be pulled forward while waiting, see write_config_soon.
+        while (!stop_token.stop_requested() && std::chrono::steady_clock::now() < m_config_write_deadline) {
+            m_config_write_cv.wait_until(lock, stop_token, m_config_write_deadline, [this] {
+                return std::chrono::steady_clock::now() >= m_config_write_deadline;
+            });
+        }
+
+        lock.unlock();
+        flush_config();
+        lock.lock();
+    }
+}
+
+void REFramework::write_config_soon() {
+    {
+        std::scoped_lock _{m_config_write_mtx};
+
+        if (!m_pending_config) {
+            return;
+        }
+
+        m_config_write_deadline = std::chrono::steady_clock::now();
+    }
+
+    m_config_write_cv.notify_all();
+}
+
+void REFramework::flush_config() {
+    // Held from taking the snapshot until it's written, so an older snapshot can't land on top of a newer one.
+    std::scoped_lock _{m_config_file_mtx};
+
+    std::optional<utility::Config> cfg{};
+
+    {
+        std::scoped_lock __{m_config_write_mtx};
+        cfg.swap(m_pending_config);
     }
 
+    if (cfg) {
+        write_config(*cfg);
+    }
+}
+
+void REFramework::write_config(utility::Config& cfg) {
+    const auto path = get_persistent_dir() / "re2_fw_config.txt";
+    auto temp_path = path;
+    temp_path += ".tmp";
+
+    spdlog::info("Saving config re2_fw_config.txt");
+
+    // Written next to the real file and renamed over it, so a crash mid-write can't leave a truncated config behind.
     try {
-        if (!cfg.save((get_persistent_dir() / "re2_fw_config.txt").string())) {
+        if (!cfg.save(temp_path.string())) {
             spdlog::error("Failed to save config");
             return;
         }
+
+        std::filesystem::rename(temp_path, path);
     } catch(const std::exception& e) {
         spdlog::error("Failed to save config: {}", e.what());
         return;
@@ -1345,6 +1455,12 @@ void REFramework::set_draw_ui(bool state, bool should_save) {
 
     if (state != prev_state && should_save && m_game_data_initialized) {
         save_config();
+
+        // Closing the menu is usually the last thing done before quitting the game.
+        // Still written on the writer thread, this runs on the render or window thread.
+        if (!state) {
+            write_config_soon();
+        }
     }
 }
 
@@ -1853,6 +1969,7 @@ bool REFramework::initialize() {
 
     if (m_first_frame) {
         m_first_frame = false;
+        StartupTimeline::get().mark("Renderer initialized");
         initialize_game_data();
     }
 
@@ -1878,9 +1995,13 @@ bool REFramework::initialize_game_data() {
                 utility::spoof_module_paths_in_exe_dir();
             }
 #endif
-            reframework::initialize_sdk();
+            {
+                const auto sdk_phase = StartupTimeline::get().scope("initialize_sdk()");
+                reframework::initialize_sdk();
+            }
 
 #if TDB_VER >= 71
+            const auto wait_start = StartupTimeline::Clock::now();
             const auto start_time = std::chrono::high_resolution_clock::now();
 
             while (true) {
@@ -1914,8 +2035,19 @@ bool REFramework::initialize_game_data() {
 
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
+
+            StartupTimeline::get().record("Waiting for VM and Application", wait_start, StartupTimeline::Clock::now());
 #endif
 
+            // Runs alongside mod initialization, the lookups it warms up still work lazily until it's done.
+            if (REFrameworkConfig::should_warm_up_tdb()) {
+                StartupTimeline::get().mark("TDB warm-up started");
+                sdk::TDBWarmup::start();
+            } else {
+                // Otherwise the warm-up starts it. Crash reports can only name methods once it's built.
+                sdk::MethodAddressIndex::build_async();
+            }
+
             m_mods = std::make_unique<Mods>();
 
             auto e = m_mods->on_initialize();
@@ -2015,6 +2147,8 @@ bool REFramework::first_frame_initialize() {
         // Do an initial config save to set the default values for the frontend
         save_config();
         m_mods_fully_initialized = true;
+
+        StartupTimeline::get().finish(get_persistent_dir("reframework_startup.txt"));
     }
 
     // Troubleshooting by logging loaded modules
@@ -2039,6 +2173,9 @@ void REFramework::call_on_frame() {
     const bool is_init_ok = m_error.empty() && m_game_data_initialized;
 
     if (is_init_ok) {
+        // Game thread, so this is the one place that can ask the VM for the current scene.
+        reframework::get_globals()->update_scene_epoch();
+
         // Run mod frame callbacks.
         m_mods->on_frame();
     }
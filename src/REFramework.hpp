@@ -2,10 +2,13 @@
 
 #include <array>
 #include <unordered_set>
+#include <condition_variable>
 #include <filesystem>
+#include <optional>
 
 #include <spdlog/spdlog.h>
 #include <imgui.h>
+#include <utility/Config.hpp>
 #include <utility/Patch.hpp>
 
 #include "mods/vr/d3d12/CommandContext.hpp"
@@ -68,8 +71,16 @@ public:
         return get_persistent_dir() / dir;
     }
 
+    // Serializes the mods whose config changed and queues writing re2_fw_config.txt on the config writer thread.
+    // Saves in quick succession (menu toggles, several options changed at once) end up as a single write.
     void save_config();
 
+    // Has the config writer thread write whatever save_config queued without waiting out the delay.
+    void write_config_soon();
+
+    // Writes whatever save_config queued right away, on the calling thread.
+    void flush_config();
+
     enum class RendererType : uint8_t {
         D3D11,
         D3D12
@@ -144,6 +155,9 @@ private:
     void draw_ui();
     void draw_about();
 
+    void config_writer_thread(std::stop_token stop_token);
+    static void write_config(utility::Config& cfg);
+
 public:
     bool hook_d3d11();
     bool hook_d3d12();
@@ -198,6 +212,17 @@ private:
 
     std::mutex m_input_mutex{};
     std::recursive_mutex m_config_mtx{};
+    utility::Config m_config_cache{}; // What the last save_config serialized, only dirty mods get serialized again
+    bool m_config_cache_valid{false};
+
+    static constexpr auto CONFIG_SAVE_DELAY = std::chrono::milliseconds{500};
+    static constexpr auto CONFIG_MAX_SAVE_DELAY = std::chrono::seconds{3};
+    std::mutex m_config_write_mtx{};
+    std::mutex m_config_file_mtx{};
+    std::condition_variable_any m_config_write_cv{};
+    std::optional<utility::Config> m_pending_config{};
+    std::chrono::steady_clock::time_point m_config_write_deadline{};
+    std::unique_ptr<std::jthread> m_config_writer_thread{};
     std::recursive_mutex m_imgui_mtx{};
     std::recursive_mutex m_patch_mtx{};
 
@@ -0,0 +1,95 @@
+#include <Windows.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "StartupTimeline.hpp"
+
+namespace detail {
+// Initialized when the DLL gets loaded, which is as close to injection as we can get.
+const auto g_startup_origin = StartupTimeline::Clock::now();
+
+double to_ms(StartupTimeline::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+}
+
+StartupTimeline& StartupTimeline::get() {
+    static StartupTimeline instance{};
+    return instance;
+}
+
+void StartupTimeline::record(std::string name, Clock::time_point start, Clock::time_point end) {
+    std::scoped_lock _{m_mutex};
+
+    if (m_finished) {
+        return;
+    }
+
+    m_phases.push_back(Phase{std::move(name), start, end, (uint32_t)GetCurrentThreadId()});
+}
+
+void StartupTimeline::mark(std::string name) {
+    const auto now = Clock::now();
+    record(std::move(name), now, now);
+}
+
+void StartupTimeline::finish(const std::filesystem::path& report_path) {
+    mark("First usable frame");
+
+    std::string report{};
+
+    {
+        std::scoped_lock _{m_mutex};
+
+        if (m_finished) {
+            return;
+        }
+
+        m_finished = true;
+        report = make_report();
+    }
+
+    spdlog::info("[StartupTimeline] Startup report:\n{}", report);
+
+    std::ofstream file{report_path};
+
+    if (!file) {
+        spdlog::error("[StartupTimeline] Failed to write {}", report_path.string());
+        return;
+    }
+
+    file << report;
+}
+
+std::string StartupTimeline::make_report() const {
+    auto phases = m_phases;
+
+    // Stable so nested phases recorded at the same tick keep their recording order.
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+        return a.start < b.start;
+    });
+
+    std::string out{};
+    out += fmt::format("{:>10} {:>10} {:>8}  {}\n", "start ms", "ms", "thread", "phase");
+
+    Clock::time_point last_end{detail::g_startup_origin};
+
+    for (const auto& phase : phases) {
+        const auto start_ms = detail::to_ms(phase.start - detail::g_startup_origin);
+
+        if (phase.start == phase.end) {
+            out += fmt::format("{:>10.1f} {:>10} {:>8}  {}\n", start_ms, "-", phase.thread_id, phase.name);
+        } else {
+            out += fmt::format("{:>10.1f} {:>10.1f} {:>8}  {}\n", start_ms, detail::to_ms(phase.end - phase.start), phase.thread_id, phase.name);
+        }
+
+        last_end = std::max(last_end, phase.end);
+    }
+
+    out += fmt::format("\nInjection to first usable frame: {:.1f} ms\n", detail::to_ms(last_end - detail::g_startup_origin));
+
+    return out;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Where startup time goes, from the DLL being loaded to the first frame where everything is usable.
+// Phases can be recorded from any thread (the mod init worker pool records one per mod).
+// The report is written once, when the first usable frame is marked.
+class StartupTimeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name{};
+        Clock::time_point start{};
+        Clock::time_point end{}; // Same as start for marks
+        uint32_t thread_id{};
+    };
+
+    // Records the phase when it goes out of scope.
+    class ScopedPhase {
+    public:
+        ScopedPhase(StartupTimeline& timeline, std::string name)
+            : m_timeline{timeline},
+            m_name{std::move(name)},
+            m_start{Clock::now()}
+        {
+        }
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        ~ScopedPhase() {
+            m_timeline.record(std::move(m_name), m_start, Clock::now());
+        }
+
+    private:
+        StartupTimeline& m_timeline;
+        std::string m_name;
+        Clock::time_point m_start;
+    };
+
+    static StartupTimeline& get();
+
+public:
+    ScopedPhase scope(std::string name) {
+        return ScopedPhase{*this, std::move(name)};
+    }
+
+    void record(std::string name, Clock::time_point start, Clock::time_point end);
+    void mark(std::string name);
+
+    // Marks the end of startup and writes the report. Only the first call does anything.
+    void finish(const std::filesystem::path& report_path);
+
+private:
+    std::string make_report() const;
+
+    mutable std::mutex m_mutex{};
+    std::vector<Phase> m_phases{};
+    bool m_finished{false};
+};
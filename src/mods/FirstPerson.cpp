@@ -1189,7 +1189,7 @@ void FirstPerson::update_player_muzzle_behavior(RETransform* transform, bool res
 
                         // Set the parent joint name to the VFX muzzle joint which will set _Parent later on
                         if (vfx_muzzle1 != nullptr && current_muzzle_joint != vfx_muzzle1) {
-                            auto muzzle_joint_name = sdk::VM::create_managed_string(L"vfx_muzzle1");
+                            auto muzzle_joint_name = sdk::VM::create_managed_string_interned(L"vfx_muzzle1");
 
                             // call set_ParentJointNameForm
                             sdk::call_object_func<void*>(muzzle_joint_param, "set_ParentJointNameForm", context, muzzle_joint_param, muzzle_joint_name);
@@ -1788,13 +1788,21 @@ void FirstPerson::update_sweet_light_context(RopewaySweetLightManagerContext* ct
 }
 
 void FirstPerson::update_player_bones(RETransform* transform) {
-    auto joint = sdk::get_transform_joint_by_name(transform, m_attach_bone);
+    // Cached joint layout, saves a VM call and a name lookup every frame.
+    const auto skeleton = sdk::get_skeleton(*transform);
 
-    if (joint == nullptr) {
+    if (skeleton == nullptr) {
+        return;
+    }
+
+    const auto joint_index = skeleton->find(m_attach_bone);
+
+    if (joint_index < 0) {
         return;
     }
 
-    auto& bone_matrix = utility::re_transform::get_joint_matrix(*m_player_transform, m_attach_bone);
+    auto joint = skeleton->joints[joint_index];
+    auto& bone_matrix = utility::re_transform::get_joint_matrix_by_index(*transform, joint_index);
 
     if (g_first_time) {
         m_last_bone_matrix = Matrix4x4f{sdk::get_joint_rotation(joint)};
@@ -34,6 +34,7 @@ public:
 
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     void on_pre_update_transform(RETransform* transform) override;
     void on_update_transform(RETransform* transform) override;
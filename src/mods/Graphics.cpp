@@ -1,6 +1,7 @@
 #include <utility/Module.hpp>
 #include <utility/Scan.hpp>
 
+#include <sdk/GUIElementCache.hpp>
 #include <sdk/SceneManager.hpp>
 #include <sdk/MurmurHash.hpp>
 #include <sdk/Renderer.hpp>
@@ -386,9 +387,9 @@ void Graphics::fix_ui_element(REComponent* gui_element) {
         return;
     }
 
-    const auto go_name = utility::re_string::get_view(game_object->name);
+    const auto gui_entry = sdk::GUIElementCache::get().lookup(gui_element);
 
-    if (go_name == L"BlackFade") {
+    if (gui_entry != nullptr && gui_entry->name_hash == "BlackFade"_fnv) {
         return; // Don't do anything with the black fade, it should be taking over the whole screen
     }
 
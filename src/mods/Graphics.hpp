@@ -18,11 +18,13 @@ public:
 
 public:
     std::optional<std::string> on_initialize() override;
+    std::optional<std::vector<std::string_view>> get_initialize_dependencies() const override { return std::vector<std::string_view>{}; }
 
     std::string_view get_name() const override { return "Graphics"; };
 
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     void on_frame() override;
     void on_draw_ui() override;
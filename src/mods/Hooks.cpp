@@ -5,6 +5,7 @@
 #include <utility/String.hpp>
 #include <utility/Memory.hpp>
 
+#include "sdk/GUIElementCache.hpp"
 #include "sdk/GUIPrimitiveSystem.hpp"
 #include "sdk/Application.hpp"
 
@@ -46,6 +47,10 @@ std::optional<std::string> Hooks::on_initialize() {
     return Mod::on_initialize();
 }
 
+void Hooks::on_frame() {
+    sdk::GUIElementCache::get().on_frame();
+}
+
 void Hooks::on_draw_ui() {
     if (!ImGui::CollapsingHeader("Performance")) {
         return;
@@ -784,6 +789,10 @@ void* Hooks::gui_draw_hook_internal(REComponent* gui_element, void* primitive_co
 
     auto& mods = g_framework->get_mods()->get_mods();
 
+    // Classified once per GameObject, the mods below pick it up through the cache.
+    auto& gui_cache = sdk::GUIElementCache::get();
+    auto prev_gui_entry = gui_cache.set_current(gui_cache.lookup(gui_element));
+
     bool any_false = false;
 
     for (auto& mod : mods) {
@@ -802,6 +811,8 @@ void* Hooks::gui_draw_hook_internal(REComponent* gui_element, void* primitive_co
         mod->on_gui_draw_element(gui_element, primitive_context);
     }
 
+    gui_cache.set_current(std::move(prev_gui_entry));
+
     return ret;
 }
 
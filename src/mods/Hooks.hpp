@@ -14,6 +14,10 @@ public:
 
     std::string_view get_name() const override { return "Hooks"; };
     std::optional<std::string> on_initialize() override;
+
+    // IntegrityCheckBypass tells us which application entries to ignore, those have to be in before the hooks are.
+    std::optional<std::vector<std::string_view>> get_initialize_dependencies() const override { return std::vector<std::string_view>{"IntegrityCheckBypass"}; }
+    void on_frame() override;
     void on_draw_ui() override;
 
     auto& get_application_entry_times() {
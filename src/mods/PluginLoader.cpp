@@ -99,7 +99,8 @@ REFrameworkSDKFunctions g_sdk_functions {
     },
     // get_managed_singletons
     [](REFrameworkManagedSingleton* out, unsigned int out_size, unsigned int* out_count) -> REFrameworkResult {
-        auto singletons = reframework::get_globals()->get_objects();
+        thread_local std::vector<REManagedObject*> singletons{};
+        reframework::get_globals()->get_objects(singletons);
 
         if (out_size < singletons.size() * sizeof(REFrameworkManagedSingleton)) {
             return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
@@ -548,6 +549,255 @@ REFrameworkReflectionProperty g_reflection_prop_data {
     }
 };
 
+namespace reframework {
+struct BulkInvoke {
+    sdk::REMethodDefinition* method{};
+    sdk::REMethodDefinition::InvokePlan plan{};
+};
+
+std::vector<std::string_view> to_name_views(const char* const* names, unsigned int count) {
+    std::vector<std::string_view> out{};
+    out.reserve(count);
+
+    for (unsigned int i = 0; i < count; ++i) {
+        out.emplace_back(names[i] != nullptr ? names[i] : "");
+    }
+
+    return out;
+}
+
+uint32_t get_field_value_size(sdk::REField* field) {
+    const auto t = field->get_type();
+
+    if (t != nullptr && t->is_value_type()) {
+        return t->get_valuetype_size();
+    }
+
+    return sizeof(void*);
+}
+}
+
+#define BULKINVOKE(var) ((reframework::BulkInvoke*)var)
+
+REFrameworkBulk g_bulk_data {
+    [](REFrameworkTDBHandle tdb, const char* const* names, unsigned int count, REFrameworkTypeDefinitionHandle* out) -> unsigned int {
+        const auto name_views = reframework::to_name_views(names, count);
+        return (unsigned int)RETDB(tdb)->find_types(name_views, std::span{(sdk::RETypeDefinition**)out, count});
+    },
+    [](REFrameworkTypeDefinitionHandle tdef, const char* const* names, unsigned int count, REFrameworkMethodHandle* out) -> unsigned int {
+        const auto name_views = reframework::to_name_views(names, count);
+        return (unsigned int)RETYPEDEF(tdef)->find_methods(name_views, std::span{(sdk::REMethodDefinition**)out, count});
+    },
+    [](REFrameworkTypeDefinitionHandle tdef, const char* const* names, unsigned int count, REFrameworkFieldHandle* out) -> unsigned int {
+        const auto name_views = reframework::to_name_views(names, count);
+        return (unsigned int)RETYPEDEF(tdef)->find_fields(name_views, std::span{(sdk::REField**)out, count});
+    },
+
+    // get_method_descriptors
+    [](REFrameworkTypeDefinitionHandle tdef, REFrameworkMethodDescriptor* out, unsigned int out_size, unsigned int* out_count) {
+        auto methods = RETYPEDEF(tdef)->get_methods();
+
+        if (out_count != nullptr) {
+            *out_count = 0;
+        }
+
+        if (methods.size() * sizeof(REFrameworkMethodDescriptor) > out_size) {
+            return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
+        }
+
+        for (auto& m : methods) {
+            *out++ = REFrameworkMethodDescriptor{
+                (REFrameworkMethodHandle)&m,
+                m.get_name(),
+                (REFrameworkTypeDefinitionHandle)m.get_declaring_type(),
+                (REFrameworkTypeDefinitionHandle)m.get_return_type(),
+                m.get_function(),
+                m.get_index(),
+                m.get_num_params(),
+                m.get_virtual_index(),
+                m.get_flags(),
+                m.get_impl_flags(),
+                m.is_static()
+            };
+        }
+
+        if (out_count != nullptr) {
+            *out_count = methods.size();
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+    // get_field_descriptors
+    [](REFrameworkTypeDefinitionHandle tdef, REFrameworkFieldDescriptor* out, unsigned int out_size, unsigned int* out_count) {
+        auto fields = RETYPEDEF(tdef)->get_fields();
+
+        if (out_count != nullptr) {
+            *out_count = 0;
+        }
+
+        if (fields.size() * sizeof(REFrameworkFieldDescriptor) > out_size) {
+            return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
+        }
+
+        for (auto f : fields) {
+            *out++ = REFrameworkFieldDescriptor{
+                (REFrameworkFieldHandle)f,
+                f->get_name(),
+                (REFrameworkTypeDefinitionHandle)f->get_declaring_type(),
+                (REFrameworkTypeDefinitionHandle)f->get_type(),
+                f->get_index(),
+                f->get_offset_from_base(),
+                f->get_offset_from_fieldptr(),
+                f->get_flags(),
+                f->is_static(),
+                f->is_literal()
+            };
+        }
+
+        if (out_count != nullptr) {
+            *out_count = fields.size();
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+
+    // read_field
+    [](REFrameworkFieldHandle field_handle, void* const* objects, unsigned int count, bool is_value_type, void* out, unsigned int stride, unsigned int value_size) {
+        const auto field = REFIELD(field_handle);
+
+        if (value_size == 0) {
+            value_size = reframework::get_field_value_size(field);
+        }
+
+        if (stride < value_size) {
+            return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
+        }
+
+        auto dst = (uint8_t*)out;
+
+        // Same data for every object, resolve it once.
+        if (field->is_static()) {
+            const auto data = field->get_data_raw(nullptr, false);
+
+            for (unsigned int i = 0; i < count; ++i, dst += stride) {
+                if (data != nullptr) {
+                    memcpy(dst, data, value_size);
+                } else {
+                    memset(dst, 0, value_size);
+                }
+            }
+
+            return REFRAMEWORK_ERROR_NONE;
+        }
+
+        const auto offset = is_value_type ? field->get_offset_from_fieldptr() : field->get_offset_from_base();
+
+        for (unsigned int i = 0; i < count; ++i, dst += stride) {
+            if (objects[i] != nullptr) {
+                memcpy(dst, (uint8_t*)objects[i] + offset, value_size);
+            } else {
+                memset(dst, 0, value_size);
+            }
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+    // write_field
+    [](REFrameworkFieldHandle field_handle, void* const* objects, unsigned int count, bool is_value_type, const void* in, unsigned int stride, unsigned int value_size) {
+        const auto field = REFIELD(field_handle);
+
+        if (value_size == 0) {
+            value_size = reframework::get_field_value_size(field);
+        }
+
+        if (stride < value_size) {
+            return REFRAMEWORK_ERROR_IN_ARGS_SIZE_MISMATCH;
+        }
+
+        auto src = (const uint8_t*)in;
+
+        if (field->is_static()) {
+            const auto data = field->get_data_raw(nullptr, false);
+
+            // Last write wins, same as writing it count times.
+            if (data != nullptr && count > 0 && !field->is_literal()) {
+                memcpy(data, src + (size_t)(count - 1) * stride, value_size);
+            }
+
+            return REFRAMEWORK_ERROR_NONE;
+        }
+
+        const auto offset = is_value_type ? field->get_offset_from_fieldptr() : field->get_offset_from_base();
+
+        for (unsigned int i = 0; i < count; ++i, src += stride) {
+            if (objects[i] != nullptr) {
+                memcpy((uint8_t*)objects[i] + offset, src, value_size);
+            }
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+
+    // create_invoke
+    [](REFrameworkMethodHandle method) -> REFrameworkInvokeHandle {
+        if (method == nullptr) {
+            return nullptr;
+        }
+
+        return (REFrameworkInvokeHandle)new reframework::BulkInvoke{REMETHOD(method), REMETHOD(method)->get_invoke_plan()};
+    },
+    // destroy_invoke
+    [](REFrameworkInvokeHandle handle) {
+        delete BULKINVOKE(handle);
+    },
+    // invoke
+    [](REFrameworkInvokeHandle handle, void* thisptr, void** in_args, void* out, unsigned int out_size) {
+        if (sizeof(reframework::InvokeRet) > out_size) {
+            return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
+        }
+
+        const auto bound = BULKINVOKE(handle);
+        auto& ret = *(reframework::InvokeRet*)out;
+
+        bound->method->invoke(bound->plan, thisptr, std::span<void*>(in_args, bound->plan.num_params), ret);
+
+        if (ret.exception_thrown) {
+            return REFRAMEWORK_ERROR_EXCEPTION;
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+    // invoke_many
+    [](REFrameworkInvokeHandle handle, void* const* thisptrs, unsigned int count, void** in_args, void* out, unsigned int out_stride, unsigned int* out_count) {
+        if (out_count != nullptr) {
+            *out_count = 0;
+        }
+
+        if (sizeof(reframework::InvokeRet) > out_stride) {
+            return REFRAMEWORK_ERROR_OUT_TOO_SMALL;
+        }
+
+        const auto bound = BULKINVOKE(handle);
+        const auto args = std::span<void*>(in_args, bound->plan.num_params);
+
+        for (unsigned int i = 0; i < count; ++i) {
+            auto& ret = *(reframework::InvokeRet*)((uint8_t*)out + (size_t)i * out_stride);
+
+            bound->method->invoke(bound->plan, thisptrs[i], args, ret);
+
+            if (out_count != nullptr) {
+                *out_count = i + 1;
+            }
+
+            if (ret.exception_thrown) {
+                return REFRAMEWORK_ERROR_EXCEPTION;
+            }
+        }
+
+        return REFRAMEWORK_ERROR_NONE;
+    },
+};
+
 REFrameworkSDKData g_sdk_data {
     &g_sdk_functions,
     &g_tdb_data,
@@ -562,6 +812,7 @@ REFrameworkSDKData g_sdk_data {
     &g_vm_context_data,
     &g_reflection_method_data,
     &g_reflection_prop_data,
+    &g_bulk_data,
 };
 
 REFrameworkPluginInitializeParam g_plugin_initialize_param{
@@ -592,6 +843,7 @@ void verify_sdk_pointers() {
     verify(g_tdb_field_data);
     verify(g_tdb_property_data);
     verify(g_tdb_data);
+    verify(g_bulk_data);
 }
 
 std::shared_ptr<PluginLoader> PluginLoader::get() {
@@ -7,6 +7,12 @@ std::shared_ptr<REFrameworkConfig>& REFrameworkConfig::get() {
      return instance;
 }
 
+bool REFrameworkConfig::should_warm_up_tdb() {
+    utility::Config cfg{ (REFramework::get_persistent_dir() / "re2_fw_config.txt").string() };
+
+    return cfg.get<bool>("REFrameworkConfig_WarmUpTDB").value_or(true);
+}
+
 std::optional<std::string> REFrameworkConfig::on_initialize() {
     return Mod::on_initialize();
 }
@@ -27,6 +33,12 @@ void REFrameworkConfig::on_draw_ui() {
         g_framework->set_font_size(m_font_size->value());
     }
 
+    m_warm_up_tdb->draw("Warm Up Type Database At Startup");
+
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Fills the type/method/field lookup caches on background threads during startup.\nTakes effect on the next launch.");
+    }
+
     ImGui::TreePop();
 }
 
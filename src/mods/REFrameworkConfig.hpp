@@ -12,10 +12,12 @@ public:
     }
 
     std::optional<std::string> on_initialize() override;
+    std::optional<std::vector<std::string_view>> get_initialize_dependencies() const override { return std::vector<std::string_view>{}; }
     void on_draw_ui() override;
     void on_frame() override;
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     auto& get_menu_key() {
         return m_menu_key;
@@ -29,6 +31,9 @@ public:
         return m_always_show_cursor->value();
     }
 
+    // Read straight from the config file, the TDB warm-up starts before the mods exist.
+    static bool should_warm_up_tdb();
+
 private:
     ModKey::Ptr m_menu_key{ ModKey::create(generate_name("MenuKey_V2"), VK_INSERT) };
     ModToggle::Ptr m_menu_open{ ModToggle::create(generate_name("MenuOpen"), true) };
@@ -40,6 +45,7 @@ private:
 #endif
     ModKey::Ptr m_show_cursor_key{ ModKey::create(generate_name("ShowCursorKey")) };
     ModInt32::Ptr m_font_size{ModInt32::create(generate_name("FontSize"), 16)};
+    ModToggle::Ptr m_warm_up_tdb{ ModToggle::create(generate_name("WarmUpTDB"), true) };
 
     ValueList m_options {
         *m_menu_key,
@@ -48,5 +54,6 @@ private:
         *m_always_show_cursor,
         *m_show_cursor_key,
         *m_font_size,
+        *m_warm_up_tdb,
     };
 };
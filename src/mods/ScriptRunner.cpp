@@ -5,6 +5,7 @@
 
 #include <imgui.h>
 
+#include "sdk/GUIElementCache.hpp"
 #include "sdk/REContext.hpp"
 #include "sdk/REManagedObject.hpp"
 #include "sdk/RETypeDB.hpp"
@@ -21,6 +22,8 @@
 #include "bindings/ImGui.hpp"
 #include "bindings/Json.hpp"
 #include "bindings/FS.hpp"
+#include "bindings/TypedArray.hpp"
+#include "bindings/VMath.hpp"
 
 #include "CommitHash.autogenerated"
 #include "ScriptRunner.hpp"
@@ -138,13 +141,16 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data,bool
     bindings::open_imgui(this);
     bindings::open_json(this);
     bindings::open_fs(this);
+    bindings::open_typed_array(this);
+    bindings::open_vmath(this);
 
     auto re = m_lua.create_table();
     re["msg"] = api::re::msg;
     re["on_pre_application_entry"] = [this](const char* name, sol::function fn) { m_pre_application_entry_fns.emplace(utility::hash(name), fn); };
     re["on_application_entry"] = [this](const char* name, sol::function fn) { m_application_entry_fns.emplace(utility::hash(name), fn); };
-    re["on_pre_gui_draw_element"] = [this](sol::function fn) { m_pre_gui_draw_element_fns.emplace_back(fn); };
-    re["on_gui_draw_element"] = [this](sol::function fn) { m_gui_draw_element_fns.emplace_back(fn); };
+    // re.on_pre_gui_draw_element(fn), re.on_pre_gui_draw_element({names={...}}, fn) or re.on_pre_gui_draw_element{names={...}, callback=fn}
+    re["on_pre_gui_draw_element"] = [this](sol::object filter, sol::object fn) { add_gui_draw_element_callback(m_pre_gui_draw_element_fns, filter, fn); };
+    re["on_gui_draw_element"] = [this](sol::object filter, sol::object fn) { add_gui_draw_element_callback(m_gui_draw_element_fns, filter, fn); };
     re["on_draw_ui"] = [this](sol::function fn) { m_on_draw_ui_fns.emplace_back(fn); };
     re["on_frame"] = [this](sol::function fn) { m_on_frame_fns.emplace_back(fn); };
     re["on_script_reset"] = [this](sol::function fn) { m_on_script_reset_fns.emplace_back(fn); };
@@ -431,6 +437,8 @@ void ScriptState::on_frame() {
     try {
         std::scoped_lock _{ m_execution_mutex };
 
+        dispatch_async_results();
+
         for (auto& fn : m_on_frame_fns) {
             handle_protected_result(fn());
         }
@@ -528,14 +536,73 @@ void ScriptState::on_application_entry(size_t hash) {
     }
 }
 
-bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* context) {
+void ScriptState::add_gui_draw_element_callback(std::vector<GUIDrawElementCallback>& callbacks, sol::object filter, sol::object fn) {
+    GUIDrawElementCallback callback{};
+
+    if (filter.is<sol::function>()) {
+        callback.fn = filter.as<sol::protected_function>();
+    } else if (filter.is<sol::table>()) {
+        auto filter_table = filter.as<sol::table>();
+
+        if (fn.is<sol::function>()) {
+            callback.fn = fn.as<sol::protected_function>();
+        } else if (sol::object table_fn = filter_table["callback"]; table_fn.is<sol::function>()) {
+            callback.fn = table_fn.as<sol::protected_function>();
+        } else {
+            throw sol::error("gui draw element callback expects a function");
+        }
+
+        if (sol::object names = filter_table["names"]; names.is<sol::table>()) {
+            for (auto& [_, name] : names.as<sol::table>()) {
+                if (name.is<std::string>()) {
+                    callback.names.insert(utility::hash(name.as<std::string>()));
+                }
+            }
+
+            // A filter that can't match anything would otherwise turn into "every element".
+            if (callback.names.empty()) {
+                return;
+            }
+        }
+    } else {
+        throw sol::error("gui draw element callback expects a function or a filter table");
+    }
+
+    {
+        std::unique_lock _{m_gui_draw_filter_mutex};
+
+        if (callback.names.empty()) {
+            ++m_gui_draw_unfiltered_count;
+        } else {
+            m_gui_draw_filter_names.insert(callback.names.begin(), callback.names.end());
+        }
+    }
+
+    callbacks.emplace_back(std::move(callback));
+}
+
+bool ScriptState::wants_gui_draw_element(size_t name_hash) {
+    std::shared_lock _{m_gui_draw_filter_mutex};
+
+    return m_gui_draw_unfiltered_count > 0 || m_gui_draw_filter_names.contains(name_hash);
+}
+
+bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* context, size_t name_hash) {
     bool any_false = false;
 
+    if (!wants_gui_draw_element(name_hash)) {
+        return true;
+    }
+
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_pre_gui_draw_element_fns) {
-            if (sol::object result = handle_protected_result(fn(gui_element, context)); !result.is<sol::nil_t>() && result.is<bool>() && result.as<bool>() == false) {
+        for (auto& cb : m_pre_gui_draw_element_fns) {
+            if (!cb.names.empty() && !cb.names.contains(name_hash)) {
+                continue;
+            }
+
+            if (sol::object result = handle_protected_result(cb.fn(gui_element, context)); !result.is<sol::nil_t>() && result.is<bool>() && result.as<bool>() == false) {
                 any_false = true;
             }
         }
@@ -548,12 +615,20 @@ bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* contex
     return !any_false;
 }
 
-void ScriptState::on_gui_draw_element(REComponent* gui_element, void* context) {
+void ScriptState::on_gui_draw_element(REComponent* gui_element, void* context, size_t name_hash) {
+    if (!wants_gui_draw_element(name_hash)) {
+        return;
+    }
+
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_gui_draw_element_fns) {
-            handle_protected_result(fn(gui_element, context));
+        for (auto& cb : m_gui_draw_element_fns) {
+            if (!cb.names.empty() && !cb.names.contains(name_hash)) {
+                continue;
+            }
+
+            handle_protected_result(cb.fn(gui_element, context));
         }
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
@@ -593,12 +668,14 @@ catch (const std::exception& e) {
 }
 
 void ScriptState::add_hook(
-    sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj) {
-    m_hooks_to_add.emplace_back((::REManagedObject*)nullptr, fn, pre_cb, post_cb, ignore_jmp_obj);
+    sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj,
+    std::shared_ptr<const HookManager::HookFilter> filter) {
+    m_hooks_to_add.emplace_back((::REManagedObject*)nullptr, fn, pre_cb, post_cb, ignore_jmp_obj, std::move(filter));
 }
 
-void ScriptState::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb) {
-    m_hooks_to_add.emplace_back(obj, fn, pre_cb, post_cb);
+void ScriptState::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb,
+    std::shared_ptr<const HookManager::HookFilter> filter) {
+    m_hooks_to_add.emplace_back(obj, fn, pre_cb, post_cb, sol::object{}, std::move(filter));
 }
 
 void ScriptState::install_hooks() {
@@ -690,7 +767,8 @@ void ScriptState::install_hooks() {
                 } catch (...) {
                     ScriptRunner::get()->spew_error("Unknown exception in post_hook");
                 }
-            }
+            },
+            hookdef.filter
         );
         m_hooks[fn].emplace_back(id);
     }
@@ -737,6 +815,90 @@ void ScriptState::gc_data_changed(GarbageCollectionData data) {
     m_gc_data = data;
 }
 
+uint32_t ScriptState::add_async_callback(sol::object cb) {
+    std::scoped_lock _{m_execution_mutex};
+
+    if (!cb.valid() || cb.is<sol::nil_t>()) {
+        return 0;
+    }
+
+    if (cb.get_type() != sol::type::function && cb.get_type() != sol::type::thread) {
+        throw sol::error{"Async callback must be a function or a coroutine"};
+    }
+
+    auto id = m_next_async_id++;
+
+    if (id == 0) {
+        id = m_next_async_id++;
+    }
+
+    m_async_callbacks[id] = cb;
+    return id;
+}
+
+void ScriptState::dispatch_async_results() {
+    std::scoped_lock _{m_execution_mutex};
+
+    {
+        std::scoped_lock __{m_async_results->mtx};
+
+        if (m_async_results->results.empty()) {
+            return;
+        }
+
+        m_async_results_local.swap(m_async_results->results);
+    }
+
+    sol::state_view sv{m_lua};
+
+    for (auto& result : m_async_results_local) {
+        auto it = m_async_callbacks.find(result.id);
+
+        if (it == m_async_callbacks.end()) {
+            continue;
+        }
+
+        auto cb = std::move(it->second);
+        m_async_callbacks.erase(it);
+
+        try {
+            auto args = result.make_args(sv);
+
+            if (cb.get_type() == sol::type::thread) {
+                auto co = cb.as<sol::thread>().thread_state();
+
+                if (lua_status(co) != LUA_YIELD) {
+                    ScriptRunner::get()->spew_error("Async result delivered to a coroutine that is not suspended");
+                    continue;
+                }
+
+                for (auto& arg : args) {
+                    arg.push(co);
+                }
+
+                int nresults{};
+                const auto status = lua_resume(co, m_lua.lua_state(), (int)args.size(), &nresults);
+
+                if (status != LUA_OK && status != LUA_YIELD) {
+                    std::string err = lua_isstring(co, -1) ? lua_tostring(co, -1) : "Unknown error in coroutine";
+                    lua_pop(co, 1);
+                    ScriptRunner::get()->spew_error(err);
+                } else {
+                    lua_pop(co, nresults);
+                }
+            } else {
+                handle_protected_result(cb.as<sol::protected_function>()(sol::as_args(args)));
+            }
+        } catch (const std::exception& e) {
+            ScriptRunner::get()->spew_error(e.what());
+        } catch (...) {
+            ScriptRunner::get()->spew_error("Unknown error in async callback");
+        }
+    }
+
+    m_async_results_local.clear();
+}
+
 std::shared_ptr<ScriptRunner>& ScriptRunner::get() {
     static auto instance = std::make_shared<ScriptRunner>();
     return instance;
@@ -782,6 +944,17 @@ void ScriptRunner::on_config_save(utility::Config& cfg) {
     }
 }
 
+bool ScriptRunner::is_config_dirty() {
+    std::scoped_lock _{m_access_mutex};
+
+    if (m_last_online_match_state) {
+        return false;
+    }
+
+    // Scripts expect their on_config_save callbacks to run whenever the config gets saved.
+    return is_any_dirty(m_options) || (m_main_state != nullptr && m_main_state->has_on_config_save_fns());
+}
+
 void ScriptRunner::hook_battle_rule() {
     if (m_attempted_hook_battle_rule) {
         return;
@@ -1118,10 +1291,13 @@ bool ScriptRunner::on_pre_gui_draw_element(REComponent* gui_element, void* primi
         return true;
     }
 
+    const auto gui_entry = sdk::GUIElementCache::get().lookup(gui_element);
+    const auto name_hash = gui_entry != nullptr ? gui_entry->name_hash : 0;
+
     bool any_false = false;
 
     for (auto& state : m_states) {
-        if (!state->on_pre_gui_draw_element(gui_element, primitive_context)) {
+        if (!state->on_pre_gui_draw_element(gui_element, primitive_context, name_hash)) {
             any_false = true;
         }
     }
@@ -1140,8 +1316,11 @@ void ScriptRunner::on_gui_draw_element(REComponent* gui_element, void* primitive
         return;
     }
 
+    const auto gui_entry = sdk::GUIElementCache::get().lookup(gui_element);
+    const auto name_hash = gui_entry != nullptr ? gui_entry->name_hash : 0;
+
     for (auto &state : m_states) {
-        state->on_gui_draw_element(gui_element, primitive_context);
+        state->on_gui_draw_element(gui_element, primitive_context, name_hash);
     }
 }
 
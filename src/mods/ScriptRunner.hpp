@@ -3,9 +3,11 @@
 #include <deque>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <mutex>
 #include <deque>
+#include <functional>
 #include <shared_mutex>
 
 #include <Windows.h>
@@ -126,6 +128,19 @@ public:
         uint32_t gc_major_multiplier{100};
     };
 
+    // Results of jobs that ran off the script thread (e.g. fs.read_async).
+    // make_args is invoked on the script thread to build the callback arguments,
+    // so the worker never touches the Lua state.
+    struct AsyncResult {
+        uint32_t id{};
+        std::function<std::vector<sol::object>(sol::state_view&)> make_args{};
+    };
+
+    struct AsyncResultQueue {
+        std::mutex mtx{};
+        std::vector<AsyncResult> results{};
+    };
+
     ScriptState(const GarbageCollectionData& gc_data,bool is_main_state);
     ~ScriptState();
 
@@ -136,10 +151,16 @@ public:
     void on_draw_ui();
     void on_pre_application_entry(size_t hash);
     void on_application_entry(size_t hash);
-    bool on_pre_gui_draw_element(REComponent* gui_element, void* primitive_context);
-    void on_gui_draw_element(REComponent* gui_element, void* primitive_context);
+    bool on_pre_gui_draw_element(REComponent* gui_element, void* primitive_context, size_t name_hash);
+    void on_gui_draw_element(REComponent* gui_element, void* primitive_context, size_t name_hash);
+
+    // Whether any gui draw callback would run for an element with this GameObject name hash.
+    // Doesn't take the execution mutex.
+    bool wants_gui_draw_element(size_t name_hash);
+
     void on_script_reset();
     void on_config_save();
+    bool has_on_config_save_fns() const { return !m_on_config_save_fns.empty(); }
     bool is_main_state() { return m_is_main_state; }
     auto& lua() { return m_lua; }
     void lock() { m_execution_mutex.lock(); }
@@ -147,14 +168,27 @@ public:
     auto scoped_lock() { return std::scoped_lock{m_execution_mutex}; }
 
     // add_hook enqueues the hook definition to be installed the next time install_hooks is called.
-    void add_hook(sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj);
-    void add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb);
+    // filter is checked by HookManager before any of the callbacks get called, calls that don't match never reach Lua.
+    void add_hook(sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj,
+        std::shared_ptr<const HookManager::HookFilter> filter = nullptr);
+    void add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb,
+        std::shared_ptr<const HookManager::HookFilter> filter = nullptr);
 
     // install_hooks goes through the queue of added hooks and actually creates them. The queue is emptied as a result.
     void install_hooks();
 
     void gc_data_changed(GarbageCollectionData data);
 
+    // Registers a function or coroutine to be called/resumed with the result of an async job.
+    // Returns 0 if cb is nil (the result is discarded).
+    uint32_t add_async_callback(sol::object cb);
+
+    // The queue is shared with the worker so it can outlive the state while a job is in flight.
+    auto get_async_results() const { return m_async_results; }
+
+    // Called from on_frame. Delivers completed async results to their callbacks.
+    void dispatch_async_results();
+
     /*sol::table get_thread_storage(size_t hash) {
         auto it = m_thread_storage.find(hash);
         if (it == m_thread_storage.end()) {
@@ -213,8 +247,20 @@ private:
     std::unordered_multimap<size_t, sol::protected_function> m_pre_application_entry_fns{};
     std::unordered_multimap<size_t, sol::protected_function> m_application_entry_fns{};
 
-    std::vector<sol::protected_function> m_pre_gui_draw_element_fns{};
-    std::vector<sol::protected_function> m_gui_draw_element_fns{};
+    struct GUIDrawElementCallback {
+        sol::protected_function fn{};
+        std::unordered_set<size_t> names{}; // GameObject name hashes, empty for every element
+    };
+
+    void add_gui_draw_element_callback(std::vector<GUIDrawElementCallback>& callbacks, sol::object filter, sol::object fn);
+
+    std::vector<GUIDrawElementCallback> m_pre_gui_draw_element_fns{};
+    std::vector<GUIDrawElementCallback> m_gui_draw_element_fns{};
+
+    // Union of every gui draw callback's filter, checked from the gui thread before locking.
+    std::shared_mutex m_gui_draw_filter_mutex{};
+    std::unordered_set<size_t> m_gui_draw_filter_names{};
+    uint32_t m_gui_draw_unfiltered_count{0};
     std::vector<sol::protected_function> m_on_draw_ui_fns{};
     std::vector<sol::protected_function> m_on_frame_fns{};
     std::vector<sol::protected_function> m_on_script_reset_fns{};
@@ -226,6 +272,7 @@ private:
         sol::protected_function pre_cb;
         sol::protected_function post_cb;
         sol::object ignore_jmp_obj;
+        std::shared_ptr<const HookManager::HookFilter> filter{};
     };
 
     std::deque<HookDef> m_hooks_to_add{};
@@ -233,6 +280,11 @@ private:
 
     std::unordered_map<size_t, std::deque<sol::table>> m_hook_storage{};
     sol::reference m_current_hook_storage{};
+
+    std::shared_ptr<AsyncResultQueue> m_async_results{std::make_shared<AsyncResultQueue>()};
+    std::unordered_map<uint32_t, sol::object> m_async_callbacks{};
+    std::vector<AsyncResult> m_async_results_local{};
+    uint32_t m_next_async_id{1};
 };
 
 class ScriptRunner : public Mod {
@@ -243,6 +295,7 @@ public:
     std::optional<std::string> on_initialize() override;
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override;
 
     void hook_battle_rule();
     void set_last_battle_type(uint8_t t) {
@@ -41,6 +41,7 @@
 #include "sdk/RETypeDB.hpp"
 #include "sdk/Renderer.hpp"
 #include "sdk/Application.hpp"
+#include "sdk/GUIElementCache.hpp"
 #include "sdk/Renderer.hpp"
 #include "sdk/REMath.hpp"
 
@@ -823,6 +824,9 @@ std::optional<std::string> VR::initialize_openvr() {
     m_openvr->error = std::nullopt;
     m_runtime = m_openvr;
 
+    // The runtime may have been recreated, carry the pose processing settings over.
+    update_pose_processing();
+
     return Mod::on_initialize();
 }
 
@@ -1054,6 +1058,7 @@ std::optional<std::string> VR::initialize_openxr() {
 
     m_openxr->loaded = true;
     m_runtime = m_openxr;
+    update_pose_processing();
 
     if (auto err = initialize_openxr_input()) {
         m_openxr->error = err.value();
@@ -2159,15 +2164,11 @@ Vector4f VR::get_current_offset() {
         return Vector4f{};
     }
 
-    std::shared_lock _{ get_runtime()->eyes_mtx };
+    const auto eye = m_frame_count % 2 == m_left_eye_interval ? vr::Eye_Left : vr::Eye_Right;
 
-    if (m_frame_count % 2 == m_left_eye_interval) {
-        //return Vector4f{m_eye_distance * -1.0f, 0.0f, 0.0f, 0.0f};
-        return get_runtime()->eyes[vr::Eye_Left][3];
-    }
-    
-    return get_runtime()->eyes[vr::Eye_Right][3];
-    //return Vector4f{m_eye_distance, 0.0f, 0.0f, 0.0f};
+    return get_runtime()->pose_snapshot.read([eye](const PoseFrame& frame) {
+        return frame.eyes[eye][3];
+    });
 }
 
 Matrix4x4f VR::get_current_eye_transform(bool flip) {
@@ -2175,15 +2176,12 @@ Matrix4x4f VR::get_current_eye_transform(bool flip) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
-
     auto mod_count = flip ? m_right_eye_interval : m_left_eye_interval;
+    const auto eye = m_frame_count % 2 == mod_count ? vr::Eye_Left : vr::Eye_Right;
 
-    if (m_frame_count % 2 == mod_count) {
-        return get_runtime()->eyes[vr::Eye_Left];
-    }
-
-    return get_runtime()->eyes[vr::Eye_Right];
+    return get_runtime()->pose_snapshot.read([eye](const PoseFrame& frame) {
+        return frame.eyes[eye];
+    });
 }
 
 Matrix4x4f VR::get_current_projection_matrix(bool flip) {
@@ -2191,15 +2189,12 @@ Matrix4x4f VR::get_current_projection_matrix(bool flip) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
-
     auto mod_count = flip ? m_right_eye_interval : m_left_eye_interval;
+    const auto eye = m_frame_count % 2 == mod_count ? VRRuntime::Eye::LEFT : VRRuntime::Eye::RIGHT;
 
-    if (m_frame_count % 2 == mod_count) {
-        return get_runtime()->projections[(uint32_t)VRRuntime::Eye::LEFT];
-    }
-
-    return get_runtime()->projections[(uint32_t)VRRuntime::Eye::RIGHT];
+    return get_runtime()->pose_snapshot.read([eye](const PoseFrame& frame) {
+        return frame.projections[(uint32_t)eye];
+    });
 }
 
 void VR::on_pre_imgui_frame() {
@@ -2363,8 +2358,8 @@ bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_conte
     if (game_object != nullptr && game_object->transform != nullptr) {
         auto context = sdk::get_thread_context();
 
-        const auto name = utility::re_string::get_string(game_object->name);
-        const auto name_hash = utility::hash(name);
+        const auto gui_entry = sdk::GUIElementCache::get().lookup(gui_element);
+        const auto name_hash = gui_entry != nullptr ? gui_entry->name_hash : 0;
 
         switch (name_hash) {
         // Don't mess with this, causes weird black boxes on the sides of the screen
@@ -2431,8 +2426,8 @@ bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_conte
         }
 #endif
 
-        //spdlog::info("VR: on_pre_gui_draw_element: {}", name);
-        //spdlog::info("VR: on_pre_gui_draw_element: {} {:x}", name, (uintptr_t)game_object);
+        //spdlog::info("VR: on_pre_gui_draw_element: {}", gui_entry->name);
+        //spdlog::info("VR: on_pre_gui_draw_element: {} {:x}", gui_entry->name, (uintptr_t)game_object);
 
         auto view = sdk::call_object_func<REComponent*>(gui_element, "get_View", context, gui_element);
 
@@ -2454,7 +2449,21 @@ bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_conte
                 // we don't want to mess with any game object that has a mesh
                 // because it might be something physical in the game world
                 // that the player can interact with
-                if (utility::re_component::find(game_object->transform, via_render_mesh_typedef->get_type()) != nullptr) {
+                static const auto has_mesh_slot = sdk::GUIElementCache::allocate_slot();
+                enum : uint8_t { MESH_UNKNOWN, MESH_NONE, MESH_FOUND };
+
+                auto has_mesh = gui_entry != nullptr && has_mesh_slot < sdk::GUIElementCache::MAX_SLOTS ? 
+                                gui_entry->slots[has_mesh_slot].load(std::memory_order_relaxed) : (uint8_t)MESH_UNKNOWN;
+
+                if (has_mesh == MESH_UNKNOWN) {
+                    has_mesh = utility::re_component::find(game_object->transform, via_render_mesh_typedef->get_type()) != nullptr ? MESH_FOUND : MESH_NONE;
+
+                    if (gui_entry != nullptr && has_mesh_slot < sdk::GUIElementCache::MAX_SLOTS) {
+                        gui_entry->slots[has_mesh_slot].store(has_mesh, std::memory_order_relaxed);
+                    }
+                }
+
+                if (has_mesh == MESH_FOUND) {
                     return true;
                 }
 
@@ -3784,6 +3793,50 @@ void VR::on_draw_ui() {
     m_motion_controls_inactivity_timer->draw("Inactivity Timer");
     m_joystick_deadzone->draw("Joystick Deadzone");
 
+    if (ImGui::TreeNode("Pose Processing")) {
+        auto changed = m_pose_processing->draw("Enabled");
+
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Applies to controllers and trackers, the headset pose is left to the runtime.");
+        }
+
+        changed |= m_pose_smoothing->draw("Smoothing");
+        changed |= m_pose_prediction_ms->draw("Prediction (ms)");
+        changed |= m_pose_reject_outliers->draw("Reject Tracking Glitches");
+
+        if (changed) {
+            update_pose_processing();
+        }
+
+        const auto stats = [&]() {
+            std::scoped_lock _{ get_runtime()->pose_processor_mtx };
+            return get_runtime()->pose_processor.get_total_stats();
+        }();
+
+        ImGui::Text("Samples: %llu, rejected: %llu, resets: %llu", (unsigned long long)stats.samples, (unsigned long long)stats.rejected, (unsigned long long)stats.resets);
+
+        auto& recorder = get_runtime()->pose_recorder;
+
+        if (!recorder.is_open()) {
+            if (ImGui::Button("Start Pose Recording")) {
+                const auto path = REFramework::get_persistent_dir() / "reframework" / "pose_recording.vrpose";
+
+                if (!recorder.open(path)) {
+                    spdlog::error("[VR] Failed to open {} for pose recording", path.string());
+                }
+            }
+        } else {
+            if (ImGui::Button("Stop Pose Recording")) {
+                recorder.close();
+            }
+
+            ImGui::SameLine();
+            ImGui::Text("%llu samples", (unsigned long long)recorder.get_sample_count());
+        }
+
+        ImGui::TreePop();
+    }
+
     m_ui_scale_option->draw("2D UI Scale");
     m_ui_distance_option->draw("2D UI Distance");
     m_world_ui_scale_option->draw("World-Space UI Scale");
@@ -3882,6 +3935,8 @@ void VR::on_config_load(const utility::Config& cfg) {
     if (m_motion_controls_inactivity_timer->value() <= 10.0f) {
         m_motion_controls_inactivity_timer->value() = 30.0f;
     }
+
+    update_pose_processing();
 }
 
 void VR::on_config_save(utility::Config& cfg) {
@@ -3890,35 +3945,50 @@ void VR::on_config_save(utility::Config& cfg) {
     }
 }
 
-Vector4f VR::get_position(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
+void VR::update_pose_processing() {
+    vrpose::Settings settings{};
+    settings.smoothing = (vrpose::Smoothing)m_pose_smoothing->value();
+    settings.prediction_ms = m_pose_prediction_ms->value();
+    settings.reject_outliers = m_pose_reject_outliers->value();
+
+    for (VRRuntime* runtime : {(VRRuntime*)m_openvr.get(), (VRRuntime*)m_openxr.get()}) {
+        if (runtime == nullptr) {
+            continue;
+        }
+
+        runtime->set_pose_processor_settings(settings);
+        runtime->pose_processing_enabled = m_pose_processing->value();
     }
+}
 
-    std::shared_lock _{ get_runtime()->pose_mtx };
-    std::shared_lock __{ get_runtime()->eyes_mtx };
+Vector4f VR::get_position(uint32_t index) const {
+    return get_runtime()->pose_snapshot.read([index](const PoseFrame& frame) {
+        if (index >= frame.num_devices || !frame.devices[index].located) {
+            return Vector4f{};
+        }
 
-    return get_position_unsafe(index);
+        return frame.devices[index].transform[3];
+    });
 }
 
 Vector4f VR::get_velocity(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
-    }
-
-    std::shared_lock _{ get_runtime()->pose_mtx };
+    return get_runtime()->pose_snapshot.read([index](const PoseFrame& frame) {
+        if (index >= frame.num_devices || !frame.devices[index].located) {
+            return Vector4f{};
+        }
 
-    return get_velocity_unsafe(index);
+        return frame.devices[index].velocity;
+    });
 }
 
 Vector4f VR::get_angular_velocity(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
-    }
-
-    std::shared_lock _{ get_runtime()->pose_mtx };
+    return get_runtime()->pose_snapshot.read([index](const PoseFrame& frame) {
+        if (index >= frame.num_devices || !frame.devices[index].located) {
+            return Vector4f{};
+        }
 
-    return get_angular_velocity_unsafe(index);
+        return frame.devices[index].angular_velocity;
+    });
 }
 
 Vector4f VR::get_position_unsafe(uint32_t index) const {
@@ -4004,71 +4074,19 @@ Vector4f VR::get_angular_velocity_unsafe(uint32_t index) const {
 }
 
 Matrix4x4f VR::get_rotation(uint32_t index) const {
-    if (get_runtime()->is_openvr()) {
-        if (index >= vr::k_unMaxTrackedDeviceCount) {
-            return glm::identity<Matrix4x4f>();
-        }
-
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        auto& pose = get_openvr_poses()[index];
-        auto matrix = Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking };
-        return glm::extractMatrixRotation(glm::rowMajor4(matrix));
-    } else if (get_runtime()->is_openxr()) {
-        std::shared_lock _{ get_runtime()->pose_mtx };
-        std::shared_lock __{ get_runtime()->eyes_mtx };
+    const auto transform = get_transform(index);
 
-        // HMD rotation
-        if (index == 0 && !m_openxr->stage_views.empty()) {
-            return Matrix4x4f{*(glm::quat*)&m_openxr->view_space_location.pose.orientation};
-            //return Matrix4x4f{*(glm::quat*)&m_openxr->stage_views[0].pose.orientation};
-        } else if (index > 0) {
-            if (index == VRRuntime::Hand::LEFT+1) {
-                return Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.orientation};
-            } else if (index == VRRuntime::Hand::RIGHT+1) {
-                return Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.orientation};
-            }
-        }
-
-        return glm::identity<Matrix4x4f>();
-    }
-
-    return glm::identity<Matrix4x4f>();
+    return glm::extractMatrixRotation(transform);
 }
 
 Matrix4x4f VR::get_transform(uint32_t index) const {
-    if (get_runtime()->is_openvr()) {
-        if (index >= vr::k_unMaxTrackedDeviceCount) {
+    return get_runtime()->pose_snapshot.read([index](const PoseFrame& frame) {
+        if (index >= frame.num_devices || !frame.devices[index].located) {
             return glm::identity<Matrix4x4f>();
         }
 
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        auto& pose = get_openvr_poses()[index];
-        auto matrix = Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking };
-        return glm::rowMajor4(matrix);
-    } else if (get_runtime()->is_openxr()) {
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        // HMD rotation
-        if (index == 0 && !m_openxr->stage_views.empty()) {
-            auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->view_space_location.pose.orientation};
-            mat[3] = Vector4f{*(Vector3f*)&m_openxr->view_space_location.pose.position, 1.0f};
-            return mat;
-        } else if (index > 0) {
-            if (index == VRRuntime::Hand::LEFT+1) {
-                auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.orientation};
-                mat[3] = Vector4f{*(Vector3f*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.position, 1.0f};
-                return mat;
-            } else if (index == VRRuntime::Hand::RIGHT+1) {
-                auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.orientation};
-                mat[3] = Vector4f{*(Vector3f*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.position, 1.0f};
-                return mat;
-            }
-        }
-    }
-
-    return glm::identity<Matrix4x4f>();
+        return frame.devices[index].transform;
+    });
 }
 
 vr::HmdMatrix34_t VR::get_raw_transform(uint32_t index) const {
@@ -56,6 +56,7 @@ public:
 
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     // Application entries
     void on_pre_update_hid(void* entry);
@@ -156,6 +157,11 @@ public:
     Matrix4x4f get_transform(uint32_t index) const;
     vr::HmdMatrix34_t get_raw_transform(uint32_t index) const;
 
+    // Consistent copy of every device pose plus the eye matrices, without locking.
+    PoseFrame get_pose_frame() const {
+        return get_runtime()->pose_snapshot.get();
+    }
+
     const auto& get_eyes() const {
         return get_runtime()->eyes;
     }
@@ -205,6 +211,9 @@ private:
     Vector4f get_velocity_unsafe(uint32_t index) const;
     Vector4f get_angular_velocity_unsafe(uint32_t index) const;
 
+    // Pushes the pose processing options down to the runtimes.
+    void update_pose_processing();
+
 private:
     // Hooks
     void on_view_get_size(REManagedObject* scene_view, float* result) override;
@@ -505,6 +514,17 @@ private:
     const ModSlider::Ptr m_world_ui_scale_option{ ModSlider::create(generate_name("WorldSpaceUIScale"), 1.0f, 100.0f, 15.0f) };
     const ModSlider::Ptr m_resolution_scale{ ModSlider::create(generate_name("OpenXRResolutionScale"), 0.1f, 5.0f, 1.0f) };
 
+    static inline std::vector<std::string> s_pose_smoothing_names{
+        "None",
+        "One Euro",
+        "Kalman",
+    };
+
+    const ModToggle::Ptr m_pose_processing{ ModToggle::create(generate_name("PoseProcessing"), false) };
+    const ModCombo::Ptr m_pose_smoothing{ ModCombo::create(generate_name("PoseSmoothing"), s_pose_smoothing_names) };
+    const ModSlider::Ptr m_pose_prediction_ms{ ModSlider::create(generate_name("PosePredictionMs"), 0.0f, 40.0f, 0.0f) };
+    const ModToggle::Ptr m_pose_reject_outliers{ ModToggle::create(generate_name("PoseRejectOutliers"), true) };
+
     const ModToggle::Ptr m_force_fps_settings{ ModToggle::create(generate_name("ForceFPS"), true) };
     const ModToggle::Ptr m_force_aa_settings{ ModToggle::create(generate_name("ForceAntiAliasing"), true) };
     const ModToggle::Ptr m_force_motionblur_settings{ ModToggle::create(generate_name("ForceMotionBlur"), true) };
@@ -559,6 +579,10 @@ private:
         *m_world_ui_scale_option,
         *m_allow_engine_overlays,
         *m_resolution_scale,
+        *m_pose_processing,
+        *m_pose_smoothing,
+        *m_pose_prediction_ms,
+        *m_pose_reject_outliers,
         *m_desktop_fix,
         *m_desktop_fix_skip_present,
         *m_enable_asynchronous_rendering
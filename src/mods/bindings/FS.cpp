@@ -2,6 +2,11 @@
 #include <regex>
 #include <fstream>
 #include <filesystem>
+#include <condition_variable>
+#include <algorithm>
+#include <cctype>
+
+#include <spdlog/spdlog.h>
 
 #include "../ScriptRunner.hpp"
 
@@ -9,8 +14,282 @@
 
 namespace fs = std::filesystem;
 
+std::optional<::fs::path> get_correct_subpath(sol::this_state l, const std::string& filepath);
+
 namespace api::fs {
 namespace detail {
+// Single background thread for Lua file I/O. Jobs run in submission order so
+// a write_async followed by a read_async of the same file behaves as expected.
+class IoWorker {
+public:
+    static IoWorker& get() {
+        // Intentionally leaked, the thread can still be blocked on the queue when the DLL unloads.
+        static auto worker = new IoWorker();
+        return *worker;
+    }
+
+    void submit(std::function<void()> job) {
+        {
+            std::scoped_lock _{m_mtx};
+            m_jobs.push_back(std::move(job));
+        }
+
+        m_cv.notify_one();
+    }
+
+private:
+    IoWorker() {
+        std::thread{[this] { run(); }}.detach();
+    }
+
+    void run() {
+        while (true) {
+            std::function<void()> job{};
+
+            {
+                std::unique_lock lock{m_mtx};
+                m_cv.wait(lock, [this] { return !m_jobs.empty(); });
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            try {
+                job();
+            } catch (const std::exception& e) {
+                spdlog::error("[FS] I/O job failed: {}", e.what());
+            } catch (...) {
+                spdlog::error("[FS] I/O job failed: unknown exception");
+            }
+        }
+    }
+
+    std::mutex m_mtx{};
+    std::condition_variable m_cv{};
+    std::deque<std::function<void()>> m_jobs{};
+};
+
+// Lowercase with forward slashes, used for case-insensitive prefix and wildcard matching.
+std::string make_key(std::string_view path) {
+    std::string out{path};
+
+    for (auto& c : out) {
+        if (c == '\\') {
+            c = '/';
+        } else if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+    }
+
+    return out;
+}
+
+// Sorted list of every file below a data directory. Rebuilt only when the
+// directory tree reports a change, or when we wrote a file ourselves.
+class DirectoryIndex {
+public:
+    struct Entry {
+        std::string relpath{};
+        std::string key{};
+    };
+
+    DirectoryIndex(::fs::path root)
+        : m_root{std::move(root)}
+    {
+    }
+
+    ~DirectoryIndex() {
+        if (m_change_handle != INVALID_HANDLE_VALUE) {
+            FindCloseChangeNotification(m_change_handle);
+        }
+    }
+
+    void invalidate() {
+        m_dirty = true;
+    }
+
+    void refresh() {
+        if (m_change_handle == INVALID_HANDLE_VALUE) {
+            m_change_handle = FindFirstChangeNotificationW(m_root.c_str(), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+            m_dirty = true;
+        } else if (WaitForSingleObject(m_change_handle, 0) == WAIT_OBJECT_0) {
+            // Re-arm before rebuilding so changes made during the rebuild are not lost.
+            FindNextChangeNotification(m_change_handle);
+            m_dirty = true;
+        }
+
+        // No notification handle means we can't tell when things change, so always rebuild.
+        if (!m_dirty && m_change_handle != INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        m_entries.clear();
+
+        std::error_code ec{};
+
+        for (auto it = ::fs::recursive_directory_iterator{m_root, ::fs::directory_options::skip_permission_denied, ec}; 
+            !ec && it != ::fs::recursive_directory_iterator{}; 
+            it.increment(ec)) 
+        {
+            const auto& entry = *it;
+
+            if (!entry.is_regular_file() && !entry.is_symlink()) {
+                continue;
+            }
+
+            auto relpath = relative(entry.path(), m_root).string();
+            auto key = make_key(relpath);
+            m_entries.push_back({std::move(relpath), std::move(key)});
+        }
+
+        std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        m_dirty = false;
+    }
+
+    // key_prefix must already be in key form (see make_key).
+    template<typename T>
+    void for_each_with_prefix(std::string_view key_prefix, T&& fn) const {
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key_prefix, [](const Entry& e, std::string_view p) { return e.key < p; });
+
+        for (; it != m_entries.end() && it->key.starts_with(key_prefix); ++it) {
+            fn(*it);
+        }
+    }
+
+private:
+    ::fs::path m_root{};
+    HANDLE m_change_handle{INVALID_HANDLE_VALUE};
+    std::vector<Entry> m_entries{};
+    bool m_dirty{true};
+};
+
+std::mutex g_index_mtx{};
+std::unordered_map<std::wstring, std::unique_ptr<DirectoryIndex>> g_indices{};
+std::unordered_map<std::string, std::regex> g_regex_cache{};
+constexpr size_t MAX_CACHED_REGEXES = 64;
+
+// Caller must hold g_index_mtx.
+DirectoryIndex& get_index(const ::fs::path& root) {
+    auto& index = g_indices[root.wstring()];
+
+    if (index == nullptr) {
+        index = std::make_unique<DirectoryIndex>(root);
+    }
+
+    index->refresh();
+    return *index;
+}
+
+// Caller must hold g_index_mtx.
+const std::regex& get_regex(const std::string& filter) {
+    if (auto it = g_regex_cache.find(filter); it != g_regex_cache.end()) {
+        return it->second;
+    }
+
+    if (g_regex_cache.size() >= MAX_CACHED_REGEXES) {
+        g_regex_cache.clear();
+    }
+
+    return g_regex_cache.emplace(filter, std::regex{filter}).first->second;
+}
+
+// The literal text every match of the regex must start with, in key form.
+// Conservative: anything we don't understand ends the prefix.
+std::string get_regex_literal_prefix(std::string_view filter) {
+    if (filter.find('|') != std::string_view::npos) {
+        return "";
+    }
+
+    std::string out{};
+    size_t i = 0;
+
+    if (!filter.empty() && filter[0] == '^') {
+        ++i;
+    }
+
+    for (; i < filter.size(); ++i) {
+        const auto c = filter[i];
+
+        if (c == '\\') {
+            if (i + 1 >= filter.size() || std::isalnum((unsigned char)filter[i + 1])) {
+                break;
+            }
+
+            out += filter[++i];
+            continue;
+        }
+
+        if (c == '*' || c == '?' || c == '{') {
+            // The previous character is optional or repeated.
+            if (!out.empty()) {
+                out.pop_back();
+            }
+
+            break;
+        }
+
+        if (std::string_view{".[](){}+^$"}.find(c) != std::string_view::npos) {
+            break;
+        }
+
+        out += c;
+    }
+
+    return make_key(out);
+}
+
+// * matches within a path component, ** matches across them, **/ also matches zero directories, ? matches one character.
+// Both arguments are in key form.
+bool wildcard_match(std::string_view pattern, std::string_view str) {
+    const auto n = str.size();
+    std::vector<uint8_t> cur(n + 1, 0);
+    std::vector<uint8_t> next(n + 1, 0);
+    cur[0] = 1;
+
+    for (size_t i = 0; i < pattern.size();) {
+        const auto c = pattern[i];
+
+        if (c == '*') {
+            const auto globstar = i + 1 < pattern.size() && pattern[i + 1] == '*';
+            const auto globstar_dir = globstar && i + 2 < pattern.size() && pattern[i + 2] == '/';
+
+            i += globstar_dir ? 3 : (globstar ? 2 : 1);
+
+            bool carry = false;
+
+            for (size_t j = 0; j <= n; ++j) {
+                if (globstar_dir) {
+                    next[j] = cur[j] || (j > 0 && str[j - 1] == '/' && carry);
+                    carry = carry || cur[j];
+                    continue;
+                }
+
+                carry = carry || cur[j];
+                next[j] = carry;
+
+                if (j < n && !globstar && str[j] == '/') {
+                    carry = false;
+                }
+            }
+        } else {
+            ++i;
+            next[0] = 0;
+
+            for (size_t j = 1; j <= n; ++j) {
+                next[j] = cur[j - 1] && (c == '?' ? str[j - 1] != '/' : str[j - 1] == c);
+            }
+        }
+
+        cur.swap(next);
+
+        if (std::find(cur.begin(), cur.end(), 1) == cur.end()) {
+            return false;
+        }
+    }
+
+    return cur[n] != 0;
+}
+
 ::fs::path get_datadir(std::string wanted_subdir = "") {
     std::string modpath{};
 
@@ -62,24 +341,96 @@ namespace detail {
 }
 }
 
+void submit_io(std::function<void()> job) {
+    detail::IoWorker::get().submit(std::move(job));
+}
+
+void queue_async(sol::this_state l, sol::object callback, std::function<AsyncArgs()> job) {
+    auto state = sol::state_view{l}.registry()["state"].get<ScriptState*>();
+    const auto id = state->add_async_callback(callback);
+
+    submit_io([results = state->get_async_results(), id, job = std::move(job)]() {
+        AsyncArgs make_args{};
+
+        try {
+            make_args = job();
+        } catch (const std::exception& e) {
+            make_args = [err = std::string{e.what()}](sol::state_view& sv) {
+                return std::vector<sol::object>{sol::make_object(sv, sol::nil), sol::make_object(sv, err)};
+            };
+        }
+
+        if (id == 0) {
+            return;
+        }
+
+        std::scoped_lock _{results->mtx};
+        results->results.push_back({id, std::move(make_args)});
+    });
+}
+
+void invalidate_index() {
+    std::scoped_lock _{detail::g_index_mtx};
+
+    for (auto& [root, index] : detail::g_indices) {
+        index->invalidate();
+    }
+}
+
+// Regex matching on the relative path, same as it always was.
+// The index narrows the candidates down to the regex's literal prefix first.
 sol::table glob(sol::this_state l, const char* filter, const char* modifier) {
     sol::state_view state{l};
-    std::regex filter_regex{filter};
     auto results = state.create_table();
     auto datadir = detail::get_datadir(modifier != nullptr ? modifier : "");
     auto i = 0;
 
-    for (const auto& entry : ::fs::recursive_directory_iterator{datadir}) {
-        if (!entry.is_regular_file() && !entry.is_symlink()) {
-            continue;
+    std::scoped_lock _{detail::g_index_mtx};
+
+    const auto& filter_regex = detail::get_regex(filter);
+    const auto prefix = detail::get_regex_literal_prefix(filter);
+
+    detail::get_index(datadir).for_each_with_prefix(prefix, [&](const detail::DirectoryIndex::Entry& entry) {
+        if (std::regex_match(entry.relpath, filter_regex)) {
+            results[++i] = entry.relpath;
         }
+    });
+
+    return results;
+}
+
+// Wildcard matching (*, **, ?), case-insensitive and accepting either slash.
+sol::table match(sol::this_state l, const char* pattern, const char* modifier) {
+    sol::state_view state{l};
+    auto results = state.create_table();
+    auto datadir = detail::get_datadir(modifier != nullptr ? modifier : "");
+    const auto key_pattern = detail::make_key(pattern);
+    const auto prefix = key_pattern.substr(0, key_pattern.find_first_of("*?"));
+    auto i = 0;
 
-        auto relpath = relative(entry.path(), datadir).string();
+    std::scoped_lock _{detail::g_index_mtx};
 
-        if (std::regex_match(relpath, filter_regex)) {
-            results[++i] = relpath;
+    detail::get_index(datadir).for_each_with_prefix(prefix, [&](const detail::DirectoryIndex::Entry& entry) {
+        if (detail::wildcard_match(key_pattern, entry.key)) {
+            results[++i] = entry.relpath;
         }
-    }
+    });
+
+    return results;
+}
+
+// Every file whose relative path starts with prefix, case-insensitive.
+sol::table list(sol::this_state l, const char* prefix, const char* modifier) {
+    sol::state_view state{l};
+    auto results = state.create_table();
+    auto datadir = detail::get_datadir(modifier != nullptr ? modifier : "");
+    auto i = 0;
+
+    std::scoped_lock _{detail::g_index_mtx};
+
+    detail::get_index(datadir).for_each_with_prefix(detail::make_key(prefix != nullptr ? prefix : ""), [&](const detail::DirectoryIndex::Entry& entry) {
+        results[++i] = entry.relpath;
+    });
 
     return results;
 }
@@ -107,9 +458,17 @@ void write(sol::this_state l, const std::string& filepath, const std::string& da
 
     ::fs::create_directories(path.parent_path());
 
-    std::ofstream file{path};
+    const auto existed = exists(path);
+
+    {
+        std::ofstream file{path};
+
+        file << data;
+    }
 
-    file << data;
+    if (!existed) {
+        invalidate_index();
+    }
 }
 
 std::string read(sol::this_state l, const std::string& filepath) {
@@ -144,6 +503,68 @@ std::string read(sol::this_state l, const std::string& filepath) {
     buffer << file.rdbuf();
     return buffer.str();
 }
+
+// Same as read, but the file is read on the I/O worker.
+// callback (function or coroutine) receives the contents, or nil and an error message.
+void read_async(sol::this_state l, const std::string& filepath, sol::object callback) {
+    auto path = get_correct_subpath(l, filepath);
+
+    if (!path) {
+        return;
+    }
+
+    queue_async(l, callback, [path = std::move(*path)]() -> AsyncArgs {
+        std::string data{};
+
+        if (exists(path)) {
+            std::ifstream file{path, std::ios::binary};
+
+            if (!file) {
+                throw std::runtime_error{"fs.read_async: failed to open " + path.string()};
+            }
+
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            data = buffer.str();
+        }
+
+        return [data = std::move(data)](sol::state_view& sv) {
+            return std::vector<sol::object>{sol::make_object(sv, data)};
+        };
+    });
+}
+
+// Same as write, but the file is written on the I/O worker.
+// callback (function or coroutine) receives true, or nil and an error message.
+void write_async(sol::this_state l, const std::string& filepath, const std::string& data, sol::object callback) {
+    auto path = get_correct_subpath(l, filepath);
+
+    if (!path) {
+        return;
+    }
+
+    queue_async(l, callback, [path = std::move(*path), data]() -> AsyncArgs {
+        ::fs::create_directories(path.parent_path());
+
+        const auto existed = exists(path);
+
+        {
+            std::ofstream file{path};
+
+            if (!(file << data)) {
+                throw std::runtime_error{"fs.write_async: failed to write " + path.string()};
+            }
+        }
+
+        if (!existed) {
+            invalidate_index();
+        }
+
+        return [](sol::state_view& sv) {
+            return std::vector<sol::object>{sol::make_object(sv, true)};
+        };
+    });
+}
 }
 
 std::optional<::fs::path> get_correct_subpath(sol::this_state l, const std::string& filepath) {
@@ -181,8 +602,12 @@ void bindings::open_fs(ScriptState* s) {
     auto fs = lua.create_table();
 
     fs["glob"] = api::fs::glob;
+    fs["match"] = api::fs::match;
+    fs["list"] = api::fs::list;
     fs["write"] = api::fs::write;
     fs["read"] = api::fs::read;
+    fs["write_async"] = api::fs::write_async;
+    fs["read_async"] = api::fs::read_async;
     lua["fs"] = fs;
 
     lua.open_libraries(sol::lib::io);
@@ -1,7 +1,27 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
+#include <sol/sol.hpp>
+
 class ScriptState;
 
+namespace api::fs {
+// Built on the I/O worker, invoked on the script thread to produce the callback arguments.
+using AsyncArgs = std::function<std::vector<sol::object>(sol::state_view&)>;
+
+// Runs job on the shared I/O worker thread. Jobs run one at a time in submission order.
+void submit_io(std::function<void()> job);
+
+// Runs job on the I/O worker and hands whatever it returns to callback (function or coroutine)
+// on the script thread during the next on_frame. If job throws, callback receives nil and the error message.
+void queue_async(sol::this_state l, sol::object callback, std::function<AsyncArgs()> job);
+
+// Forces the cached directory listings used by fs.glob/match/list to be rebuilt on next use.
+void invalidate_index();
+}
+
 namespace bindings {
 void open_fs(ScriptState* s);
 }
@@ -1,11 +1,13 @@
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
 
 #include <json.hpp>
 #include <spdlog/spdlog.h>
 
 #include "../ScriptRunner.hpp"
 
+#include "FS.hpp"
 #include "Json.hpp"
 
 namespace api::json {
@@ -13,6 +15,19 @@ using json = nlohmann::json;
 namespace fs = std::filesystem;
 
 namespace detail {
+// Lua allows non-string keys in a table, JSON doesn't.
+std::string key_to_string(const sol::object& key) {
+    if (key.get_type() == sol::type::number) {
+        key.push();
+        const auto is_integer = lua_isinteger(key.lua_state(), -1);
+        key.pop();
+
+        return is_integer ? std::to_string(key.as<int64_t>()) : json(key.as<double>()).dump();
+    }
+
+    return key.as<std::string>();
+}
+
 json encode_any(sol::object obj) {
     switch (obj.get_type()) {
     case sol::type::nil:
@@ -50,7 +65,7 @@ json encode_any(sol::object obj) {
             if (is_array) {
                 j.push_back(encode_any(kvp.second));
             } else {
-                j[kvp.first.as<std::string>()] = encode_any(kvp.second);
+                j[key_to_string(kvp.first)] = encode_any(kvp.second);
             }
         }
 
@@ -101,8 +116,409 @@ sol::object decode_any(sol::this_state l, const json& j) {
 fs::path get_datadir() {
     return REFramework::get_persistent_dir() / "reframework" / "data";
 }
+
+// Writes obj the same way encode_any(obj).dump(indent) would, without building the document first.
+// Strings and floats still go through nlohmann so escaping and number formatting are identical.
+void write_any(std::ostream& out, sol::object obj, int indent, int depth = 0) {
+    const auto newline = [&](int level) {
+        if (indent >= 0) {
+            out.put('\n');
+
+            for (auto i = 0; i < indent * level; ++i) {
+                out.put(' ');
+            }
+        }
+    };
+
+    switch (obj.get_type()) {
+    case sol::type::boolean:
+        out << (obj.as<bool>() ? "true" : "false");
+        return;
+    case sol::type::number: {
+        obj.push();
+        if (lua_isinteger(obj.lua_state(), -1)) {
+            obj.pop();
+            out << obj.as<int64_t>();
+            return;
+        }
+
+        obj.pop();
+        out << json(obj.as<double>()).dump();
+        return;
+    }
+    case sol::type::string:
+        out << json(obj.as<std::string>()).dump();
+        return;
+    case sol::type::table: {
+        auto table = obj.as<sol::table>();
+        bool is_array = true;
+        auto i = 1;
+        auto count = 0;
+
+        for (auto& kvp : table) {
+            ++count;
+
+            if (kvp.first.get_type() != sol::type::number || kvp.first.as<int>() != i++) {
+                is_array = false;
+            }
+        }
+
+        if (count == 0) {
+            out << "null";
+            return;
+        }
+
+        if (is_array) {
+            out.put('[');
+
+            auto first = true;
+
+            for (auto& kvp : table) {
+                if (!first) {
+                    out.put(',');
+                }
+
+                first = false;
+                newline(depth + 1);
+                write_any(out, kvp.second, indent, depth + 1);
+            }
+
+            newline(depth);
+            out.put(']');
+            return;
+        }
+
+        // Match nlohmann's object ordering (sorted keys, last duplicate wins) so output stays stable between saves.
+        std::vector<std::pair<std::string, sol::object>> entries{};
+        entries.reserve(count);
+
+        for (auto& kvp : table) {
+            entries.emplace_back(key_to_string(kvp.first), kvp.second);
+        }
+
+        std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        out.put('{');
+
+        auto first = true;
+
+        for (size_t j = 0; j < entries.size(); ++j) {
+            if (j + 1 < entries.size() && entries[j].first == entries[j + 1].first) {
+                continue;
+            }
+
+            if (!first) {
+                out.put(',');
+            }
+
+            first = false;
+            newline(depth + 1);
+            out << json(entries[j].first).dump() << (indent >= 0 ? ": " : ":");
+            write_any(out, entries[j].second, indent, depth + 1);
+        }
+
+        newline(depth);
+        out.put('}');
+        return;
+    }
+    default:
+        out << "null";
+        return;
+    }
+}
+
+// SAX handler that walks a document without building it, except for the elements
+// of the array at target, which are built one at a time and handed to on_element.
+class ArrayStreamer : public nlohmann::json_sax<json> {
+public:
+    ArrayStreamer(const json::json_pointer& target, std::function<bool(json&&)> on_element)
+        : m_on_element{std::move(on_element)}
+    {
+        // json_pointer has no public token access in this version, so split it ourselves.
+        auto str = target.to_string();
+
+        for (size_t pos = 0; pos < str.size();) {
+            auto next = str.find('/', pos + 1);
+            auto token = str.substr(pos + 1, next == std::string::npos ? std::string::npos : next - pos - 1);
+
+            for (size_t k = 0; (k = token.find('~', k)) != std::string::npos; ++k) {
+                token.replace(k, 2, token[k + 1] == '1' ? "/" : "~");
+            }
+
+            m_target.push_back(std::move(token));
+            pos = next;
+        }
+    }
+
+    bool found() const { return m_found; }
+
+    bool null() override { return value(nullptr); }
+    bool boolean(bool val) override { return value(val); }
+    bool number_integer(number_integer_t val) override { return value(val); }
+    bool number_unsigned(number_unsigned_t val) override { return value(val); }
+    bool number_float(number_float_t val, const string_t&) override { return value(val); }
+    bool string(string_t& val) override { return value(std::move(val)); }
+    bool binary(binary_t& val) override { return value(json::binary(std::move(val))); }
+
+    bool start_object(std::size_t) override {
+        return start(json::object(), false);
+    }
+
+    bool key(string_t& val) override {
+        m_levels.back().key = val;
+        return true;
+    }
+
+    bool end_object() override {
+        return end();
+    }
+
+    bool start_array(std::size_t) override {
+        if (!m_in_target && !m_found && is_at_target()) {
+            m_levels.push_back({true});
+            m_in_target = true;
+            m_found = true;
+            m_target_depth = m_levels.size();
+            return true;
+        }
+
+        return start(json::array(), true);
+    }
+
+    bool end_array() override {
+        if (m_in_target && m_levels.size() == m_target_depth) {
+            // Nothing past the target array matters, stop parsing.
+            m_in_target = false;
+            return false;
+        }
+
+        return end();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw ex;
+    }
+
+private:
+    struct Level {
+        bool is_array{};
+        size_t index{};
+        std::string key{};
+    };
+
+    bool is_at_target() const {
+        if (m_levels.size() != m_target.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < m_levels.size(); ++i) {
+            const auto& level = m_levels[i];
+
+            if (level.is_array ? std::to_string(level.index) != m_target[i] : level.key != m_target[i]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Called after a complete value has been seen at the current level.
+    void advance() {
+        if (!m_levels.empty() && m_levels.back().is_array) {
+            ++m_levels.back().index;
+        }
+    }
+
+    json* add_to_build(json&& v) {
+        auto parent = m_build_stack.back();
+
+        if (parent->is_array()) {
+            parent->push_back(std::move(v));
+            return &parent->back();
+        }
+
+        auto& slot = (*parent)[m_levels.back().key];
+        slot = std::move(v);
+        return &slot;
+    }
+
+    bool value(json&& v) {
+        bool keep_going = true;
+
+        if (m_in_target) {
+            if (!m_build_stack.empty()) {
+                add_to_build(std::move(v));
+            } else if (m_levels.size() == m_target_depth) {
+                keep_going = m_on_element(std::move(v));
+            }
+        }
+
+        advance();
+        return keep_going;
+    }
+
+    bool start(json&& container, bool is_array) {
+        if (m_in_target) {
+            if (!m_build_stack.empty()) {
+                m_build_stack.push_back(add_to_build(std::move(container)));
+            } else if (m_levels.size() == m_target_depth) {
+                m_element = std::move(container);
+                m_build_stack.push_back(&m_element);
+            }
+        }
+
+        m_levels.push_back({is_array});
+        return true;
+    }
+
+    bool end() {
+        bool keep_going = true;
+
+        m_levels.pop_back();
+
+        if (!m_build_stack.empty()) {
+            m_build_stack.pop_back();
+
+            if (m_build_stack.empty()) {
+                keep_going = m_on_element(std::move(m_element));
+                m_element = nullptr;
+            }
+        }
+
+        advance();
+        return keep_going;
+    }
+
+    std::function<bool(json&&)> m_on_element{};
+    std::vector<std::string> m_target{};
+    std::vector<Level> m_levels{};
+    std::vector<json*> m_build_stack{};
+    json m_element{};
+    size_t m_target_depth{};
+    bool m_in_target{false};
+    bool m_found{false};
+};
 } // namespace detail
 
+// Read-only view into a parsed document. Containers are only converted to Lua
+// when indexed, so scripts pay for the parts they touch.
+// node.key and node[i] only ever look up the document, so keys like "type" or "size" work as expected.
+// Everything else is a function on the json table, e.g. json.size(node), json.keys(node).
+struct JsonNode {
+    std::shared_ptr<const json> root{};
+    const json* node{};
+
+    static sol::object wrap(sol::this_state l, std::shared_ptr<const json> root, const json* node) {
+        if (node->is_object() || node->is_array()) {
+            return sol::make_object(l, JsonNode{std::move(root), node});
+        }
+
+        return detail::decode_any(l, *node);
+    }
+
+    const json* find(sol::object key) const {
+        if (node->is_array() && key.get_type() == sol::type::number) {
+            const auto i = key.as<int64_t>();
+
+            if (i < 1 || (size_t)i > node->size()) {
+                return nullptr;
+            }
+
+            return &(*node)[(size_t)i - 1];
+        }
+
+        if (node->is_object() && key.get_type() == sol::type::string) {
+            auto it = node->find(key.as<std::string>());
+            return it != node->end() ? &*it : nullptr;
+        }
+
+        return nullptr;
+    }
+
+    sol::object get(sol::this_state l, sol::object key) const {
+        auto child = find(key);
+        return child != nullptr ? wrap(l, root, child) : sol::make_object(l, sol::nil);
+    }
+
+    bool contains(sol::object key) const {
+        return find(key) != nullptr;
+    }
+
+    sol::object at(sol::this_state l, const std::string& pointer) const try {
+        return wrap(l, root, &node->at(json::json_pointer{pointer}));
+    } catch (const json::exception&) {
+        return sol::make_object(l, sol::nil);
+    }
+
+    size_t size() const {
+        return node->is_structured() ? node->size() : 0;
+    }
+
+    const char* type() const {
+        return node->type_name();
+    }
+
+    sol::table keys(sol::this_state l) const {
+        auto t = sol::state_view{l}.create_table(node->is_object() ? (int)node->size() : 0, 0);
+        auto i = 0;
+
+        if (node->is_object()) {
+            for (auto it = node->begin(); it != node->end(); ++it) {
+                t[++i] = it.key();
+            }
+        }
+
+        return t;
+    }
+
+    sol::object to_table(sol::this_state l) const {
+        return detail::decode_any(l, *node);
+    }
+
+    std::string to_string() const {
+        return node->dump();
+    }
+
+    // __pairs. Arrays iterate 1..n, objects iterate keys in sorted order.
+    static std::tuple<sol::object, sol::object, sol::object> pairs(sol::this_state l, const JsonNode& self) {
+        auto next = sol::make_object(l, [](sol::this_state l, const JsonNode& self, sol::object prev) -> std::tuple<sol::object, sol::object> {
+            const auto& n = *self.node;
+
+            if (n.is_array()) {
+                const auto i = prev.get_type() == sol::type::number ? prev.as<size_t>() : 0;
+
+                if (i >= n.size()) {
+                    return {sol::make_object(l, sol::nil), sol::make_object(l, sol::nil)};
+                }
+
+                return {sol::make_object(l, i + 1), wrap(l, self.root, &n[i])};
+            }
+
+            if (n.is_object()) {
+                auto it = n.begin();
+
+                if (prev.get_type() == sol::type::string) {
+                    it = n.find(prev.as<std::string>());
+
+                    if (it != n.end()) {
+                        ++it;
+                    }
+                }
+
+                if (it == n.end()) {
+                    return {sol::make_object(l, sol::nil), sol::make_object(l, sol::nil)};
+                }
+
+                return {sol::make_object(l, it.key()), wrap(l, self.root, &*it)};
+            }
+
+            return {sol::make_object(l, sol::nil), sol::make_object(l, sol::nil)};
+        });
+
+        return {next, sol::make_object(l, self), sol::make_object(l, sol::nil)};
+    }
+};
+
 sol::object load_string(sol::this_state l, const std::string& s) try {
     const auto j = json::parse(s);
     return detail::decode_any(l, j);
@@ -138,6 +554,76 @@ sol::object load_file(sol::this_state l, const std::string& filepath) try {
     return sol::nil;
 }
 
+sol::object load_string_lazy(sol::this_state l, const std::string& s) try {
+    auto j = std::make_shared<const json>(json::parse(s));
+    return JsonNode::wrap(l, j, j.get());
+} catch (const std::exception& e) {
+    return sol::nil;
+}
+
+// Parses the file but only converts to Lua what gets indexed.
+sol::object load_file_lazy(sol::this_state l, const std::string& filepath) try {
+    if (filepath.find("..") != std::string::npos) {
+        throw std::runtime_error{"json.load_file_lazy does not allow access to parent directories"};
+    }
+
+    if (std::filesystem::path(filepath).is_absolute()) {
+        throw std::runtime_error{"json.load_file_lazy does not allow absolute paths"};
+    }
+
+    auto j = std::make_shared<const json>(json::parse(std::ifstream{detail::get_datadir() / filepath}));
+    return JsonNode::wrap(l, j, j.get());
+} catch (const json::exception& e) {
+    spdlog::error("[JSON] Failed to load file {}: {}", filepath, e.what());
+    return sol::nil;
+}
+
+// Streams the file and calls fn(index, element) for each element of the array at pointer
+// ("" for a top level array). Only one element exists in memory at a time. fn can return false to stop.
+// Returns the number of elements visited, nil if the file or the array wasn't found,
+// or false and an error message if parsing failed or fn raised an error.
+std::tuple<sol::object, sol::object> iterate_file(sol::this_state l, const std::string& filepath, const std::string& pointer, sol::protected_function fn) try {
+    if (filepath.find("..") != std::string::npos) {
+        throw std::runtime_error{"json.iterate_file does not allow access to parent directories"};
+    }
+
+    if (std::filesystem::path(filepath).is_absolute()) {
+        throw std::runtime_error{"json.iterate_file does not allow absolute paths"};
+    }
+
+    std::ifstream f{detail::get_datadir() / filepath};
+
+    if (!f) {
+        return {sol::make_object(l, sol::nil), sol::make_object(l, sol::nil)};
+    }
+
+    size_t count = 0;
+
+    detail::ArrayStreamer streamer{json::json_pointer{pointer}, [&](json&& element) {
+        ++count;
+
+        auto result = fn(count, detail::decode_any(l, element));
+
+        if (!result.valid()) {
+            sol::error err = result;
+            throw std::runtime_error{err.what()};
+        }
+
+        return !(result.get_type() == sol::type::boolean && result.get<bool>() == false);
+    }};
+
+    json::sax_parse(f, &streamer);
+
+    if (!streamer.found()) {
+        return {sol::make_object(l, sol::nil), sol::make_object(l, sol::nil)};
+    }
+
+    return {sol::make_object(l, count), sol::make_object(l, sol::nil)};
+} catch (const std::exception& e) {
+    spdlog::error("[JSON] Failed to iterate file {}: {}", filepath, e.what());
+    return {sol::make_object(l, false), sol::make_object(l, std::string{e.what()})};
+}
+
 bool dump_file(const std::string& filepath, sol::object obj, sol::object indent_obj) try {
     int indent = 4;
 
@@ -157,8 +643,83 @@ bool dump_file(const std::string& filepath, sol::object obj, sol::object indent_
 
     fs::create_directories(path.parent_path());
 
-    std::ofstream f{path};
-    f << detail::encode_any(obj).dump(indent);
+    const auto existed = fs::exists(path);
+
+    {
+        std::ofstream f{path};
+        detail::write_any(f, obj, indent);
+    }
+
+    if (!existed) {
+        api::fs::invalidate_index();
+    }
+
+    return true;
+} catch (const std::exception& e) {
+    spdlog::error("[JSON] Failed to dump file {}: {}", filepath, e.what());
+    return false;
+}
+
+// Parses the file on the I/O worker. callback (function or coroutine) receives the decoded value,
+// or nil and an error message.
+void load_file_async(sol::this_state l, const std::string& filepath, sol::object callback) {
+    if (filepath.find("..") != std::string::npos) {
+        throw sol::error{"json.load_file_async does not allow access to parent directories"};
+    }
+
+    if (std::filesystem::path(filepath).is_absolute()) {
+        throw sol::error{"json.load_file_async does not allow absolute paths"};
+    }
+
+    api::fs::queue_async(l, callback, [path = detail::get_datadir() / filepath]() -> api::fs::AsyncArgs {
+        auto j = std::make_shared<json>(json::parse(std::ifstream{path}));
+
+        // Decoding into Lua tables has to happen on the script thread.
+        return [j](sol::state_view& sv) {
+            return std::vector<sol::object>{detail::decode_any(sv.lua_state(), *j)};
+        };
+    });
+}
+
+// The object is encoded on the calling thread (it reads Lua tables), serialization and the write happen on the I/O worker.
+// callback (function or coroutine) receives true, or nil and an error message.
+bool dump_file_async(sol::this_state l, const std::string& filepath, sol::object obj, sol::object indent_obj, sol::object callback) try {
+    int indent = 4;
+
+    if (indent_obj.get_type() == sol::type::number) {
+        indent = indent_obj.as<int>();
+    }
+
+    if (filepath.find("..") != std::string::npos) {
+        throw std::runtime_error{"json.dump_file_async does not allow access to parent directories"};
+    }
+
+    if (std::filesystem::path(filepath).is_absolute()) {
+        throw std::runtime_error{"json.dump_file_async does not allow absolute paths"};
+    }
+
+    api::fs::queue_async(l, callback, [path = detail::get_datadir() / filepath, j = detail::encode_any(obj), indent]() -> api::fs::AsyncArgs {
+        fs::create_directories(path.parent_path());
+
+        const auto existed = fs::exists(path);
+
+        {
+            std::ofstream f{path};
+
+            if (!(f << j.dump(indent))) {
+                throw std::runtime_error{"json.dump_file_async: failed to write " + path.string()};
+            }
+        }
+
+        if (!existed) {
+            api::fs::invalidate_index();
+        }
+
+        return [](sol::state_view& sv) {
+            return std::vector<sol::object>{sol::make_object(sv, true)};
+        };
+    });
+
     return true;
 } catch (const std::exception& e) {
     spdlog::error("[JSON] Failed to dump file {}: {}", filepath, e.what());
@@ -175,5 +736,27 @@ void bindings::open_json(ScriptState* s) {
     json["dump_string"] = api::json::dump_string;
     json["load_file"] = api::json::load_file;
     json["dump_file"] = api::json::dump_file;
+    json["load_string_lazy"] = api::json::load_string_lazy;
+    json["load_file_lazy"] = api::json::load_file_lazy;
+    json["iterate_file"] = api::json::iterate_file;
+    json["load_file_async"] = api::json::load_file_async;
+    json["dump_file_async"] = api::json::dump_file_async;
+
+    // JsonNode functions live here instead of on the node, where they would shadow keys with the same name.
+    json["get"] = &api::json::JsonNode::get;
+    json["contains"] = &api::json::JsonNode::contains;
+    json["at"] = &api::json::JsonNode::at;
+    json["size"] = &api::json::JsonNode::size;
+    json["type"] = &api::json::JsonNode::type;
+    json["keys"] = &api::json::JsonNode::keys;
+    json["to_table"] = &api::json::JsonNode::to_table;
     lua["json"] = json;
+
+    lua.new_usertype<api::json::JsonNode>("JsonNode",
+        sol::no_constructor,
+        sol::meta_function::index, &api::json::JsonNode::get,
+        sol::meta_function::length, &api::json::JsonNode::size,
+        sol::meta_function::pairs, &api::json::JsonNode::pairs,
+        sol::meta_function::to_string, &api::json::JsonNode::to_string
+    );
 }
\ No newline at end of file
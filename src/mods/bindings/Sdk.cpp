@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdint>
 #include <concepts>
 
@@ -8,7 +9,11 @@
 #include "sdk/REManagedObject.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneQuery.hpp"
+#include "sdk/TypeSearch.hpp"
+#include "sdk/MethodIndex.hpp"
 #include "sdk/ResourceManager.hpp"
+#include "sdk/RETransform.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
 #include "sdk/TDBVer.hpp"
 #include "utility/Memory.hpp"
@@ -18,6 +23,7 @@
 #include <lgc.h>
 
 #include "Sdk.hpp"
+#include "TypedArray.hpp"
 
 namespace api {
 namespace sdk {
@@ -539,12 +545,14 @@ auto get_managed_singleton(sol::this_state s, const char* name) {
     return sol::make_object(s, out);
 }
 
-sol::object create_managed_string(sol::this_state s, const char* text) {
+// intern = true returns a shared string that's never collected, for names passed to the engine repeatedly.
+sol::object create_managed_string(sol::this_state s, const char* text, sol::object intern_obj) {
     if (text == nullptr) {
         return sol::make_object(s, sol::nil);
     }
 
-    auto new_str = ::sdk::VM::create_managed_string(utility::widen(text));
+    const auto intern = intern_obj.is<bool>() && intern_obj.as<bool>();
+    auto new_str = intern ? ::sdk::VM::create_managed_string_interned(utility::widen(text)) : ::sdk::VM::create_managed_string(utility::widen(text));
 
     if (new_str == nullptr) {
         return sol::make_object(s, sol::nil);
@@ -1099,6 +1107,540 @@ sol::object get_native_field(sol::object obj, ::sdk::RETypeDefinition* ty, const
     return get_native_field_from_field(obj, ty, field);
 }
 
+// Returned by sdk.bind_field. Everything get_native_field figures out on every access
+// (the name lookup, the offset, what kind of data the field holds) is resolved once here,
+// so reading the field afterwards is just pointer arithmetic and a switch.
+struct FieldAccessor {
+    enum class Kind : uint8_t {
+        BOOL,
+        S8,
+        U8,
+        S16,
+        U16,
+        S32,
+        U32,
+        S64,
+        U64,
+        F32,
+        F64,
+        VEC2,
+        VEC3,
+        VEC4,
+        MAT4,
+        QUAT,
+        STRING,
+        OBJECT,
+        ARRAY,
+        OTHER // ValueTypes, GameObjectRef, etc. Still skips the lookup, but goes through parse_data/set_data
+    };
+
+    ::sdk::REField* field{nullptr};
+    ::sdk::RETypeDefinition* declaring_type{nullptr};
+    ::sdk::RETypeDefinition* field_type{nullptr};
+    ::sdk::RETypeDefinition* last_verified_type{nullptr};
+    uint32_t offset_from_base{0};
+    uint32_t offset_from_fieldptr{0};
+    uint32_t data_size{0};
+    Kind kind{Kind::OTHER};
+    bool is_static{false};
+
+    FieldAccessor(::sdk::RETypeDefinition* t, ::sdk::REField* f)
+        : field{f},
+        declaring_type{t},
+        field_type{f->get_type()},
+        offset_from_base{f->get_offset_from_base()},
+        offset_from_fieldptr{f->get_offset_from_fieldptr()},
+        is_static{f->is_static()}
+    {
+        if (field_type == nullptr) {
+            return;
+        }
+
+        data_size = field_type->is_value_type() ? field_type->get_valuetype_size() : sizeof(void*);
+
+        size_t full_name_hash{};
+
+        if (field_type->is_enum()) {
+            auto underlying_type = field_type->get_underlying_type();
+
+            if (underlying_type != nullptr) {
+                full_name_hash = utility::hash(underlying_type->get_full_name());
+            }
+        } else {
+            full_name_hash = utility::hash(field_type->get_full_name());
+        }
+
+        switch (full_name_hash) {
+        case "System.Boolean"_fnv: kind = Kind::BOOL; break;
+        case "System.SByte"_fnv: kind = Kind::S8; break;
+        case "System.Byte"_fnv: kind = Kind::U8; break;
+        case "System.Int16"_fnv: kind = Kind::S16; break;
+        case "System.UInt16"_fnv: kind = Kind::U16; break;
+        case "System.Int32"_fnv: kind = Kind::S32; break;
+        case "System.UInt32"_fnv: kind = Kind::U32; break;
+        case "System.Int64"_fnv: kind = Kind::S64; break;
+        case "System.UInt64"_fnv: kind = Kind::U64; break;
+        case "System.Single"_fnv: kind = Kind::F32; break;
+        case "System.Double"_fnv: kind = Kind::F64; break;
+        case "via.Float2"_fnv: [[fallthrough]];
+        case "via.vec2"_fnv: kind = Kind::VEC2; break;
+        case "via.Float3"_fnv: [[fallthrough]];
+        case "via.vec3"_fnv: kind = Kind::VEC3; break;
+        case "via.Float4"_fnv: [[fallthrough]];
+        case "via.vec4"_fnv: kind = Kind::VEC4; break;
+        case "via.mat4"_fnv: kind = Kind::MAT4; break;
+        case "via.Quaternion"_fnv: kind = Kind::QUAT; break;
+        case "System.String"_fnv: kind = Kind::STRING; break;
+        default: {
+            const auto vm_obj_type = field_type->get_vm_obj_type();
+
+            if (vm_obj_type == via::clr::VMObjType::Array) {
+                kind = Kind::ARRAY;
+            } else if (vm_obj_type > via::clr::VMObjType::NULL_ && vm_obj_type < via::clr::VMObjType::ValType) {
+                kind = Kind::OBJECT;
+            }
+
+            break;
+        }
+        }
+    }
+
+    void* get_data_ptr(sol::object& obj) {
+        if (is_static) {
+            return field->get_data_raw(nullptr);
+        }
+
+        if (obj.is<::REManagedObject*>()) {
+            auto managed_obj = obj.as<::REManagedObject*>();
+
+            if (managed_obj == nullptr) {
+                return nullptr;
+            }
+
+            // Only walk the hierarchy when we see a new type, scripts almost always
+            // pass the same type over and over again.
+            const auto td = utility::re_managed_object::get_type_definition(managed_obj);
+
+            if (td != last_verified_type) {
+                if (td == nullptr || !td->is_a(declaring_type)) {
+                    throw sol::error(std::format("FieldAccessor: object of type {} does not have field {}", 
+                        td != nullptr ? td->get_full_name() : "unknown", field->get_name()));
+                }
+
+                last_verified_type = td;
+            }
+
+            return (void*)((uintptr_t)managed_obj + offset_from_base);
+        }
+
+        if (obj.is<ValueType>()) {
+            auto& vt = obj.as<ValueType&>();
+
+            if (vt.type != declaring_type && (vt.type == nullptr || !vt.type->is_a(declaring_type))) {
+                throw sol::error(std::format("FieldAccessor: ValueType does not have field {}", field->get_name()));
+            }
+
+            if (offset_from_fieldptr + data_size > vt.data.size()) {
+                return nullptr;
+            }
+
+            return (void*)(vt.address() + offset_from_fieldptr);
+        }
+
+        const auto real_obj = get_real_obj(obj);
+
+        if (real_obj == nullptr) {
+            return nullptr;
+        }
+
+        if (declaring_type->is_value_type()) {
+            return (void*)((uintptr_t)real_obj + offset_from_fieldptr);
+        }
+
+        return (void*)((uintptr_t)real_obj + offset_from_base);
+    }
+
+    sol::object get(sol::this_state s, sol::object obj) {
+        auto l = s.lua_state();
+        const auto data = get_data_ptr(obj);
+
+        if (data == nullptr) {
+            return sol::make_object(l, sol::nil);
+        }
+
+        switch (kind) {
+        case Kind::BOOL: return sol::make_object(l, *(bool*)data);
+        case Kind::S8: return sol::make_object(l, *(int8_t*)data);
+        case Kind::U8: return sol::make_object(l, *(uint8_t*)data);
+        case Kind::S16: return sol::make_object(l, *(int16_t*)data);
+        case Kind::U16: return sol::make_object(l, *(uint16_t*)data);
+        case Kind::S32: return sol::make_object(l, *(int32_t*)data);
+        case Kind::U32: return sol::make_object(l, *(uint32_t*)data);
+        case Kind::S64: return sol::make_object(l, *(int64_t*)data);
+        case Kind::U64: return sol::make_object(l, *(int64_t*)data); // see parse_data for why this is signed
+        case Kind::F32: return sol::make_object(l, *(float*)data);
+        case Kind::F64: return sol::make_object(l, *(double*)data);
+        case Kind::VEC2: return sol::make_object<Vector2f>(l, *(Vector2f*)data);
+        case Kind::VEC3: return sol::make_object<Vector3f>(l, *(Vector3f*)data);
+        case Kind::VEC4: return sol::make_object<Vector4f>(l, *(Vector4f*)data);
+        case Kind::MAT4: return sol::make_object<Matrix4x4f>(l, *(Matrix4x4f*)data);
+        case Kind::QUAT: return sol::make_object<glm::quat>(l, *(glm::quat*)data);
+        case Kind::ARRAY: {
+            auto arr = *(::sdk::SystemArray**)data;
+
+            if (arr == nullptr) {
+                return sol::make_object(l, sol::nil);
+            }
+
+            return sol::make_object(l, arr);
+        }
+        case Kind::OBJECT: {
+            auto managed_obj = *(::REManagedObject**)data;
+
+            if (managed_obj == nullptr) {
+                return sol::make_object(l, sol::nil);
+            }
+
+            // fields typed as System.Object can still hold arrays
+            const auto td = utility::re_managed_object::get_type_definition(managed_obj);
+
+            if (td != nullptr && td->get_vm_obj_type() == via::clr::VMObjType::Array) {
+                return sol::make_object(l, (::sdk::SystemArray*)managed_obj);
+            }
+
+            return sol::make_object(l, managed_obj);
+        }
+        case Kind::STRING: [[fallthrough]];
+        case Kind::OTHER: [[fallthrough]];
+        default:
+            return parse_data(l, data, field_type, false);
+        }
+    }
+
+    void set(sol::this_state s, sol::object obj, sol::object value) {
+        const auto data = get_data_ptr(obj);
+
+        if (data == nullptr) {
+            return;
+        }
+
+        switch (kind) {
+        case Kind::BOOL: *(bool*)data = value.as<bool>(); return;
+        case Kind::S8: *(int8_t*)data = value.as<int8_t>(); return;
+        case Kind::U8: *(uint8_t*)data = value.as<uint8_t>(); return;
+        case Kind::S16: *(int16_t*)data = value.as<int16_t>(); return;
+        case Kind::U16: *(uint16_t*)data = value.as<uint16_t>(); return;
+        case Kind::S32: *(int32_t*)data = value.as<int32_t>(); return;
+        case Kind::U32: *(uint32_t*)data = value.as<uint32_t>(); return;
+        case Kind::S64: [[fallthrough]];
+        case Kind::U64: *(int64_t*)data = value.as<int64_t>(); return;
+        case Kind::F32: *(float*)data = value.as<float>(); return;
+        case Kind::F64: *(double*)data = value.as<double>(); return;
+        case Kind::VEC2: *(Vector2f*)data = value.as<Vector2f>(); return;
+        case Kind::VEC3: *(Vector3f*)data = value.as<Vector3f>(); return;
+        case Kind::VEC4: *(Vector4f*)data = value.as<Vector4f>(); return;
+        case Kind::MAT4: *(Matrix4x4f*)data = value.as<Matrix4x4f>(); return;
+        case Kind::QUAT: *(glm::quat*)data = value.as<glm::quat>(); return;
+        default:
+            // Reference types need the add_ref/release dance, let set_data handle it.
+            set_data(data, field_type, value);
+            return;
+        }
+    }
+
+    ::sdk::REField* get_field() const {
+        return field;
+    }
+
+    uint32_t get_offset() const {
+        return offset_from_base;
+    }
+};
+
+sol::object bind_field(sol::this_state s, sol::object type_obj, const char* name) {
+    ::sdk::RETypeDefinition* t{nullptr};
+
+    if (type_obj.is<::sdk::RETypeDefinition*>()) {
+        t = type_obj.as<::sdk::RETypeDefinition*>();
+    } else if (type_obj.is<const char*>()) {
+        t = ::sdk::find_type_definition(type_obj.as<const char*>());
+    } else {
+        throw sol::error("Invalid type passed to bind_field. Must be a type definition or a type name.");
+    }
+
+    if (t == nullptr || name == nullptr) {
+        return sol::make_object(s, sol::nil);
+    }
+
+    const auto field = t->get_field(name);
+
+    if (field == nullptr) {
+        return sol::make_object(s, sol::nil);
+    }
+
+    return sol::make_object(s, FieldAccessor{t, field});
+}
+
+// Literal (const) static fields of a type, read once from the TDB's init data.
+// Shared by every Lua state. Literal values never change so there's nothing to invalidate.
+struct StaticConstants {
+    struct Entry {
+        std::string name{};
+        ::sdk::RETypeDefinition* field_type{};
+        void* data{};
+        int64_t enum_value{};
+        bool is_string{};
+    };
+
+    bool is_enum{};
+    std::vector<Entry> entries{};
+};
+
+const StaticConstants& get_static_constants(::sdk::RETypeDefinition* t) {
+    static std::shared_mutex mtx{};
+    static std::unordered_map<::sdk::RETypeDefinition*, std::unique_ptr<StaticConstants>> cache{};
+
+    {
+        std::shared_lock _{mtx};
+
+        if (auto it = cache.find(t); it != cache.end()) {
+            return *it->second;
+        }
+    }
+
+    auto result = std::make_unique<StaticConstants>();
+    result->is_enum = t->is_enum();
+
+    size_t underlying_hash{};
+
+    if (result->is_enum) {
+        if (auto underlying_type = t->get_underlying_type(); underlying_type != nullptr) {
+            underlying_hash = utility::hash(underlying_type->get_full_name());
+        }
+    }
+
+    for (auto f : t->get_fields()) {
+        if (f == nullptr || !f->is_static() || !f->is_literal()) {
+            continue;
+        }
+
+        auto field_type = f->get_type();
+        auto data = f->get_init_data();
+
+        if (field_type == nullptr || data == nullptr) {
+            continue;
+        }
+
+        StaticConstants::Entry entry{};
+        entry.name = f->get_name();
+        entry.field_type = field_type;
+        entry.data = data;
+        entry.is_string = utility::hash(field_type->get_full_name()) == "System.String"_fnv;
+
+        if (result->is_enum) {
+            switch (underlying_hash) {
+            case "System.SByte"_fnv: entry.enum_value = *(int8_t*)data; break;
+            case "System.Byte"_fnv: entry.enum_value = *(uint8_t*)data; break;
+            case "System.Int16"_fnv: entry.enum_value = *(int16_t*)data; break;
+            case "System.UInt16"_fnv: entry.enum_value = *(uint16_t*)data; break;
+            case "System.UInt32"_fnv: entry.enum_value = *(uint32_t*)data; break;
+            case "System.Int64"_fnv: [[fallthrough]];
+            case "System.UInt64"_fnv: entry.enum_value = *(int64_t*)data; break;
+            default: entry.enum_value = *(int32_t*)data; break;
+            }
+        }
+
+        result->entries.push_back(std::move(entry));
+    }
+
+    std::unique_lock _{mtx};
+
+    auto& slot = cache[t];
+
+    if (slot == nullptr) {
+        slot = std::move(result);
+    }
+
+    return *slot;
+}
+
+::sdk::RETypeDefinition* resolve_static_constants_type(sol::object type_obj) {
+    if (type_obj.is<::sdk::RETypeDefinition*>()) {
+        return type_obj.as<::sdk::RETypeDefinition*>();
+    }
+
+    if (type_obj.is<const char*>()) {
+        return ::sdk::find_type_definition(type_obj.as<const char*>());
+    }
+
+    throw sol::error("Invalid type passed. Must be a type definition or a type name.");
+}
+
+// Each Lua state builds its table once from the shared constants and then hands out the
+// same read-only proxy to every caller.
+sol::object get_static_constants_table(sol::this_state s, ::sdk::RETypeDefinition* t, int variant) {
+    if (t == nullptr) {
+        return sol::make_object(s, sol::nil);
+    }
+
+    sol::state_view sv{s};
+    auto registry = sv.registry();
+
+    sol::table tables = registry["_sdk_static_tables"].get_or_create<sol::table>();
+    const auto key = ((int64_t)t->get_index() << 2) | variant;
+
+    if (sol::object existing = tables[key]; existing.valid() && !existing.is<sol::nil_t>()) {
+        return existing;
+    }
+
+    sol::function make_readonly = registry["_sdk_make_readonly"];
+
+    if (!make_readonly.valid()) {
+        make_readonly = sv.load(R"(
+            return function(data)
+                return setmetatable({}, {
+                    __index = data,
+                    __newindex = function() error("attempt to modify a read-only table", 2) end,
+                    __pairs = function() return next, data, nil end,
+                    __len = function() return #data end,
+                    __metatable = false
+                })
+            end
+        )").get<sol::protected_function>()().get<sol::function>();
+
+        registry["_sdk_make_readonly"] = make_readonly;
+    }
+
+    const auto& constants = get_static_constants(t);
+    auto data = sv.create_table(0, (int)constants.entries.size() * (variant == 1 ? 2 : 1));
+
+    for (const auto& entry : constants.entries) {
+        if (variant != 2) {
+            data[entry.name] = entry.enum_value;
+
+            if (variant == 1) {
+                data[entry.enum_value] = entry.name;
+            }
+        } else if (entry.is_string) {
+            // String literals are stored as UTF-8 in the TDB, not as managed strings.
+            data[entry.name] = (const char*)entry.data;
+        } else {
+            data[entry.name] = parse_data(s, entry.data, entry.field_type, false);
+        }
+    }
+
+    sol::object result = make_readonly(data);
+    tables[key] = result;
+
+    return result;
+}
+
+sol::object get_enum(sol::this_state s, sol::object type_obj, sol::object double_ended_obj) {
+    auto t = resolve_static_constants_type(type_obj);
+
+    // Anything else would come back as a table of zeroes that looks like a real enum.
+    if (t == nullptr || !t->is_enum()) {
+        return sol::make_object(s, sol::nil);
+    }
+
+    const auto double_ended = double_ended_obj.is<bool>() && double_ended_obj.as<bool>();
+    return get_static_constants_table(s, t, double_ended ? 1 : 0);
+}
+
+sol::object get_statics(sol::this_state s, sol::object type_obj) {
+    return get_static_constants_table(s, resolve_static_constants_type(type_obj), 2);
+}
+
+// Ranked name search over the whole TDB.
+// Returns nil, "index building" until the index finishes building in the background.
+// options = { kinds = "types" | "methods" | "fields" | "all", mode = "auto" | "prefix" | "substring" | "fuzzy", max_results = 100 }
+std::tuple<sol::object, sol::object> search_types(sol::this_state s, const char* pattern, sol::object options_obj) {
+    ::sdk::TypeSearchIndex::Query query{};
+    query.pattern = pattern != nullptr ? pattern : "";
+    query.kinds = ::sdk::TypeSearchIndex::TYPES;
+    query.max_results = 100;
+
+    if (options_obj.is<sol::table>()) {
+        auto options = options_obj.as<sol::table>();
+
+        if (auto kinds = options.get<sol::optional<std::string>>("kinds"); kinds) {
+            switch (utility::hash(*kinds)) {
+            case "types"_fnv: query.kinds = ::sdk::TypeSearchIndex::TYPES; break;
+            case "methods"_fnv: query.kinds = ::sdk::TypeSearchIndex::METHODS; break;
+            case "fields"_fnv: query.kinds = ::sdk::TypeSearchIndex::FIELDS; break;
+            case "all"_fnv: query.kinds = ::sdk::TypeSearchIndex::ALL; break;
+            default: throw sol::error("search_types: kinds must be \"types\", \"methods\", \"fields\" or \"all\"");
+            }
+        }
+
+        if (auto mode = options.get<sol::optional<std::string>>("mode"); mode) {
+            switch (utility::hash(*mode)) {
+            case "auto"_fnv: query.mode = ::sdk::TypeSearchIndex::Mode::AUTO; break;
+            case "prefix"_fnv: query.mode = ::sdk::TypeSearchIndex::Mode::PREFIX; break;
+            case "substring"_fnv: query.mode = ::sdk::TypeSearchIndex::Mode::SUBSTRING; break;
+            case "fuzzy"_fnv: query.mode = ::sdk::TypeSearchIndex::Mode::FUZZY; break;
+            default: throw sol::error("search_types: mode must be \"auto\", \"prefix\", \"substring\" or \"fuzzy\"");
+            }
+        }
+
+        query.max_results = options.get_or<size_t>("max_results", query.max_results);
+    }
+
+    const auto index = ::sdk::TypeSearchIndex::get();
+
+    // Building it takes long enough to hitch the frame, so never do it on the calling thread.
+    if (index == nullptr) {
+        ::sdk::TypeSearchIndex::build_async();
+        return {sol::make_object(s, sol::lua_nil), sol::make_object(s, "index building")};
+    }
+
+    sol::state_view sv{s};
+    auto out = sv.create_table();
+
+    static thread_local std::vector<::sdk::TypeSearchIndex::Result> results{};
+    index->search(query, results);
+
+    auto i = 0;
+
+    for (const auto& result : results) {
+        switch (result.kind) {
+        case ::sdk::TypeSearchIndex::Kind::TYPE:
+            out[++i] = result.get_type();
+            break;
+        case ::sdk::TypeSearchIndex::Kind::METHOD:
+            out[++i] = result.get_method();
+            break;
+        case ::sdk::TypeSearchIndex::Kind::FIELD:
+            out[++i] = result.get_field();
+            break;
+        default:
+            break;
+        }
+    }
+
+    return {out, sol::make_object(s, sol::lua_nil)};
+}
+
+// Returns the method containing a code address and the offset into it, or nil.
+// Returns nil, "index building" until the index finishes building in the background.
+std::tuple<sol::object, sol::object> symbolize(sol::this_state s, uintptr_t addr) {
+    const auto index = ::sdk::MethodAddressIndex::get();
+
+    // Same as search_types, building it on the calling thread would hitch the frame.
+    if (index == nullptr) {
+        ::sdk::MethodAddressIndex::build_async();
+        return {sol::make_object(s, sol::lua_nil), sol::make_object(s, "index building")};
+    }
+
+    const auto symbol = index->find(addr);
+
+    if (!symbol) {
+        return {sol::lua_nil, sol::lua_nil};
+    }
+
+    return {sol::make_object(s, symbol->method), sol::make_object(s, symbol->offset)};
+}
+
 std::vector<void*>& build_args(sol::variadic_args va) {
     auto l = va.lua_state();
 
@@ -1205,6 +1747,104 @@ auto call_object_func(sol::object obj, const char* name, sol::variadic_args va)
     return call_native_func(obj, def, name, va);
 }
 
+struct SceneQueryResults {
+    std::vector<::sdk::SceneQueryResult> results{};
+
+    size_t size() const {
+        return results.size();
+    }
+
+    const ::sdk::SceneQueryResult* get(uint32_t i) const {
+        if (i >= results.size()) {
+            return nullptr;
+        }
+
+        return &results[i];
+    }
+
+    sol::object get_object(sol::this_state s, uint32_t i) const {
+        const auto result = get(i);
+
+        if (result == nullptr || result->object == nullptr) {
+            return sol::make_object(s, sol::nil);
+        }
+
+        return sol::make_object(s, result->object);
+    }
+
+    sol::object get_game_object(sol::this_state s, uint32_t i) const {
+        const auto result = get(i);
+
+        if (result == nullptr || result->game_object == nullptr) {
+            return sol::make_object(s, sol::nil);
+        }
+
+        return sol::make_object(s, (::REManagedObject*)result->game_object);
+    }
+
+    sol::object get_type(sol::this_state s, uint32_t i) const {
+        const auto result = get(i);
+
+        if (result == nullptr || result->type == nullptr) {
+            return sol::make_object(s, sol::nil);
+        }
+
+        return sol::make_object(s, result->type);
+    }
+
+    sol::object get_position(sol::this_state s, uint32_t i) const {
+        const auto result = get(i);
+
+        if (result == nullptr) {
+            return sol::make_object(s, sol::nil);
+        }
+
+        return sol::make_object<Vector4f>(s, result->position);
+    }
+};
+
+sol::object query_scene(sol::this_state s, sol::object options_obj) {
+    ::sdk::SceneQuery query{};
+
+    if (options_obj.is<sol::table>()) {
+        sol::table options = options_obj.as<sol::table>();
+
+        if (sol::object type_obj = options["type"]; type_obj.valid() && !type_obj.is<sol::nil_t>()) {
+            if (type_obj.is<::sdk::RETypeDefinition*>()) {
+                query.component_type = type_obj.as<::sdk::RETypeDefinition*>();
+            } else if (type_obj.is<const char*>()) {
+                query.component_type = ::sdk::find_type_definition(type_obj.as<const char*>());
+            }
+
+            // Asking for a type that doesn't exist shouldn't silently return every transform.
+            if (query.component_type == nullptr) {
+                return sol::make_object(s, sol::nil);
+            }
+        }
+
+        query.recursive = options.get_or("recursive", true);
+        query.max_results = options.get_or("max_results", 0u);
+
+        if (sol::object radius_obj = options["radius"]; radius_obj.is<float>()) {
+            query.use_radius = true;
+            query.radius = radius_obj.as<float>();
+
+            if (sol::object origin_obj = options["origin"]; origin_obj.is<Vector3f>()) {
+                query.origin = origin_obj.as<Vector3f>();
+            } else if (origin_obj.is<Vector4f>()) {
+                query.origin = origin_obj.as<Vector4f>();
+            } else {
+                throw sol::error("query_scene: radius requires an origin (Vector3f or Vector4f)");
+            }
+        }
+    }
+
+    SceneQueryResults out{};
+    ::sdk::query_scene(query, out.results);
+
+    return sol::make_object(s, std::move(out));
+}
+
 sol::object get_primary_camera(sol::this_state s) {
     return sol::make_object(s, (::REManagedObject*)::sdk::get_primary_camera());
 }
@@ -1219,13 +1859,213 @@ bool is_managed_object(sol::object obj) {
     return utility::re_managed_object::is_managed_object(real_obj);
 }
 
-void hook(sol::this_state s, ::sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_object) {
+// Filter tables look like:
+// {
+//     this = obj or {obj1, obj2, ...},
+//     type = "app.Foo" or a type definition,
+//     args = {{index = 3, eq = 1}, {index = 4, gt = 0.5}, {index = 5, mask = 0xF0, ne = 0}},
+// }
+// args indices are the same as the ones in the pre function's args table.
+std::shared_ptr<const HookManager::HookFilter> parse_hook_filter(::sdk::REMethodDefinition* fn, sol::table filter_table) {
+    using HookFilter = HookManager::HookFilter;
+
+    if (fn == nullptr) {
+        throw sol::error("Method is null");
+    }
+
+    auto filter = std::make_shared<HookFilter>();
+    const auto declaring_type = fn->get_declaring_type();
+    const auto has_managed_this = !fn->is_static() && declaring_type != nullptr && !declaring_type->is_value_type();
+
+    if (sol::object this_obj = filter_table["this"]; this_obj.is<sol::table>()) {
+        if (fn->is_static()) {
+            throw sol::error("Cannot filter a static method by this");
+        }
+
+        for (auto& [_, obj] : this_obj.as<sol::table>()) {
+            filter->this_ptrs.insert((uintptr_t)get_real_obj(obj));
+        }
+    } else if (!this_obj.is<sol::nil_t>()) {
+        if (fn->is_static()) {
+            throw sol::error("Cannot filter a static method by this");
+        }
+
+        filter->this_ptrs.insert((uintptr_t)get_real_obj(this_obj));
+    }
+
+    if (sol::object type_obj = filter_table["type"]; !type_obj.is<sol::nil_t>()) {
+        if (!has_managed_this) {
+            throw sol::error("Type filters are only supported on non-static methods of reference types");
+        }
+
+        if (type_obj.is<::sdk::RETypeDefinition*>()) {
+            filter->this_type = type_obj.as<::sdk::RETypeDefinition*>();
+        } else {
+            filter->this_type = ::sdk::find_type_definition(type_obj.as<std::string>());
+        }
+
+        if (filter->this_type == nullptr) {
+            throw sol::error("Type filter does not refer to a valid type");
+        }
+    }
+
+    if (sol::object args_obj = filter_table["args"]; args_obj.is<sol::table>()) {
+        constexpr std::array<std::pair<std::string_view, HookFilter::Op>, 6> ops{{
+            {"eq", HookFilter::Op::EQ},
+            {"ne", HookFilter::Op::NE},
+            {"lt", HookFilter::Op::LT},
+            {"le", HookFilter::Op::LE},
+            {"gt", HookFilter::Op::GT},
+            {"ge", HookFilter::Op::GE},
+        }};
+
+        const auto param_types = fn->get_param_types();
+        const auto first_param = fn->is_static() ? 1u : 2u;
+
+        for (auto& [_, cmp_obj] : args_obj.as<sol::table>()) {
+            if (!cmp_obj.is<sol::table>()) {
+                throw sol::error("Argument filters must be tables");
+            }
+
+            auto cmp_table = cmp_obj.as<sol::table>();
+            const auto lua_index = cmp_table.get_or<uint32_t>("index", 0);
+
+            if (lua_index == 0 || lua_index - 1 >= first_param + param_types.size()) {
+                throw sol::error("Argument filter index is out of range");
+            }
+
+            HookFilter::ArgCompare base{};
+            base.index = lua_index - 1;
+
+            // Work out the comparison from the parameter's type, registers only hold the low bits of smaller arguments.
+            if (base.index >= first_param) {
+                auto t = param_types[base.index - first_param];
+
+                if (t != nullptr && t->is_enum()) {
+                    if (auto underlying = t->get_underlying_type(); underlying != nullptr) {
+                        t = underlying;
+                    }
+                }
+
+                const auto name_hash = t != nullptr ? utility::hash(t->get_full_name()) : 0;
+
+                switch (name_hash) {
+                case "System.Single"_fnv:
+                    base.kind = HookFilter::Kind::FLOAT;
+                    break;
+                case "System.Double"_fnv:
+                    base.kind = HookFilter::Kind::DOUBLE;
+                    break;
+                case "System.SByte"_fnv:
+                    base.kind = HookFilter::Kind::SIGNED;
+                    base.mask = 0xFF;
+                    break;
+                case "System.Int16"_fnv:
+                    base.kind = HookFilter::Kind::SIGNED;
+                    base.mask = 0xFFFF;
+                    break;
+                case "System.Int32"_fnv:
+                    base.kind = HookFilter::Kind::SIGNED;
+                    base.mask = 0xFFFFFFFF;
+                    break;
+                case "System.Int64"_fnv:
+                    base.kind = HookFilter::Kind::SIGNED;
+                    break;
+                case "System.Boolean"_fnv:
+                case "System.Byte"_fnv:
+                    base.mask = 0xFF;
+                    break;
+                case "System.UInt16"_fnv:
+                case "System.Char"_fnv:
+                    base.mask = 0xFFFF;
+                    break;
+                case "System.UInt32"_fnv:
+                    base.mask = 0xFFFFFFFF;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (sol::object mask_obj = cmp_table["mask"]; !mask_obj.is<sol::nil_t>()) {
+                if (base.kind == HookFilter::Kind::FLOAT || base.kind == HookFilter::Kind::DOUBLE) {
+                    throw sol::error("Masks are not supported on floating point arguments");
+                }
+
+                base.mask &= mask_obj.as<uint64_t>();
+                base.kind = HookFilter::Kind::UNSIGNED;
+            }
+
+            auto found_op = false;
+
+            for (const auto& [op_name, op] : ops) {
+                sol::object value_obj = cmp_table[op_name];
+
+                if (value_obj.is<sol::nil_t>()) {
+                    continue;
+                }
+
+                auto cmp = base;
+                cmp.op = op;
+
+                switch (cmp.kind) {
+                case HookFilter::Kind::FLOAT: {
+                    const auto value = value_obj.as<float>();
+                    memcpy(&cmp.value, &value, sizeof(value));
+                } break;
+                case HookFilter::Kind::DOUBLE: {
+                    const auto value = value_obj.as<double>();
+                    memcpy(&cmp.value, &value, sizeof(value));
+                } break;
+                default:
+                    if (value_obj.is<bool>()) {
+                        cmp.value = value_obj.as<bool>() ? 1 : 0;
+                    } else if (value_obj.get_type() == sol::type::number) {
+                        cmp.value = (uint64_t)value_obj.as<int64_t>();
+                    } else {
+                        cmp.value = (uintptr_t)get_real_obj(value_obj);
+                    }
+
+                    if (cmp.kind == HookFilter::Kind::UNSIGNED) {
+                        cmp.value &= cmp.mask;
+                    }
+
+                    break;
+                }
+
+                filter->args.push_back(cmp);
+                found_op = true;
+            }
+
+            if (!found_op) {
+                throw sol::error("Argument filter has no comparison (eq, ne, lt, le, gt, ge)");
+            }
+        }
+    }
+
+    return filter;
+}
+
+void hook(sol::this_state s, ::sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_object, sol::object filter_obj) {
     auto sol_state = sol::state_view{s};
     auto state = sol_state.registry()["state"].get<ScriptState*>();
-    state->add_hook(fn, pre_cb, post_cb, ignore_jmp_object);
+
+    // sdk.hook(fn, pre, post, filter) is accepted as well.
+    if (ignore_jmp_object.is<sol::table>()) {
+        filter_obj = ignore_jmp_object;
+        ignore_jmp_object = sol::make_object(s, sol::lua_nil);
+    }
+
+    std::shared_ptr<const HookManager::HookFilter> filter{};
+
+    if (filter_obj.is<sol::table>()) {
+        filter = parse_hook_filter(fn, filter_obj.as<sol::table>());
+    }
+
+    state->add_hook(fn, pre_cb, post_cb, ignore_jmp_object, std::move(filter));
 }
 
-void hook_vtable(sol::this_state s, ::REManagedObject* obj, ::sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb) {
+void hook_vtable(sol::this_state s, ::REManagedObject* obj, ::sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object filter_obj) {
     if (obj == nullptr) {
         throw sol::error("Object is null");
         return;
@@ -1233,7 +2073,14 @@ void hook_vtable(sol::this_state s, ::REManagedObject* obj, ::sdk::REMethodDefin
     
     auto sol_state = sol::state_view{s};
     auto state = sol_state.registry()["state"].get<ScriptState*>();
-    state->add_vtable(obj, fn, pre_cb, post_cb);
+
+    std::shared_ptr<const HookManager::HookFilter> filter{};
+
+    if (filter_obj.is<sol::table>()) {
+        filter = parse_hook_filter(fn, filter_obj.as<sol::table>());
+    }
+
+    state->add_vtable(obj, fn, pre_cb, post_cb, std::move(filter));
 }
 }
 
@@ -1376,8 +2223,60 @@ T read_memory(::REManagedObject* obj, int32_t offset) {
 
     return *(T*)((uintptr_t)obj + offset);
 }
+
+// Copies count elements starting at offset in one go instead of one read_* call per element.
+template <typename T>
+api::TypedArray<T> read_array(::REManagedObject* obj, int32_t offset, uint32_t count) {
+    const auto last = (int64_t)offset + (int64_t)count * (int64_t)sizeof(T) - 1;
+
+    if (count == 0 || offset < 0 || last > INT32_MAX || !is_valid_offset(obj, offset) || !is_valid_offset(obj, (int32_t)last)) {
+        return {};
+    }
+
+    return api::TypedArray<T>{(T*)((uintptr_t)obj + offset), count};
+}
 } 
 
+namespace api::system_array {
+// Zero-copy view over the array's elements. System.Single elements come back as a Float32Array,
+// System.Int32 as an Int32Array. The view holds a reference to the array so the memory stays valid
+// for as long as Lua can reach it.
+// Reference types come back as a PtrArray copy of the object addresses instead, writing raw pointers
+// into the array would skip the reference counting and the GC write barrier.
+sol::object to_typed_array(sol::this_state s, ::sdk::SystemArray* arr) {
+    if (arr == nullptr) {
+        return sol::make_object(s, sol::lua_nil);
+    }
+
+    const auto base = (::REArrayBase*)arr;
+    const auto contained_type = utility::re_array::get_contained_type(base);
+
+    if (contained_type == nullptr) {
+        return sol::make_object(s, sol::lua_nil);
+    }
+
+    const auto count = (size_t)std::max<int32_t>(base->numElements, 0);
+    const auto data = utility::re_array::get_inline_element<uint8_t>(base, 0); // same address for pointer elements
+
+    if (!utility::re_array::has_inline_elements(base)) {
+        return sol::make_object(s, api::PtrArray{(const uintptr_t*)data, count});
+    }
+
+    utility::re_managed_object::add_ref(arr);
+    std::shared_ptr<void> owner{arr, [](void* p) { utility::re_managed_object::release((::REManagedObject*)p); }};
+
+    // System.UInt32 is left out, values above INT32_MAX would read back negative through an Int32Array.
+    switch (utility::hash(contained_type->get_full_name())) {
+    case "System.Single"_fnv:
+        return sol::make_object(s, api::Float32Array::view((float*)data, count, std::move(owner)));
+    case "System.Int32"_fnv:
+        return sol::make_object(s, api::Int32Array::view((int32_t*)data, count, std::move(owner)));
+    default:
+        return sol::make_object(s, sol::lua_nil);
+    }
+}
+}
+
 void bindings::open_sdk(ScriptState* s) {
     auto& lua = s->lua();
 
@@ -1416,10 +2315,17 @@ void bindings::open_sdk(ScriptState* s) {
     sdk["call_object_func"] = api::sdk::call_object_func;
     sdk["get_native_field"] = api::sdk::get_native_field;
     sdk["set_native_field"] = api::sdk::set_native_field;
+    sdk["bind_field"] = api::sdk::bind_field;
+    sdk["get_enum"] = api::sdk::get_enum;
+    sdk["get_statics"] = api::sdk::get_statics;
+    sdk["search_types"] = api::sdk::search_types;
+    sdk["symbolize"] = api::sdk::symbolize;
     sdk["get_primary_camera"] = api::sdk::get_primary_camera;
+    sdk["query_scene"] = api::sdk::query_scene;
     sdk["hook"] = api::sdk::hook;
     sdk["hook_vtable"] = api::sdk::hook_vtable;
     sdk.new_enum("PreHookResult", "CALL_ORIGINAL", HookManager::PreHookResult::CALL_ORIGINAL, "SKIP_ORIGINAL", HookManager::PreHookResult::SKIP_ORIGINAL);
+    sdk.new_enum("SkeletonPoseFlags", "LOCAL", ::sdk::SkeletonPoseFlags::LOCAL, "WORLD", ::sdk::SkeletonPoseFlags::WORLD, "ALL", ::sdk::SkeletonPoseFlags::ALL);
     sdk["is_managed_object"] = api::sdk::is_managed_object;
     sdk["to_managed_object"] = [](sol::this_state s, sol::object ptr) { 
         if (ptr.is<::REManagedObject*>()) {
@@ -1638,6 +2544,27 @@ void bindings::open_sdk(ScriptState* s) {
         }
     );
 
+    lua.new_usertype<api::sdk::SceneQueryResults>("SceneQueryResults",
+        "size", &api::sdk::SceneQueryResults::size,
+        "get_size", &api::sdk::SceneQueryResults::size,
+        "get_object", &api::sdk::SceneQueryResults::get_object,
+        "get_game_object", &api::sdk::SceneQueryResults::get_game_object,
+        "get_type", &api::sdk::SceneQueryResults::get_type,
+        "get_position", &api::sdk::SceneQueryResults::get_position,
+        sol::meta_function::index, [](sol::this_state s, api::sdk::SceneQueryResults& results, uint32_t i) {
+            return results.get_object(s, i);
+        },
+        sol::meta_function::length, &api::sdk::SceneQueryResults::size
+    );
+
+    lua.new_usertype<api::sdk::FieldAccessor>("FieldAccessor",
+        sol::meta_function::call, &api::sdk::FieldAccessor::get,
+        "get", &api::sdk::FieldAccessor::get,
+        "set", &api::sdk::FieldAccessor::set,
+        "get_field", &api::sdk::FieldAccessor::get_field,
+        "get_offset", &api::sdk::FieldAccessor::get_offset
+    );
+
     lua.new_usertype<::REManagedObject>("REManagedObject",
         sol::meta_function::equal_to, [s](REManagedObject* lhs, REManagedObject* rhs) { return lhs == rhs; },
         sol::meta_function::index, &api::re_managed_object::index,
@@ -1706,7 +2633,10 @@ void bindings::open_sdk(ScriptState* s) {
         "read_dword", &api::re_managed_object::read_memory<uint32_t>,
         "read_qword", &api::re_managed_object::read_memory<int64_t>,
         "read_float", &api::re_managed_object::read_memory<float>,
-        "read_double", &api::re_managed_object::read_memory<double>
+        "read_double", &api::re_managed_object::read_memory<double>,
+        "read_float32_array", &api::re_managed_object::read_array<float>,
+        "read_int32_array", &api::re_managed_object::read_array<int32_t>,
+        "read_ptr_array", &api::re_managed_object::read_array<uintptr_t>
     );
 
     // templated lambda
@@ -1740,6 +2670,70 @@ void bindings::open_sdk(ScriptState* s) {
 
     create_managed_object_ptr_gc((::REComponent*)nullptr);
 
+    // Joint indices are 0 based, same as the transform's joint array and REJointDesc::parentJoint.
+    auto check_pose_index = [](const ::sdk::SkeletonPose& pose, size_t count, int32_t index) {
+        if (index < 0 || (size_t)index >= pose.size() || (size_t)index >= count) {
+            throw sol::error(fmt::format("SkeletonPose index {} out of range (size {})", index, pose.size()));
+        }
+    };
+
+    lua.new_usertype<::sdk::SkeletonPose>("SkeletonPose",
+        "size", &::sdk::SkeletonPose::size,
+        "find", [](::sdk::SkeletonPose& pose, const char* name) {
+            return pose.skeleton != nullptr ? pose.skeleton->find(utility::widen(name)) : -1;
+        },
+        "get_joint", [](sol::this_state s, ::sdk::SkeletonPose& pose, int32_t index) {
+            if (index < 0 || (size_t)index >= pose.size()) {
+                return sol::make_object(s, sol::nil);
+            }
+
+            return sol::make_object(s, (::REManagedObject*)pose.skeleton->joints[index]);
+        },
+        "get_parent", [](::sdk::SkeletonPose& pose, int32_t index) {
+            if (index < 0 || (size_t)index >= pose.size()) {
+                return -1;
+            }
+
+            return pose.skeleton->parents[index];
+        },
+        "get_bind_matrix", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index) {
+            check_pose_index(pose, pose.size(), index);
+            return pose.skeleton->bind_pose[index];
+        },
+        "get_local_position", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index) {
+            check_pose_index(pose, pose.local_positions.size(), index);
+            return pose.local_positions[index];
+        },
+        "set_local_position", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index, const Vector4f& value) {
+            check_pose_index(pose, pose.local_positions.size(), index);
+            pose.local_positions[index] = value;
+        },
+        "get_local_rotation", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index) {
+            check_pose_index(pose, pose.local_rotations.size(), index);
+            return pose.local_rotations[index];
+        },
+        "set_local_rotation", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index, const glm::quat& value) {
+            check_pose_index(pose, pose.local_rotations.size(), index);
+            pose.local_rotations[index] = value;
+        },
+        "get_local_scale", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index) {
+            check_pose_index(pose, pose.local_scales.size(), index);
+            return pose.local_scales[index];
+        },
+        "set_local_scale", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index, const Vector4f& value) {
+            check_pose_index(pose, pose.local_scales.size(), index);
+            pose.local_scales[index] = value;
+        },
+        "get_world_matrix", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index) {
+            check_pose_index(pose, pose.world_matrices.size(), index);
+            return pose.world_matrices[index];
+        },
+        "set_world_matrix", [check_pose_index](::sdk::SkeletonPose& pose, int32_t index, const Matrix4x4f& value) {
+            check_pose_index(pose, pose.world_matrices.size(), index);
+            pose.world_matrices[index] = value;
+        }
+    );
+
     lua.new_usertype<RETransform>("RETransform",
         sol::meta_function::index, &api::re_managed_object::index,
         sol::meta_function::new_index, &api::re_managed_object::new_index,
@@ -1766,6 +2760,41 @@ void bindings::open_sdk(ScriptState* s) {
 
             utility::re_transform::apply_joints_tpose(*t, joints_vec, additional_parents);
         },
+        // Pass a previous pose back in to reuse its buffers.
+        "get_pose", [](sol::this_state s, RETransform* t, sol::object reuse, sol::object flags_obj) -> sol::object {
+            if (t == nullptr) {
+                return sol::make_object(s, sol::nil);
+            }
+
+            const auto flags = flags_obj.is<uint32_t>() ? flags_obj.as<uint32_t>() : (uint32_t)::sdk::SkeletonPoseFlags::ALL;
+
+            if (reuse.is<::sdk::SkeletonPose*>()) {
+                auto pose = reuse.as<::sdk::SkeletonPose*>();
+
+                if (!::sdk::read_skeleton_pose(*t, *pose, flags)) {
+                    return sol::make_object(s, sol::nil);
+                }
+
+                return reuse;
+            }
+
+            ::sdk::SkeletonPose pose{};
+
+            if (!::sdk::read_skeleton_pose(*t, pose, flags)) {
+                return sol::make_object(s, sol::nil);
+            }
+
+            return sol::make_object(s, std::move(pose));
+        },
+        "set_pose", [](RETransform* t, ::sdk::SkeletonPose* pose, sol::object flags_obj) {
+            if (t == nullptr || pose == nullptr) {
+                return false;
+            }
+
+            const auto flags = flags_obj.is<uint32_t>() ? flags_obj.as<uint32_t>() : (uint32_t)::sdk::SkeletonPoseFlags::LOCAL;
+
+            return ::sdk::write_skeleton_pose(*t, *pose, flags);
+        },
         "set_position", &sdk::set_transform_position,
         "set_rotation", &sdk::set_transform_rotation,
         "get_position", &sdk::get_transform_position,
@@ -1779,6 +2808,7 @@ void bindings::open_sdk(ScriptState* s) {
         "get_size", &sdk::SystemArray::get_size,
         "get_element", &sdk::SystemArray::get_element,
         "get_elements", &sdk::SystemArray::get_elements,
+        "to_typed_array", &api::system_array::to_typed_array,
         sol::meta_function::index, [](sol::this_state s, sdk::SystemArray* arr, sol::variadic_args args) {
             auto index = args[0];
             if (index.is<int32_t>()) {
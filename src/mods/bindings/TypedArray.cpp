@@ -0,0 +1,36 @@
+#include "../ScriptRunner.hpp"
+
+#include "TypedArray.hpp"
+
+namespace api::typed_array {
+template <typename T>
+void register_type(sol::state& lua, const char* name) {
+    using Array = TypedArray<T>;
+
+    lua.new_usertype<Array>(name,
+        sol::meta_function::construct, sol::factories([](size_t count) { return Array{count}; }),
+        "from", &Array::from,
+        // Raw memory, e.g. a NativeArray's elements. Nothing keeps it alive, same rules as MemoryView.
+        "view", [](uintptr_t address, size_t count) { return Array::view((T*)address, count, nullptr); },
+        "size", &Array::size,
+        "slice", &Array::slice,
+        "copy", &Array::copy,
+        "fill", &Array::fill,
+        "to_table", &Array::to_table,
+        "address", &Array::address,
+        "get_address", &Array::address,
+        sol::meta_function::length, &Array::size,
+        sol::meta_function::index, &Array::get,
+        sol::meta_function::new_index, &Array::set,
+        sol::meta_function::to_string, [name](Array& arr) { return std::string{name} + "(" + std::to_string(arr.size()) + ")"; }
+    );
+}
+}
+
+void bindings::open_typed_array(ScriptState* s) {
+    auto& lua = s->lua();
+
+    api::typed_array::register_type<float>(lua, "Float32Array");
+    api::typed_array::register_type<int32_t>(lua, "Int32Array");
+    api::typed_array::register_type<uintptr_t>(lua, "PtrArray");
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+class ScriptState;
+
+namespace api {
+// Packed array of T exposed to Lua as a single userdata (Float32Array, Int32Array, PtrArray).
+// Either owns its storage or views memory owned by someone else, e.g. the elements of a System.Array.
+// m_owner keeps whatever backs m_data alive, so slices and views never copy.
+// Lua indices are 1 based like tables, # is the element count.
+template <typename T>
+class TypedArray {
+public:
+    using value_type = T;
+
+    TypedArray() = default;
+
+    explicit TypedArray(size_t count) {
+        auto storage = std::make_shared<std::vector<T>>(count);
+        m_data = storage->data();
+        m_size = count;
+        m_owner = std::move(storage);
+    }
+
+    TypedArray(const T* values, size_t count)
+        : TypedArray{count}
+    {
+        std::copy_n(values, count, m_data);
+    }
+
+    // owner may be null for raw memory the caller vouches for (like MemoryView).
+    static TypedArray view(T* data, size_t count, std::shared_ptr<void> owner) {
+        TypedArray out{};
+        out.m_data = data;
+        out.m_size = count;
+        out.m_owner = std::move(owner);
+        return out;
+    }
+
+    T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // 1 based, nil when out of range
+    sol::object get(sol::this_state s, int64_t index) const {
+        if (index < 1 || (uint64_t)index > m_size) {
+            return sol::make_object(s, sol::lua_nil);
+        }
+
+        return sol::make_object(s, m_data[index - 1]);
+    }
+
+    void set(int64_t index, T value) {
+        if (index < 1 || (uint64_t)index > m_size) {
+            throw sol::error{"TypedArray index out of range"};
+        }
+
+        m_data[index - 1] = value;
+    }
+
+    // Inclusive range like string.sub, negative indices count from the end. Shares the memory.
+    TypedArray slice(int64_t first, sol::object last_obj) const {
+        auto last = last_obj.is<int64_t>() ? last_obj.as<int64_t>() : (int64_t)m_size;
+
+        if (first < 0) {
+            first += (int64_t)m_size + 1;
+        }
+
+        if (last < 0) {
+            last += (int64_t)m_size + 1;
+        }
+
+        first = std::max<int64_t>(first, 1);
+        last = std::min<int64_t>(last, (int64_t)m_size);
+
+        if (first > last) {
+            return TypedArray{};
+        }
+
+        return view(m_data + (first - 1), (size_t)(last - first + 1), m_owner);
+    }
+
+    TypedArray copy() const {
+        return TypedArray{m_data, m_size};
+    }
+
+    void fill(T value) {
+        std::fill_n(m_data, m_size, value);
+    }
+
+    sol::table to_table(sol::this_state s) const {
+        auto l = s.lua_state();
+        lua_createtable(l, (int)m_size, 0);
+
+        for (size_t i = 0; i < m_size; ++i) {
+            sol::stack::push(l, m_data[i]);
+            lua_rawseti(l, -2, (lua_Integer)(i + 1));
+        }
+
+        sol::table out{l, -1};
+        lua_pop(l, 1);
+
+        return out;
+    }
+
+    uintptr_t address() const {
+        return (uintptr_t)m_data;
+    }
+
+    // Accepts a table of numbers or another TypedArray<T> (copied).
+    static TypedArray from(sol::object obj) {
+        if (obj.is<TypedArray&>()) {
+            return obj.as<TypedArray&>().copy();
+        }
+
+        if (!obj.is<sol::table>()) {
+            throw sol::error{"Expected a table"};
+        }
+
+        auto table = obj.as<sol::table>();
+        TypedArray out{table.size()};
+
+        for (size_t i = 0; i < out.m_size; ++i) {
+            out.m_data[i] = table.raw_get<T>(i + 1);
+        }
+
+        return out;
+    }
+
+private:
+    std::shared_ptr<void> m_owner{};
+    T* m_data{};
+    size_t m_size{};
+};
+
+using Float32Array = TypedArray<float>;
+using Int32Array = TypedArray<int32_t>;
+using PtrArray = TypedArray<uintptr_t>;
+}
+
+namespace bindings {
+void open_typed_array(ScriptState* s);
+}
@@ -0,0 +1,752 @@
+#include <bit>
+#include <cmath>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "../ScriptRunner.hpp"
+#include "sdk/SceneManager.hpp"
+
+#include "TypedArray.hpp"
+#include "VMath.hpp"
+
+namespace api::vmath::kernels {
+namespace detail {
+// row of a column major matrix dotted with (x, y, z, 1)
+__m128 row_dot(const float m[16], int row, __m128 x, __m128 y, __m128 z) {
+    const auto xy = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[row])), _mm_mul_ps(y, _mm_set1_ps(m[4 + row])));
+    const auto zw = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(m[8 + row])), _mm_set1_ps(m[12 + row]));
+    return _mm_add_ps(xy, zw);
+}
+
+float row_dot(const float m[16], int row, float x, float y, float z) {
+    return m[row] * x + m[4 + row] * y + m[8 + row] * z + m[12 + row];
+}
+
+float hsum(__m128 v) {
+    const auto shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    const auto sums = _mm_add_ps(v, shuf);
+    return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuf, sums)));
+}
+}
+
+void distances(const Points& points, const float origin[3], float* out) {
+    const auto ox = _mm_set1_ps(origin[0]);
+    const auto oy = _mm_set1_ps(origin[1]);
+    const auto oz = _mm_set1_ps(origin[2]);
+
+    size_t i = 0;
+
+    for (; i + 4 <= points.count; i += 4) {
+        const auto dx = _mm_sub_ps(_mm_loadu_ps(points.x + i), ox);
+        const auto dy = _mm_sub_ps(_mm_loadu_ps(points.y + i), oy);
+        const auto dz = _mm_sub_ps(_mm_loadu_ps(points.z + i), oz);
+        const auto sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        _mm_storeu_ps(out + i, _mm_sqrt_ps(sq));
+    }
+
+    for (; i < points.count; ++i) {
+        const auto dx = points.x[i] - origin[0];
+        const auto dy = points.y[i] - origin[1];
+        const auto dz = points.z[i] - origin[2];
+
+        out[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+size_t within_distance(const Points& points, const float origin[3], float radius, uint32_t* out_indices) {
+    const auto ox = _mm_set1_ps(origin[0]);
+    const auto oy = _mm_set1_ps(origin[1]);
+    const auto oz = _mm_set1_ps(origin[2]);
+    const auto radius_sq = radius * radius;
+    const auto r2 = _mm_set1_ps(radius_sq);
+
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= points.count; i += 4) {
+        const auto dx = _mm_sub_ps(_mm_loadu_ps(points.x + i), ox);
+        const auto dy = _mm_sub_ps(_mm_loadu_ps(points.y + i), oy);
+        const auto dz = _mm_sub_ps(_mm_loadu_ps(points.z + i), oz);
+        const auto sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        auto mask = _mm_movemask_ps(_mm_cmple_ps(sq, r2));
+
+        while (mask != 0) {
+            const auto lane = std::countr_zero((uint32_t)mask);
+            out_indices[count++] = (uint32_t)(i + lane);
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i < points.count; ++i) {
+        const auto dx = points.x[i] - origin[0];
+        const auto dy = points.y[i] - origin[1];
+        const auto dz = points.z[i] - origin[2];
+
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+            out_indices[count++] = (uint32_t)i;
+        }
+    }
+
+    return count;
+}
+
+void extract_frustum_planes(const float m[16], float out_planes[5][4]) {
+    const auto row = [&](int r, int c) { return m[c * 4 + r]; };
+
+    // Gribb/Hartmann. The far plane is left out, it degenerates with the infinite projections the engine uses.
+    constexpr int sides[4][2] = {{0, 1}, {0, -1}, {1, 1}, {1, -1}};
+
+    for (int p = 0; p < 4; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            out_planes[p][c] = row(3, c) + (float)sides[p][1] * row(sides[p][0], c);
+        }
+    }
+
+    for (int c = 0; c < 4; ++c) {
+        out_planes[4][c] = row(3, c);
+    }
+
+    for (int p = 0; p < 5; ++p) {
+        auto& plane = out_planes[p];
+        const auto length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+
+        if (length > 0.0f) {
+            for (auto& v : plane) {
+                v /= length;
+            }
+        }
+    }
+}
+
+void spheres_in_frustum(const Points& points, const float planes[5][4], float radius, uint8_t* out) {
+    const auto neg_radius = _mm_set1_ps(-radius);
+
+    size_t i = 0;
+
+    for (; i + 4 <= points.count; i += 4) {
+        const auto x = _mm_loadu_ps(points.x + i);
+        const auto y = _mm_loadu_ps(points.y + i);
+        const auto z = _mm_loadu_ps(points.z + i);
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int p = 0; p < 5; ++p) {
+            const auto dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p][0])), _mm_mul_ps(y, _mm_set1_ps(planes[p][1]))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(planes[p][2])), _mm_set1_ps(planes[p][3])));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, neg_radius));
+        }
+
+        const auto mask = _mm_movemask_ps(inside);
+
+        for (int lane = 0; lane < 4; ++lane) {
+            out[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    for (; i < points.count; ++i) {
+        bool inside = true;
+
+        for (int p = 0; p < 5 && inside; ++p) {
+            inside = points.x[i] * planes[p][0] + points.y[i] * planes[p][1] + points.z[i] * planes[p][2] + planes[p][3] >= -radius;
+        }
+
+        out[i] = inside ? 1 : 0;
+    }
+}
+
+void world_to_screen(const Points& points, const float m[16], float width, float height, float* out_x, float* out_y, uint8_t* out_visible) {
+    constexpr auto MIN_W = 1e-5f;
+
+    const auto half_w = _mm_set1_ps(width * 0.5f);
+    const auto half_h = _mm_set1_ps(height * 0.5f);
+    const auto min_w = _mm_set1_ps(MIN_W);
+
+    size_t i = 0;
+
+    for (; i + 4 <= points.count; i += 4) {
+        const auto x = _mm_loadu_ps(points.x + i);
+        const auto y = _mm_loadu_ps(points.y + i);
+        const auto z = _mm_loadu_ps(points.z + i);
+
+        const auto cx = detail::row_dot(m, 0, x, y, z);
+        const auto cy = detail::row_dot(m, 1, x, y, z);
+        const auto cw = detail::row_dot(m, 3, x, y, z);
+
+        const auto visible = _mm_cmpgt_ps(cw, min_w);
+        const auto inv_w = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(cw, min_w));
+
+        // ndc x [-1, 1] -> [0, width], ndc y [-1, 1] -> [height, 0]
+        const auto sx = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, inv_w), _mm_set1_ps(1.0f)), half_w);
+        const auto sy = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(cy, inv_w)), half_h);
+
+        _mm_storeu_ps(out_x + i, _mm_and_ps(sx, visible));
+        _mm_storeu_ps(out_y + i, _mm_and_ps(sy, visible));
+
+        const auto mask = _mm_movemask_ps(visible);
+
+        for (int lane = 0; lane < 4; ++lane) {
+            out_visible[i + lane] = (mask >> lane) & 1;
+        }
+    }
+
+    for (; i < points.count; ++i) {
+        const auto cx = detail::row_dot(m, 0, points.x[i], points.y[i], points.z[i]);
+        const auto cy = detail::row_dot(m, 1, points.x[i], points.y[i], points.z[i]);
+        const auto cw = detail::row_dot(m, 3, points.x[i], points.y[i], points.z[i]);
+
+        if (cw <= MIN_W) {
+            out_x[i] = 0.0f;
+            out_y[i] = 0.0f;
+            out_visible[i] = 0;
+            continue;
+        }
+
+        out_x[i] = (cx / cw + 1.0f) * width * 0.5f;
+        out_y[i] = (1.0f - cy / cw) * height * 0.5f;
+        out_visible[i] = 1;
+    }
+}
+
+void transform_points(const Points& points, const float m[16], float* out_x, float* out_y, float* out_z) {
+    size_t i = 0;
+
+    for (; i + 4 <= points.count; i += 4) {
+        const auto x = _mm_loadu_ps(points.x + i);
+        const auto y = _mm_loadu_ps(points.y + i);
+        const auto z = _mm_loadu_ps(points.z + i);
+
+        _mm_storeu_ps(out_x + i, detail::row_dot(m, 0, x, y, z));
+        _mm_storeu_ps(out_y + i, detail::row_dot(m, 1, x, y, z));
+        _mm_storeu_ps(out_z + i, detail::row_dot(m, 2, x, y, z));
+    }
+
+    for (; i < points.count; ++i) {
+        const auto x = points.x[i];
+        const auto y = points.y[i];
+        const auto z = points.z[i];
+
+        out_x[i] = detail::row_dot(m, 0, x, y, z);
+        out_y[i] = detail::row_dot(m, 1, x, y, z);
+        out_z[i] = detail::row_dot(m, 2, x, y, z);
+    }
+}
+
+void slerp(const float* from, const float* to, const float* t, size_t t_count, size_t count, float* out) {
+    // Each quaternion already fills a register, only the angle needs scalar math.
+    for (size_t i = 0; i < count; ++i) {
+        const auto a = _mm_loadu_ps(from + i * 4);
+        auto b = _mm_loadu_ps(to + i * 4);
+        const auto ti = t_count == 1 ? t[0] : t[i];
+
+        auto cos_theta = detail::hsum(_mm_mul_ps(a, b));
+
+        // Take the short way around
+        if (cos_theta < 0.0f) {
+            b = _mm_sub_ps(_mm_setzero_ps(), b);
+            cos_theta = -cos_theta;
+        }
+
+        float wa{}, wb{};
+
+        // Nearly identical, lerp to avoid dividing by sin(theta) ~ 0
+        if (cos_theta > 0.9995f) {
+            wa = 1.0f - ti;
+            wb = ti;
+        } else {
+            const auto theta = std::acos(cos_theta);
+            const auto inv_sin = 1.0f / std::sin(theta);
+
+            wa = std::sin((1.0f - ti) * theta) * inv_sin;
+            wb = std::sin(ti * theta) * inv_sin;
+        }
+
+        auto q = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(wa)), _mm_mul_ps(b, _mm_set1_ps(wb)));
+        const auto length_sq = detail::hsum(_mm_mul_ps(q, q));
+
+        if (length_sq > 0.0f) {
+            q = _mm_mul_ps(q, _mm_set1_ps(1.0f / std::sqrt(length_sq)));
+        }
+
+        _mm_storeu_ps(out + i * 4, q);
+    }
+}
+} // namespace api::vmath::kernels
+
+namespace api::vmath {
+namespace detail {
+// Unpacks points into storage (all x, then all y, then all z).
+// Accepts a Float32Array or flat table of numbers (x1, y1, z1, x2, ...), or a table of Vector3f/Vector4f.
+kernels::Points read_points(sol::this_state s, sol::object obj, std::vector<float>& storage) {
+    if (obj.is<api::Float32Array>()) {
+        const auto& arr = obj.as<api::Float32Array&>();
+
+        if (arr.size() % 3 != 0) {
+            throw sol::error{"Point arrays must hold 3 floats per point"};
+        }
+
+        const auto count = arr.size() / 3;
+        storage.resize(arr.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            storage[i] = arr.data()[i * 3];
+            storage[count + i] = arr.data()[i * 3 + 1];
+            storage[count * 2 + i] = arr.data()[i * 3 + 2];
+        }
+
+        return kernels::Points{storage.data(), storage.data() + count, storage.data() + count * 2, count};
+    }
+
+    if (!obj.is<sol::table>()) {
+        throw sol::error{"Expected a table of points"};
+    }
+
+    auto l = s.lua_state();
+    obj.push(l);
+
+    const auto len = lua_rawlen(l, -1);
+    lua_rawgeti(l, -1, 1);
+    const auto flat = lua_type(l, -1) == LUA_TNUMBER;
+    lua_pop(l, 1);
+
+    if (flat && len % 3 != 0) {
+        lua_pop(l, 1);
+        throw sol::error{"Flat point tables must hold 3 numbers per point"};
+    }
+
+    const auto count = flat ? len / 3 : len;
+    storage.resize(count * 3);
+
+    auto x = storage.data();
+    auto y = x + count;
+    auto z = y + count;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (flat) {
+            for (auto [dst, offset] : {std::pair{x, 1}, std::pair{y, 2}, std::pair{z, 3}}) {
+                lua_rawgeti(l, -1, (lua_Integer)(i * 3 + offset));
+                dst[i] = (float)lua_tonumber(l, -1);
+                lua_pop(l, 1);
+            }
+
+            continue;
+        }
+
+        lua_rawgeti(l, -1, (lua_Integer)(i + 1));
+
+        if (sol::stack::check<Vector3f>(l, -1)) {
+            const auto& v = sol::stack::get<Vector3f&>(l, -1);
+            x[i] = v.x;
+            y[i] = v.y;
+            z[i] = v.z;
+        } else if (sol::stack::check<Vector4f>(l, -1)) {
+            const auto& v = sol::stack::get<Vector4f&>(l, -1);
+            x[i] = v.x;
+            y[i] = v.y;
+            z[i] = v.z;
+        } else {
+            lua_pop(l, 2);
+            throw sol::error{"Point tables must hold numbers, Vector3f or Vector4f"};
+        }
+
+        lua_pop(l, 1);
+    }
+
+    lua_pop(l, 1);
+
+    return kernels::Points{x, y, z, count};
+}
+
+// Float32Array or flat table of numbers (x, y, z, w, ...), or a table of Quaternion
+void read_quats(sol::this_state s, sol::object obj, std::vector<float>& storage) {
+    if (obj.is<api::Float32Array>()) {
+        const auto& arr = obj.as<api::Float32Array&>();
+
+        if (arr.size() % 4 != 0) {
+            throw sol::error{"Quaternion arrays must hold 4 floats per quaternion"};
+        }
+
+        storage.assign(arr.data(), arr.data() + arr.size());
+        return;
+    }
+
+    if (!obj.is<sol::table>()) {
+        throw sol::error{"Expected a table of quaternions"};
+    }
+
+    auto l = s.lua_state();
+    obj.push(l);
+
+    const auto len = lua_rawlen(l, -1);
+    lua_rawgeti(l, -1, 1);
+    const auto flat = lua_type(l, -1) == LUA_TNUMBER;
+    lua_pop(l, 1);
+
+    if (flat) {
+        if (len % 4 != 0) {
+            lua_pop(l, 1);
+            throw sol::error{"Flat quaternion tables must hold 4 numbers per quaternion"};
+        }
+
+        storage.resize(len);
+
+        for (size_t i = 0; i < len; ++i) {
+            lua_rawgeti(l, -1, (lua_Integer)(i + 1));
+            storage[i] = (float)lua_tonumber(l, -1);
+            lua_pop(l, 1);
+        }
+    } else {
+        storage.resize(len * 4);
+
+        for (size_t i = 0; i < len; ++i) {
+            lua_rawgeti(l, -1, (lua_Integer)(i + 1));
+
+            if (!sol::stack::check<glm::quat>(l, -1)) {
+                lua_pop(l, 2);
+                throw sol::error{"Quaternion tables must hold numbers or Quaternion"};
+            }
+
+            const auto& q = sol::stack::get<glm::quat&>(l, -1);
+            storage[i * 4 + 0] = q.x;
+            storage[i * 4 + 1] = q.y;
+            storage[i * 4 + 2] = q.z;
+            storage[i * 4 + 3] = q.w;
+            lua_pop(l, 1);
+        }
+    }
+
+    lua_pop(l, 1);
+}
+
+Vector3f read_vec3(sol::object obj) {
+    if (obj.is<Vector3f>()) {
+        return obj.as<Vector3f&>();
+    }
+
+    if (obj.is<Vector4f>()) {
+        const auto& v = obj.as<Vector4f&>();
+        return Vector3f{v.x, v.y, v.z};
+    }
+
+    throw sol::error{"Expected a Vector3f or Vector4f"};
+}
+
+// Results come back as typed arrays when the input was one, tables otherwise.
+template <typename T>
+sol::object make_result(sol::this_state s, const T* values, size_t count, bool typed) {
+    if (typed) {
+        if constexpr (std::is_same_v<T, float>) {
+            return sol::make_object(s, api::Float32Array{values, count});
+        } else {
+            api::Int32Array out{count};
+            std::copy_n(values, count, out.data());
+            return sol::make_object(s, std::move(out));
+        }
+    }
+
+    auto l = s.lua_state();
+    lua_createtable(l, (int)count, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        if constexpr (std::is_same_v<T, uint8_t>) {
+            lua_pushboolean(l, values[i] != 0);
+        } else {
+            lua_pushnumber(l, (lua_Number)values[i]);
+        }
+
+        lua_rawseti(l, -2, (lua_Integer)(i + 1));
+    }
+
+    sol::table out{l, -1};
+    lua_pop(l, 1);
+
+    return out;
+}
+
+// Interleaves the component arrays back into x1, y1, (z1), x2, ...
+sol::object make_interleaved_result(sol::this_state s, std::initializer_list<const float*> components, size_t count, bool typed) {
+    const auto stride = components.size();
+
+    if (typed) {
+        api::Float32Array out{count * stride};
+        auto dst = out.data();
+
+        for (size_t i = 0; i < count; ++i) {
+            for (auto component : components) {
+                *dst++ = component[i];
+            }
+        }
+
+        return sol::make_object(s, std::move(out));
+    }
+
+    auto l = s.lua_state();
+    lua_createtable(l, (int)(count * stride), 0);
+
+    lua_Integer index = 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        for (auto component : components) {
+            lua_pushnumber(l, (lua_Number)component[i]);
+            lua_rawseti(l, -2, index++);
+        }
+    }
+
+    sol::table out{l, -1};
+    lua_pop(l, 1);
+
+    return out;
+}
+
+// Same matrices and window size draw.world_to_screen goes through, combined once for the whole batch.
+std::optional<std::tuple<Matrix4x4f, float, float>> get_camera_view_projection() {
+    auto context = sdk::get_thread_context();
+    auto camera = sdk::get_primary_camera();
+    auto main_view = sdk::get_main_view();
+
+    if (camera == nullptr || main_view == nullptr) {
+        return std::nullopt;
+    }
+
+    Matrix4x4f proj{}, view{};
+    float screen_size[2]{};
+    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
+    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
+    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+
+    return std::make_tuple(proj * view, screen_size[0], screen_size[1]);
+}
+
+Matrix4x4f read_view_projection(sol::object obj) {
+    if (obj.is<Matrix4x4f>()) {
+        return obj.as<Matrix4x4f&>();
+    }
+
+    if (!obj.is<sol::nil_t>()) {
+        throw sol::error{"Expected a Matrix4x4f or nil"};
+    }
+
+    auto camera = get_camera_view_projection();
+
+    if (!camera) {
+        throw sol::error{"No camera to take the view projection from"};
+    }
+
+    return std::get<0>(*camera);
+}
+
+// 1 based, to index the tables/arrays the points came from
+sol::object to_indices(sol::this_state s, const uint32_t* indices, size_t count, bool typed) {
+    if (typed) {
+        api::Int32Array out{count};
+
+        for (size_t i = 0; i < count; ++i) {
+            out.data()[i] = (int32_t)indices[i] + 1;
+        }
+
+        return sol::make_object(s, std::move(out));
+    }
+
+    auto l = s.lua_state();
+    lua_createtable(l, (int)count, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        lua_pushinteger(l, (lua_Integer)indices[i] + 1);
+        lua_rawseti(l, -2, (lua_Integer)(i + 1));
+    }
+
+    sol::table out{l, -1};
+    lua_pop(l, 1);
+
+    return out;
+}
+
+// Scratch buffers reused between calls, all of this runs on the script thread.
+thread_local std::vector<float> g_points{};
+thread_local std::vector<float> g_results{};
+thread_local std::vector<uint8_t> g_flags{};
+thread_local std::vector<uint32_t> g_indices{};
+}
+
+// Typed arrays in give typed arrays out: Float32Array for numbers, Int32Array for indices and visibility.
+
+// vmath.distances(points, origin) -> {distance, ...}
+sol::object distances(sol::this_state s, sol::object points_obj, sol::object origin_obj) {
+    const auto points = detail::read_points(s, points_obj, detail::g_points);
+    const auto origin = detail::read_vec3(origin_obj);
+
+    detail::g_results.resize(points.count);
+    kernels::distances(points, &origin.x, detail::g_results.data());
+
+    return detail::make_result(s, detail::g_results.data(), points.count, points_obj.is<api::Float32Array>());
+}
+
+// vmath.within_distance(points, origin, radius) -> {index, ...}
+sol::object within_distance(sol::this_state s, sol::object points_obj, sol::object origin_obj, float radius) {
+    const auto points = detail::read_points(s, points_obj, detail::g_points);
+    const auto origin = detail::read_vec3(origin_obj);
+
+    detail::g_indices.resize(points.count);
+    const auto count = kernels::within_distance(points, &origin.x, radius, detail::g_indices.data());
+
+    return detail::to_indices(s, detail::g_indices.data(), count, points_obj.is<api::Float32Array>());
+}
+
+// vmath.in_frustum(points, [view_proj], [radius]) -> {index, ...}
+sol::object in_frustum(sol::this_state s, sol::object points_obj, sol::object view_proj_obj, sol::object radius_obj) {
+    const auto points = detail::read_points(s, points_obj, detail::g_points);
+    const auto view_proj = detail::read_view_projection(view_proj_obj);
+    const auto radius = radius_obj.is<float>() ? radius_obj.as<float>() : 0.0f;
+
+    float planes[5][4]{};
+    kernels::extract_frustum_planes(&view_proj[0][0], planes);
+
+    detail::g_flags.resize(points.count);
+    kernels::spheres_in_frustum(points, planes, radius, detail::g_flags.data());
+
+    detail::g_indices.clear();
+
+    for (size_t i = 0; i < points.count; ++i) {
+        if (detail::g_flags[i] != 0) {
+            detail::g_indices.push_back((uint32_t)i);
+        }
+    }
+
+    return detail::to_indices(s, detail::g_indices.data(), detail::g_indices.size(), points_obj.is<api::Float32Array>());
+}
+
+// vmath.world_to_screen(points, [view_proj, width, height]) -> {x1, y1, x2, y2, ...}, {visible, ...}
+std::tuple<sol::object, sol::object> world_to_screen(sol::this_state s, sol::object points_obj, sol::object view_proj_obj, sol::object width_obj, sol::object height_obj) {
+    const auto points = detail::read_points(s, points_obj, detail::g_points);
+
+    Matrix4x4f view_proj{};
+    float width{}, height{};
+
+    if (view_proj_obj.is<sol::nil_t>()) {
+        auto camera = detail::get_camera_view_projection();
+
+        if (!camera) {
+            throw sol::error{"No camera to take the view projection from"};
+        }
+
+        std::tie(view_proj, width, height) = *camera;
+    } else {
+        view_proj = detail::read_view_projection(view_proj_obj);
+
+        if (!width_obj.is<float>() || !height_obj.is<float>()) {
+            throw sol::error{"width and height are required along with view_proj"};
+        }
+
+        width = width_obj.as<float>();
+        height = height_obj.as<float>();
+    }
+
+    detail::g_results.resize(points.count * 2);
+    detail::g_flags.resize(points.count);
+
+    const auto out_x = detail::g_results.data();
+    const auto out_y = out_x + points.count;
+    kernels::world_to_screen(points, &view_proj[0][0], width, height, out_x, out_y, detail::g_flags.data());
+
+    const auto typed = points_obj.is<api::Float32Array>();
+
+    return std::make_tuple(
+        detail::make_interleaved_result(s, {out_x, out_y}, points.count, typed),
+        detail::make_result(s, detail::g_flags.data(), points.count, typed));
+}
+
+// vmath.transform(points, matrix) -> {x1, y1, z1, x2, ...}
+sol::object transform(sol::this_state s, sol::object points_obj, Matrix4x4f& m) {
+    const auto points = detail::read_points(s, points_obj, detail::g_points);
+
+    detail::g_results.resize(points.count * 3);
+
+    const auto out_x = detail::g_results.data();
+    const auto out_y = out_x + points.count;
+    const auto out_z = out_y + points.count;
+    kernels::transform_points(points, &m[0][0], out_x, out_y, out_z);
+
+    return detail::make_interleaved_result(s, {out_x, out_y, out_z}, points.count, points_obj.is<api::Float32Array>());
+}
+
+// vmath.slerp(from, to, t) -> {x1, y1, z1, w1, x2, ...}, t is a number or a table with one per quaternion
+sol::object slerp(sol::this_state s, sol::object from_obj, sol::object to_obj, sol::object t_obj) {
+    thread_local std::vector<float> to{};
+    thread_local std::vector<float> t{};
+
+    detail::read_quats(s, from_obj, detail::g_points);
+    detail::read_quats(s, to_obj, to);
+
+    if (detail::g_points.size() != to.size()) {
+        throw sol::error{"from and to must hold the same number of quaternions"};
+    }
+
+    const auto count = to.size() / 4;
+
+    if (t_obj.is<float>()) {
+        t.assign(1, t_obj.as<float>());
+    } else if (t_obj.is<api::Float32Array>()) {
+        const auto& t_array = t_obj.as<api::Float32Array&>();
+        t.assign(t_array.data(), t_array.data() + t_array.size());
+
+        if (t.size() != count) {
+            throw sol::error{"t must be a number or hold one value per quaternion"};
+        }
+    } else if (t_obj.is<sol::table>()) {
+        auto t_table = t_obj.as<sol::table>();
+        t.resize(t_table.size());
+
+        for (size_t i = 0; i < t.size(); ++i) {
+            t[i] = t_table.raw_get<float>(i + 1);
+        }
+
+        if (t.size() != count) {
+            throw sol::error{"t must be a number or hold one value per quaternion"};
+        }
+    } else {
+        throw sol::error{"t must be a number, a table or a Float32Array"};
+    }
+
+    detail::g_results.resize(count * 4);
+    kernels::slerp(detail::g_points.data(), to.data(), t.data(), t.size(), count, detail::g_results.data());
+
+    return detail::make_result(s, detail::g_results.data(), count * 4, from_obj.is<api::Float32Array>());
+}
+
+// vmath.get_view_projection() -> Matrix4x4f, width, height of the primary camera
+sol::variadic_results get_view_projection(sol::this_state s) {
+    sol::variadic_results results{};
+    auto camera = detail::get_camera_view_projection();
+
+    if (!camera) {
+        results.push_back(sol::make_object(s, sol::lua_nil));
+        return results;
+    }
+
+    const auto& [view_proj, width, height] = *camera;
+
+    results.push_back(sol::make_object(s, view_proj));
+    results.push_back(sol::make_object(s, width));
+    results.push_back(sol::make_object(s, height));
+
+    return results;
+}
+} // namespace api::vmath
+
+void bindings::open_vmath(ScriptState* s) {
+    auto& lua = s->lua();
+    auto vmath = lua.create_table();
+
+    vmath["distances"] = api::vmath::distances;
+    vmath["within_distance"] = api::vmath::within_distance;
+    vmath["in_frustum"] = api::vmath::in_frustum;
+    vmath["world_to_screen"] = api::vmath::world_to_screen;
+    vmath["transform"] = api::vmath::transform;
+    vmath["slerp"] = api::vmath::slerp;
+    vmath["get_view_projection"] = api::vmath::get_view_projection;
+    lua["vmath"] = vmath;
+}
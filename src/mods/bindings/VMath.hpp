@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class ScriptState;
+
+namespace api::vmath::kernels {
+// Struct-of-arrays view over count points. The bindings unpack whatever Lua passed into this layout once,
+// the kernels then run over it 4 elements at a time with SSE and finish the remainder one by one.
+struct Points {
+    const float* x{};
+    const float* y{};
+    const float* z{};
+    size_t count{};
+};
+
+// Matrices are 16 floats in glm's column major layout, i.e. the memory of a Matrix4x4f.
+void distances(const Points& points, const float origin[3], float* out);
+size_t within_distance(const Points& points, const float origin[3], float radius, uint32_t* out_indices);
+
+// Left, right, bottom, top planes and a plane through the camera facing forward, normalized.
+void extract_frustum_planes(const float view_proj[16], float out_planes[5][4]);
+void spheres_in_frustum(const Points& points, const float planes[5][4], float radius, uint8_t* out);
+
+// Points behind the camera get visible = 0 and a screen position of 0, 0.
+void world_to_screen(const Points& points, const float view_proj[16], float width, float height, float* out_x, float* out_y, uint8_t* out_visible);
+void transform_points(const Points& points, const float m[16], float* out_x, float* out_y, float* out_z);
+
+// Quaternions are packed x, y, z, w. t holds either a single value or one per quaternion.
+void slerp(const float* from, const float* to, const float* t, size_t t_count, size_t count, float* out);
+}
+
+namespace bindings {
+void open_vmath(ScriptState* s);
+}
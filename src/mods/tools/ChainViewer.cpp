@@ -7,6 +7,7 @@
 #include "REFramework.hpp"
 #include "utility/ImGui.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneQuery.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/REManagedObject.hpp"
 #include "sdk/Renderer.hpp"
@@ -108,8 +109,6 @@ void ChainViewer::on_frame() {
     static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
     static auto folder_def = sdk::find_type_definition("via.Folder");
     static auto gameobject_def = sdk::find_type_definition("via.GameObject");
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto child_transform_method = transform_def->get_method("get_Child");
     static auto get_gameobject_method = transform_def->get_method("get_GameObject");
     static auto get_folder_path_method = folder_def->get_method("get_Path");
     static auto get_folder_method = gameobject_def->get_method("get_Folder");
@@ -410,19 +409,18 @@ void ChainViewer::on_frame() {
             }
         }
     } else {
-        for (auto transform = first_transform; 
-            transform != nullptr; 
-            transform = next_transform_method->call<RETransform*>(context, transform)) 
-        {
-            attempt_display_chains(transform);
+        sdk::SceneQuery query{};
+        query.component_type = chain_type;
 
-            for (auto t = child_transform_method->call<RETransform*>(context, transform); t != nullptr; t = next_transform_method->call<RETransform*>(context, t)) {
-                attempt_display_chains(t);
+        m_query_results.clear();
+        sdk::query_scene(query, m_query_results);
 
-                for (auto t2 = child_transform_method->call<RETransform*>(context,t); t2 != nullptr; t2 = next_transform_method->call<RETransform*>(context, t2)) {
-                    attempt_display_chains(t2);
-                }
+        for (const auto& result : m_query_results) {
+            if (result.game_object == nullptr || result.game_object->transform == nullptr) {
+                continue;
             }
+
+            attempt_display_chains(result.game_object->transform);
         }
     }
 
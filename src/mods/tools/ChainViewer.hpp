@@ -1,6 +1,9 @@
 #pragma once
 
 #include <chrono>
+#include <vector>
+
+#include "sdk/SceneQuery.hpp"
 
 #include "Tool.hpp"
 
@@ -13,6 +16,7 @@ public:
     std::optional<std::string> on_initialize() override;
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     void on_draw_dev_ui() override;
     void on_frame() override;
@@ -43,6 +47,8 @@ private:
 
     float m_pulse_time{};
 
+    std::vector<sdk::SceneQueryResult> m_query_results{};
+
     ValueList m_options{
         *m_enabled,
     };
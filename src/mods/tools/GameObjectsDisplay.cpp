@@ -1,5 +1,6 @@
 #include "REFramework.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneQuery.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/REManagedObject.hpp"
 
@@ -64,15 +65,7 @@ void GameObjectsDisplay::on_frame() {
 
     auto context = sdk::get_thread_context();
 
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
-
-    if (first_transform == nullptr) {
-        return;
-    }
-
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto next_transform_method = transform_def->get_method("get_Next");
+    static auto transform_def = sdk::find_type_definition("via.Transform");
     static auto get_gameobject_method = transform_def->get_method("get_GameObject");
     static auto get_position_method = transform_def->get_method("get_Position");
     static auto get_axisz_method = transform_def->get_method("get_AxisZ");
@@ -120,11 +113,21 @@ void GameObjectsDisplay::on_frame() {
     auto draw_list = ImGui::GetBackgroundDrawList();
     const auto has_max_distance = m_max_distance->value() > 0.0f;
 
-    for (auto transform = first_transform; 
-        transform != nullptr; 
-        transform = next_transform_method->call<RETransform*>(context, transform)) 
-    {
-        auto owner = get_gameobject_method->call<REGameObject*>(context, transform);
+    // Only the root transforms, same as walking get_FirstTransform -> get_Next.
+    sdk::SceneQuery query{};
+    query.recursive = false;
+
+    if (has_max_distance) {
+        query.use_radius = true;
+        query.origin = camera_origin;
+        query.radius = m_max_distance->value();
+    }
+
+    m_query_results.clear();
+    sdk::query_scene(query, m_query_results);
+
+    for (const auto& result : m_query_results) {
+        auto owner = result.game_object;
 
         if (owner == nullptr) {
             continue;
@@ -136,7 +139,7 @@ void GameObjectsDisplay::on_frame() {
             continue;
         }
 
-        get_position_method->call<void*>(&pos, context, transform);
+        pos = result.position;
         pos.w = 1.0f;
 
         const auto delta = pos - camera_origin;
@@ -146,14 +149,6 @@ void GameObjectsDisplay::on_frame() {
             continue;
         }
 
-        if (has_max_distance) {
-            const auto distance = glm::length(Vector3f{delta});
-
-            if (distance > m_max_distance->value()) {
-                continue;
-            }
-        }
-
         world_to_screen->call<void*>(&screen_pos, context, &pos, &view, &proj, &screen_size);
         draw_list->AddText(ImVec2(screen_pos.x, screen_pos.y), ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f)), owner_name.c_str());
     }
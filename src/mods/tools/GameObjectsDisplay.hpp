@@ -1,5 +1,9 @@
 #pragma once
 
+#include <vector>
+
+#include "sdk/SceneQuery.hpp"
+
 #include "Tool.hpp"
 
 class GameObjectsDisplay : public Tool {
@@ -11,11 +15,14 @@ public:
     std::optional<std::string> on_initialize() override;
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     void on_draw_dev_ui() override;
     void on_frame() override;
 
 private:
+    std::vector<sdk::SceneQueryResult> m_query_results{};
+
     const ModToggle::Ptr m_enabled{ ModToggle::create(generate_name("Enabled")) };
     const ModSlider::Ptr m_max_distance{ ModSlider::create(generate_name("MaxDistance"), 0.0f, 1000.0f, 0.0f) };
 
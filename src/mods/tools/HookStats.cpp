@@ -0,0 +1,347 @@
+#include <bit>
+#include <chrono>
+#include <mutex>
+
+#include <windows.h>
+
+#include "HookStats.hpp"
+
+namespace detail {
+std::mutex g_hook_stats_slot_mtx{};
+std::vector<uint32_t> g_hook_stats_free_slots{};
+uint32_t g_hook_stats_next_slot{0};
+uint64_t g_hook_stats_next_owner{1};
+
+// Shard index shared by every HookStats, handed back when the thread exits.
+struct HookStatsThreadSlot {
+    HookStatsThreadSlot() {
+        std::scoped_lock _{g_hook_stats_slot_mtx};
+
+        owner = g_hook_stats_next_owner++;
+        thread_id = GetCurrentThreadId();
+
+        if (!g_hook_stats_free_slots.empty()) {
+            index = g_hook_stats_free_slots.back();
+            g_hook_stats_free_slots.pop_back();
+        } else if (g_hook_stats_next_slot < HookStats::MAX_THREADS) {
+            index = g_hook_stats_next_slot++;
+        }
+    }
+
+    ~HookStatsThreadSlot() {
+        if (index < HookStats::MAX_THREADS) {
+            std::scoped_lock _{g_hook_stats_slot_mtx};
+            g_hook_stats_free_slots.push_back(index);
+        }
+    }
+
+    uint32_t index{UINT32_MAX};
+    uint32_t thread_id{};
+    uint64_t owner{}; // Unique per thread, unlike thread ids
+};
+
+thread_local HookStatsThreadSlot t_hook_stats_slot{};
+}
+
+HookStats::~HookStats() {
+    for (auto& shard : m_shards) {
+        delete shard.load();
+    }
+}
+
+int64_t HookStats::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+size_t HookStats::get_bucket(int64_t ns) {
+    if (ns < (int64_t)SUB_BUCKETS) {
+        return ns > 0 ? (size_t)ns : 0;
+    }
+
+    const auto v = (uint64_t)ns;
+    const auto exponent = (size_t)(63 - std::countl_zero(v));
+
+    if (exponent >= MAX_EXPONENT) {
+        return NUM_BUCKETS - 1;
+    }
+
+    const auto sub = (size_t)(v >> (exponent - 2)) & (SUB_BUCKETS - 1);
+    return (exponent - 1) * SUB_BUCKETS + sub;
+}
+
+int64_t HookStats::get_bucket_lower_bound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return (int64_t)bucket;
+    }
+
+    const auto exponent = bucket / SUB_BUCKETS + 1;
+    const auto sub = bucket % SUB_BUCKETS;
+
+    return (int64_t)((SUB_BUCKETS + sub) << (exponent - 2));
+}
+
+int64_t HookStats::Snapshot::percentile(double p) const {
+    if (sampled_count == 0) {
+        return 0;
+    }
+
+    uint64_t total{};
+
+    for (const auto count : histogram) {
+        total += count;
+    }
+
+    const auto target = (uint64_t)std::max<double>(1.0, p * (double)total + 0.5);
+    uint64_t seen{};
+
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        seen += histogram[i];
+
+        if (seen >= target) {
+            const auto lower = get_bucket_lower_bound(i);
+            const auto upper = i + 1 < histogram.size() ? get_bucket_lower_bound(i + 1) : lower;
+
+            return lower + (upper - lower) / 2;
+        }
+    }
+
+    return get_bucket_lower_bound(histogram.size() - 1);
+}
+
+HookStats::Shard* HookStats::get_shard() {
+    const auto& slot = detail::t_hook_stats_slot;
+
+    if (slot.index >= MAX_THREADS) {
+        return nullptr;
+    }
+
+    // Only the thread holding the slot ever stores into it.
+    auto shard = m_shards[slot.index].load(std::memory_order_acquire);
+
+    if (shard == nullptr) {
+        shard = new Shard{};
+        m_shards[slot.index].store(shard, std::memory_order_release);
+    }
+
+    // Slot was handed down from a thread that exited, possibly mid-call.
+    if (shard->owner != slot.owner) {
+        shard->owner = slot.owner;
+        shard->depth = 0;
+        shard->thread_id.store(slot.thread_id, std::memory_order_relaxed);
+    }
+
+    return shard;
+}
+
+void HookStats::on_pre(uintptr_t ret_addr, uint32_t sample_every, bool record_trace) {
+    auto shard = get_shard();
+
+    if (shard == nullptr) {
+        m_untracked_calls.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto call_index = shard->call_count.fetch_add(1, std::memory_order_relaxed);
+    const auto sampled = sample_every <= 1 || call_index % sample_every == 0;
+    const auto now = sampled ? now_ns() : 0;
+
+    if (sampled) {
+        shard->last_call_ns.store(now, std::memory_order_relaxed);
+
+        if (record_trace && shard->trace.load(std::memory_order_relaxed) == nullptr) {
+            shard->trace.store(new TraceEvent[TRACE_CAPACITY]{}, std::memory_order_release);
+        }
+    }
+
+    if (shard->depth < MAX_DEPTH) {
+        // Negative marks a sampled call that shouldn't go into the trace.
+        shard->start_times[shard->depth] = sampled ? (record_trace ? now : -now) : 0;
+    }
+
+    ++shard->depth;
+
+    // Insert or bump ret_addr.
+    auto i = (size_t)((ret_addr >> 2) * 0x9E3779B97F4A7C15ull) & (MAX_RETURN_ADDRESSES - 1);
+
+    for (size_t probe = 0; probe < MAX_RETURN_ADDRESSES; ++probe, i = (i + 1) & (MAX_RETURN_ADDRESSES - 1)) {
+        const auto key = shard->return_addresses[i].load(std::memory_order_relaxed);
+
+        if (key == ret_addr) {
+            shard->return_address_counts[i].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (key == 0) {
+            shard->return_address_counts[i].fetch_add(1, std::memory_order_relaxed);
+            shard->return_addresses[i].store(ret_addr, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void HookStats::on_post() {
+    const auto& slot = detail::t_hook_stats_slot;
+
+    if (slot.index >= MAX_THREADS) {
+        return;
+    }
+
+    auto shard = m_shards[slot.index].load(std::memory_order_acquire);
+
+    if (shard == nullptr || shard->owner != slot.owner || shard->depth == 0) {
+        return;
+    }
+
+    --shard->depth;
+
+    if (shard->depth >= MAX_DEPTH) {
+        return;
+    }
+
+    const auto start = shard->start_times[shard->depth];
+
+    if (start == 0) {
+        return;
+    }
+
+    const auto now = now_ns();
+    const auto abs_start = start < 0 ? -start : start;
+    const auto delta = now - abs_start;
+
+    shard->sampled_count.fetch_add(1, std::memory_order_relaxed);
+    shard->total_ns.fetch_add(delta, std::memory_order_relaxed);
+    shard->last_delta_ns.store(delta, std::memory_order_relaxed);
+    shard->histogram[get_bucket(delta)].fetch_add(1, std::memory_order_relaxed);
+
+    if (start > 0) {
+        if (auto trace = shard->trace.load(std::memory_order_relaxed); trace != nullptr) {
+            const auto head = shard->trace_head.load(std::memory_order_relaxed);
+            trace[head % TRACE_CAPACITY] = TraceEvent{abs_start, delta};
+            shard->trace_head.store(head + 1, std::memory_order_release);
+        }
+    }
+}
+
+void HookStats::snapshot(Snapshot& out) const {
+    out.call_count = m_untracked_calls.load(std::memory_order_relaxed);
+    out.sampled_count = 0;
+    out.total_ns = 0;
+    out.last_call_ns = 0;
+    out.last_delta_ns = 0;
+    out.histogram.fill(0);
+    out.thread_ids.clear();
+    out.return_address_counts.clear();
+
+    int64_t latest_call{};
+
+    for (const auto& shard_ptr : m_shards) {
+        const auto shard = shard_ptr.load(std::memory_order_acquire);
+
+        if (shard == nullptr) {
+            continue;
+        }
+
+        const auto call_count = shard->call_count.load(std::memory_order_relaxed);
+
+        if (call_count == 0) {
+            continue;
+        }
+
+        out.call_count += call_count;
+        out.sampled_count += shard->sampled_count.load(std::memory_order_relaxed);
+        out.total_ns += shard->total_ns.load(std::memory_order_relaxed);
+        out.thread_ids.push_back(shard->thread_id.load(std::memory_order_relaxed));
+
+        const auto last_call = shard->last_call_ns.load(std::memory_order_relaxed);
+
+        if (last_call > latest_call) {
+            latest_call = last_call;
+            out.last_call_ns = last_call;
+            out.last_delta_ns = shard->last_delta_ns.load(std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            out.histogram[i] += shard->histogram[i].load(std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < MAX_RETURN_ADDRESSES; ++i) {
+            const auto key = shard->return_addresses[i].load(std::memory_order_acquire);
+
+            if (key != 0) {
+                out.return_address_counts[key] += shard->return_address_counts[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void HookStats::collect_trace(std::vector<std::pair<uint32_t, TraceEvent>>& out) const {
+    for (const auto& shard_ptr : m_shards) {
+        const auto shard = shard_ptr.load(std::memory_order_acquire);
+
+        if (shard == nullptr) {
+            continue;
+        }
+
+        const auto trace = shard->trace.load(std::memory_order_acquire);
+
+        if (trace == nullptr) {
+            continue;
+        }
+
+        const auto thread_id = shard->thread_id.load(std::memory_order_relaxed);
+        const auto head = shard->trace_head.load(std::memory_order_acquire);
+        const auto base = std::max<uint64_t>(shard->trace_base.load(std::memory_order_relaxed), head > TRACE_CAPACITY ? head - TRACE_CAPACITY : 0);
+        const auto first = out.size();
+
+        for (auto i = base; i < head; ++i) {
+            out.emplace_back(thread_id, trace[i % TRACE_CAPACITY]);
+        }
+
+        // Drop whatever the owning thread overwrote while we were copying (+1 for a write in progress).
+        const auto new_head = shard->trace_head.load(std::memory_order_acquire) + 1;
+
+        if (new_head > base + TRACE_CAPACITY) {
+            const auto overwritten = std::min<uint64_t>(new_head - (base + TRACE_CAPACITY), head - base);
+            out.erase(out.begin() + first, out.begin() + first + overwritten);
+        }
+    }
+}
+
+void HookStats::reset() {
+    m_untracked_calls.store(0, std::memory_order_relaxed);
+
+    for (auto& shard_ptr : m_shards) {
+        const auto shard = shard_ptr.load(std::memory_order_acquire);
+
+        if (shard == nullptr) {
+            continue;
+        }
+
+        shard->call_count.store(0, std::memory_order_relaxed);
+        shard->sampled_count.store(0, std::memory_order_relaxed);
+        shard->total_ns.store(0, std::memory_order_relaxed);
+        shard->last_call_ns.store(0, std::memory_order_relaxed);
+        shard->last_delta_ns.store(0, std::memory_order_relaxed);
+
+        for (auto& count : shard->histogram) {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        // Keys stay so the table doesn't need to be cleared under the owning thread.
+        for (auto& count : shard->return_address_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    clear_trace();
+}
+
+void HookStats::clear_trace() {
+    for (auto& shard_ptr : m_shards) {
+        const auto shard = shard_ptr.load(std::memory_order_acquire);
+
+        if (shard != nullptr) {
+            shard->trace_base.store(shard->trace_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+}
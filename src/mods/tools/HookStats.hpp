@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Call statistics for a hooked method that can be updated from any number of game threads without locking.
+// Every thread writes to its own shard (allocated on its first call), readers aggregate them on demand.
+class HookStats {
+public:
+    static constexpr size_t MAX_THREADS = 128;         // Threads past this only bump an untracked call counter
+    static constexpr size_t MAX_DEPTH = 32;            // Recursion depth that still gets timed
+    static constexpr size_t MAX_RETURN_ADDRESSES = 64; // Per thread
+    static constexpr size_t TRACE_CAPACITY = 4096;     // Per thread, oldest events get overwritten
+
+    // Log-scale latency buckets, 4 per power of two up to 2^40ns.
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t MAX_EXPONENT = 40;
+    static constexpr size_t NUM_BUCKETS = (MAX_EXPONENT - 1) * SUB_BUCKETS;
+
+    struct TraceEvent {
+        int64_t start_ns{};
+        int64_t duration_ns{};
+    };
+
+    struct Snapshot {
+        uint64_t call_count{};
+        uint64_t sampled_count{};      // Calls that were timed
+        int64_t total_ns{};            // Sum over sampled calls
+        int64_t last_call_ns{};
+        int64_t last_delta_ns{};
+        std::array<uint64_t, NUM_BUCKETS> histogram{};
+        std::vector<uint32_t> thread_ids{};
+        std::unordered_map<uintptr_t, uint64_t> return_address_counts{};
+
+        // Approximate, p in [0, 1]
+        int64_t percentile(double p) const;
+
+        double mean_ns() const {
+            return sampled_count > 0 ? (double)total_ns / (double)sampled_count : 0.0;
+        }
+
+        // Extrapolated from the sampled calls
+        double estimated_total_ns() const {
+            return sampled_count > 0 ? mean_ns() * (double)call_count : 0.0;
+        }
+    };
+
+    HookStats() = default;
+    HookStats(const HookStats&) = delete;
+    HookStats& operator=(const HookStats&) = delete;
+    ~HookStats();
+
+    // Called from the hook on every call. Only every sample_every-th call on each thread is timed.
+    // Calls from return addresses past the first MAX_RETURN_ADDRESSES on a thread aren't counted per caller.
+    void on_pre(uintptr_t ret_addr, uint32_t sample_every, bool record_trace);
+    void on_post();
+
+    void snapshot(Snapshot& out) const;
+
+    // Appends (thread id, event) for every recorded sampled call still in the trace buffers.
+    void collect_trace(std::vector<std::pair<uint32_t, TraceEvent>>& out) const;
+
+    // Racing writers may keep a few of their in-flight updates.
+    void reset();
+    void clear_trace();
+
+    static int64_t now_ns();
+    static size_t get_bucket(int64_t ns);
+    static int64_t get_bucket_lower_bound(size_t bucket);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint32_t> thread_id{};
+        std::atomic<uint64_t> call_count{};
+        std::atomic<uint64_t> sampled_count{};
+        std::atomic<int64_t> total_ns{};
+        std::atomic<int64_t> last_call_ns{};
+        std::atomic<int64_t> last_delta_ns{};
+        std::array<std::atomic<uint32_t>, NUM_BUCKETS> histogram{};
+
+        // Open addressing, keys are only inserted by the owning thread
+        std::array<std::atomic<uintptr_t>, MAX_RETURN_ADDRESSES> return_addresses{};
+        std::array<std::atomic<uint64_t>, MAX_RETURN_ADDRESSES> return_address_counts{};
+
+        std::atomic<TraceEvent*> trace{nullptr};
+        std::atomic<uint64_t> trace_head{};
+        std::atomic<uint64_t> trace_base{}; // Events before this were cleared
+
+        // Only touched by the owning thread
+        uint64_t owner{};
+        uint32_t depth{};
+        std::array<int64_t, MAX_DEPTH> start_times{}; // 0 = call wasn't sampled
+
+        ~Shard() {
+            delete[] trace.load();
+        }
+    };
+
+    Shard* get_shard();
+
+    std::array<std::atomic<Shard*>, MAX_THREADS> m_shards{};
+    std::atomic<uint64_t> m_untracked_calls{};
+};
@@ -3,6 +3,7 @@
 #include <forward_list>
 #include <deque>
 #include <algorithm>
+#include <array>
 #include <regex>
 #include <json.hpp>
 
@@ -15,6 +16,8 @@
 #include <utility/ImGui.hpp>
 #include "sdk/Renderer.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
+#include "sdk/Method.hpp"
+#include "sdk/MethodIndex.hpp"
 
 #include "../mods/ScriptRunner.hpp"
 
@@ -510,32 +513,34 @@ void ObjectExplorer::on_draw_dev_ui() {
 
         if (auto t = get_type(m_type_name.data())) {
             m_displayed_types.push_back(t);
-        }
-        else {
-            std::function<bool(const std::string&)> search_algo{};
+        } else if (const auto results = !m_search_using_regex ? m_type_name_search.update({m_type_name.data(), sdk::TypeSearchIndex::TYPES, sdk::TypeSearchIndex::Mode::SUBSTRING, 0}) : nullptr; results != nullptr) {
+            for (const auto& result : *results) {
+                const auto tdef = result.get_type();
 
-            if (m_search_using_regex) {
-                search_algo = [this](const auto& a) { return std::regex_search(a, std::regex{ m_type_name.data() }); };
-            } else {
-                search_algo = [this](const auto& a) { return a.find(m_type_name.data()) != std::string::npos; };
-            }
+                if (tdef == nullptr) {
+                    continue;
+                }
 
-            try {
-                // Search the list for a partial match instead
-                for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), search_algo);
-                    i != m_sorted_types.end();
-                    i = std::find_if(i + 1, m_sorted_types.end(), search_algo))
-                {
-                    if (auto t = get_type(*i)) {
-                        m_displayed_types.push_back(t);
-                    }
+                if (auto t = tdef->get_type()) {
+                    m_displayed_types.push_back(t);
+                }
+            }
+        } else {
+            // Regex search, or the search index is still being built
+            for (const auto& name : m_sorted_types) {
+                if (!search_matches(name, m_type_name.data())) {
+                    continue;
                 }
-            } catch (...) {
 
+                if (auto t = get_type(name)) {
+                    m_displayed_types.push_back(t);
+                }
             }
         }
     }
 
+    display_global_search();
+
     if (m_do_init || ImGui::InputText("Method Signature", m_type_member.data(), 256)) {
         m_displayed_types.clear();
         m_type_field[0] = '\0';
@@ -657,7 +662,10 @@ void ObjectExplorer::on_frame() {
                 g_hookman.remove(h.method, h.hook_id);
             }
 
+            std::scoped_lock _{m_hooks_context.mtx};
             m_hooked_methods.clear();
+            m_hooks_context.sorted_hooks.clear();
+            m_hooks_context.needs_refresh = true;
         }
     }
 
@@ -689,7 +697,9 @@ void ObjectExplorer::display_hooks() {
 
     ImGui::SetNextItemOpen(true, ImGuiCond_::ImGuiCond_Once);
     if (ImGui::TreeNode("Options")) {
-        ImGui::Checkbox("Hide uncalled methods", &m_hooks_context.hide_uncalled_methods);
+        if (ImGui::Checkbox("Hide uncalled methods", &m_hooks_context.hide_uncalled_methods)) {
+            m_hooks_context.needs_refresh = true;
+        }
 
         ImGui::SameLine();
 
@@ -697,6 +707,8 @@ void ObjectExplorer::display_hooks() {
             for (auto& h : m_hooked_methods) {
                 h.reset_stats();
             }
+
+            m_hooks_context.needs_refresh = true;
         }
 
         // Combobox of the sort method instead
@@ -706,6 +718,7 @@ void ObjectExplorer::display_hooks() {
 
                 if (ImGui::Selectable(HooksContext::s_sort_method_names[i], is_selected)) {
                     m_hooks_context.sort_method = (HooksContext::SortMethod)i;
+                    m_hooks_context.needs_refresh = true;
                 }
 
                 if (is_selected) {
@@ -716,60 +729,49 @@ void ObjectExplorer::display_hooks() {
             ImGui::EndCombo();
         }
 
-        ImGui::TreePop();
-    }
+        int sample_every = (int)m_hooks_context.sample_every.load();
 
-    std::vector<HookedMethod*> hooks_to_iterate{};
-    for (auto& h : m_hooked_methods) {
-        if (m_hooks_context.hide_uncalled_methods && h.stats.call_count == 0) {
-            continue;
+        if (ImGui::InputInt("Time every Nth call", &sample_every)) {
+            m_hooks_context.sample_every = (uint32_t)std::max(sample_every, 1);
+        }
+
+        bool record_trace = m_hooks_context.record_trace.load();
+
+        if (ImGui::Checkbox("Record trace", &record_trace)) {
+            // Start the trace from scratch every time it's turned on
+            if (record_trace) {
+                for (auto& h : m_hooked_methods) {
+                    h.stats.clear_trace();
+                }
+            }
+
+            m_hooks_context.record_trace = record_trace;
+        }
+
+        if (ImGui::Button("Export CSV")) {
+            export_hook_stats_csv();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("Export Chrome Trace")) {
+            export_hook_trace();
+        }
+
+        if (!m_hooks_context.export_status.empty()) {
+            ImGui::TextWrapped("%s", m_hooks_context.export_status.c_str());
         }
 
-        hooks_to_iterate.push_back(&h);
+        ImGui::TreePop();
     }
 
-    switch (m_hooks_context.sort_method) {
-    case HooksContext::SortMethod::CALL_COUNT:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->stats.call_count > b->stats.call_count;
-        });
-        break;
-    case HooksContext::SortMethod::CALL_TIME_LAST:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->stats.last_call_time > b->stats.last_call_time;
-        });
-        break;
-    case HooksContext::SortMethod::CALL_TIME_DELTA:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->stats.last_call_delta > b->stats.last_call_delta;
-        });
-        break;
-    case HooksContext::SortMethod::CALL_TIME_TOTAL:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->stats.total_call_time > b->stats.total_call_time;
-        });
-        break;
-    case HooksContext::SortMethod::METHOD_NAME:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->name < b->name;
-        });
-        break;
-    case HooksContext::SortMethod::NUMBER_OF_CALLERS:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->callers.size() > b->callers.size();
-        });
-        break;
-    case HooksContext::SortMethod::NUMBER_OF_THREADS_CALLED_FROM:
-        std::sort(hooks_to_iterate.begin(), hooks_to_iterate.end(), [](const auto& a, const auto& b) {
-            return a->stats.thread_ids.size() > b->stats.thread_ids.size();
-        });
-        break;
-    default:
-        break;
-    };
+    refresh_hook_snapshots();
 
-    for (auto& hp : hooks_to_iterate) {
+    const auto to_us = [](double ns) { return ns / 1000.0; };
+
+    for (auto& hp : m_hooks_context.sorted_hooks) {
         auto& h = *hp;
+        const auto& snapshot = h.snapshot;
         ImGui::PushID(h.method);
 
         ImGui::SetNextItemOpen(true, ImGuiCond_::ImGuiCond_Once);
@@ -778,13 +780,23 @@ void ObjectExplorer::display_hooks() {
 
         if (made_node) {
             ImGui::Checkbox("Skip function call", &h.skip);
-            ImGui::TextWrapped("Call count: %i", h.stats.call_count);
+            ImGui::TextWrapped("Call count: %llu", snapshot.call_count);
 
             ImGui::SameLine();
-            const float delta_ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(h.stats.last_call_delta).count();
-            const float total_ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(h.stats.total_call_time).count();
+            const float delta_ms = (float)(snapshot.last_delta_ns / 1'000'000.0);
+            const float total_ms = (float)(snapshot.estimated_total_ns() / 1'000'000.0);
             ImGui::TextWrapped("Time (ms): Delta %f, Total %f", delta_ms, total_ms);
 
+            ImGui::TextWrapped("Time (us): Mean %.3f, p50 %.3f, p95 %.3f, p99 %.3f",
+                to_us(snapshot.mean_ns()),
+                to_us((double)snapshot.percentile(0.50)),
+                to_us((double)snapshot.percentile(0.95)),
+                to_us((double)snapshot.percentile(0.99)));
+
+            if (snapshot.sampled_count != snapshot.call_count) {
+                ImGui::TextWrapped("Timed %llu of %llu calls", snapshot.sampled_count, snapshot.call_count);
+            }
+
             if (ImGui::TreeNode("Info")) {
                 ImGui::SetNextItemOpen(true, ImGuiCond_::ImGuiCond_Once);
                 if (ImGui::TreeNode("Callers")) {
@@ -814,7 +826,7 @@ void ObjectExplorer::display_hooks() {
                     switch (h.sort_callers_method) {
                     case HookedMethod::SortCallersMethod::CALL_COUNT:
                         std::sort(callers_to_iterate.begin(), callers_to_iterate.end(), [&h](const auto& a, const auto& b) {
-                            return h.stats.callers_context[a].call_count > h.stats.callers_context[b].call_count;
+                            return h.caller_counts[a] > h.caller_counts[b];
                         });
                         break;
                     case HookedMethod::SortCallersMethod::METHOD_NAME:
@@ -827,11 +839,7 @@ void ObjectExplorer::display_hooks() {
                     };
 
                     for (auto& caller : callers_to_iterate) {
-                        const auto& context = h.stats.callers_context[caller];
-                        const auto declaring_type = caller->get_declaring_type();
-                        //auto method_name = declaring_type != nullptr ? declaring_type->get_full_name() + "." + caller->get_name() : caller->get_name();
-                        //method_name += " [" + std::to_string(context.call_count) + "]";
-                        const auto call_count = std::string("[") + std::to_string(context.call_count) + "]";
+                        const auto call_count = std::string("[") + std::to_string(h.caller_counts[caller]) + "]";
 
                         ImGui::TextUnformatted(call_count.c_str());
                         ImGui::SameLine();
@@ -853,12 +861,40 @@ void ObjectExplorer::display_hooks() {
                 }
 
                 if (ImGui::TreeNode("Thread IDs")) {
-                    for (auto tid : h.stats.thread_ids) {
+                    for (auto tid : snapshot.thread_ids) {
                         ImGui::Text("%i", tid);
                     }
                     ImGui::TreePop();
                 }
 
+                if (ImGui::TreeNode("Latency Histogram")) {
+                    size_t first = HookStats::NUM_BUCKETS;
+                    size_t last = 0;
+
+                    for (size_t i = 0; i < HookStats::NUM_BUCKETS; ++i) {
+                        if (snapshot.histogram[i] > 0) {
+                            first = std::min(first, i);
+                            last = i;
+                        }
+                    }
+
+                    if (first <= last) {
+                        std::vector<float> values{};
+
+                        for (auto i = first; i <= last; ++i) {
+                            values.push_back((float)snapshot.histogram[i]);
+                        }
+
+                        const auto range = fmt::format("{:.3f}us - {:.3f}us",
+                            to_us((double)HookStats::get_bucket_lower_bound(first)),
+                            to_us((double)HookStats::get_bucket_lower_bound(std::min(last + 1, HookStats::NUM_BUCKETS - 1))));
+
+                        ImGui::PlotHistogram("##histogram", values.data(), (int)values.size(), 0, range.c_str(), 0.0f, FLT_MAX, ImVec2{0, 80});
+                    }
+
+                    ImGui::TreePop();
+                }
+
                 ImGui::TreePop();
             }
 
@@ -869,6 +905,194 @@ void ObjectExplorer::display_hooks() {
     }
 }
 
+void ObjectExplorer::refresh_hook_snapshots() {
+    std::scoped_lock _{m_hooks_context.mtx};
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (!m_hooks_context.needs_refresh && now - m_hooks_context.last_refresh < m_hooks_context.refresh_interval) {
+        return;
+    }
+
+    m_hooks_context.needs_refresh = false;
+    m_hooks_context.last_refresh = now;
+    m_hooks_context.sorted_hooks.clear();
+
+    const auto method_index = sdk::MethodAddressIndex::get();
+
+    for (auto& h : m_hooked_methods) {
+        h.stats.snapshot(h.snapshot);
+        h.caller_counts.clear();
+
+        // Addresses seen before the index is built get resolved on a later refresh.
+        if (method_index != nullptr) {
+            for (const auto& [ret_addr, count] : h.snapshot.return_address_counts) {
+                if (!h.return_addresses.contains(ret_addr)) {
+                    resolve_hook_caller(h, ret_addr, *method_index);
+                }
+            }
+        }
+
+        for (const auto& [ret_addr, count] : h.snapshot.return_address_counts) {
+            if (auto it = h.return_addresses_to_methods.find(ret_addr); it != h.return_addresses_to_methods.end()) {
+                h.caller_counts[it->second] += count;
+            }
+        }
+
+        if (m_hooks_context.hide_uncalled_methods && h.snapshot.call_count == 0) {
+            continue;
+        }
+
+        m_hooks_context.sorted_hooks.push_back(&h);
+    }
+
+    auto& hooks = m_hooks_context.sorted_hooks;
+
+    switch (m_hooks_context.sort_method) {
+    case HooksContext::SortMethod::CALL_COUNT:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.call_count > b->snapshot.call_count;
+        });
+        break;
+    case HooksContext::SortMethod::CALL_TIME_LAST:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.last_call_ns > b->snapshot.last_call_ns;
+        });
+        break;
+    case HooksContext::SortMethod::CALL_TIME_DELTA:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.last_delta_ns > b->snapshot.last_delta_ns;
+        });
+        break;
+    case HooksContext::SortMethod::CALL_TIME_TOTAL:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.estimated_total_ns() > b->snapshot.estimated_total_ns();
+        });
+        break;
+    case HooksContext::SortMethod::METHOD_NAME:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->name < b->name;
+        });
+        break;
+    case HooksContext::SortMethod::NUMBER_OF_CALLERS:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->callers.size() > b->callers.size();
+        });
+        break;
+    case HooksContext::SortMethod::NUMBER_OF_THREADS_CALLED_FROM:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.thread_ids.size() > b->snapshot.thread_ids.size();
+        });
+        break;
+    case HooksContext::SortMethod::CALL_TIME_P99:
+        std::sort(hooks.begin(), hooks.end(), [](const auto& a, const auto& b) {
+            return a->snapshot.percentile(0.99) > b->snapshot.percentile(0.99);
+        });
+        break;
+    default:
+        break;
+    };
+}
+
+void ObjectExplorer::export_hook_stats_csv() {
+    std::scoped_lock _{m_hooks_context.mtx};
+
+    const auto path = REFramework::get_persistent_dir("hook_stats.csv");
+    std::ofstream out{path};
+
+    if (!out) {
+        m_hooks_context.export_status = "Failed to open " + path.string();
+        return;
+    }
+
+    out << "method,calls,timed_calls,threads,callers,total_ms,mean_us,p50_us,p95_us,p99_us,last_us\n";
+
+    HookStats::Snapshot snapshot{};
+
+    for (auto& h : m_hooked_methods) {
+        h.stats.snapshot(snapshot);
+
+        out << '"' << h.name << '"' << ','
+            << snapshot.call_count << ','
+            << snapshot.sampled_count << ','
+            << snapshot.thread_ids.size() << ','
+            << h.callers.size() << ','
+            << snapshot.estimated_total_ns() / 1'000'000.0 << ','
+            << snapshot.mean_ns() / 1000.0 << ','
+            << snapshot.percentile(0.50) / 1000.0 << ','
+            << snapshot.percentile(0.95) / 1000.0 << ','
+            << snapshot.percentile(0.99) / 1000.0 << ','
+            << snapshot.last_delta_ns / 1000.0 << '\n';
+    }
+
+    m_hooks_context.export_status = "Wrote " + path.string();
+    spdlog::info("[ObjectExplorer] {}", m_hooks_context.export_status);
+}
+
+// Chrome's trace event format, open with chrome://tracing or ui.perfetto.dev
+void ObjectExplorer::export_hook_trace() {
+    std::scoped_lock _{m_hooks_context.mtx};
+
+    const auto path = REFramework::get_persistent_dir("hook_trace.json");
+    std::ofstream out{path};
+
+    if (!out) {
+        m_hooks_context.export_status = "Failed to open " + path.string();
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, HookStats::TraceEvent>> events{};
+    std::vector<std::pair<HookedMethod*, size_t>> ranges{}; // hook, end index into events
+    int64_t base_ns = INT64_MAX;
+
+    for (auto& h : m_hooked_methods) {
+        h.stats.collect_trace(events);
+        ranges.emplace_back(&h, events.size());
+    }
+
+    for (const auto& [tid, e] : events) {
+        base_ns = std::min(base_ns, e.start_ns);
+    }
+
+    out << "{\"traceEvents\":[";
+
+    size_t i = 0;
+    bool first = true;
+
+    for (const auto& [h, end] : ranges) {
+        // Method names don't contain anything that needs escaping besides these
+        std::string name{};
+
+        for (const auto c : h->name) {
+            if (c == '"' || c == '\\') {
+                name += '\\';
+            }
+
+            name += c;
+        }
+
+        for (; i < end; ++i) {
+            const auto& [tid, e] = events[i];
+
+            out << (first ? "\n" : ",\n")
+                << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+                << ",\"ts\":" << (e.start_ns - base_ns) / 1000.0
+                << ",\"dur\":" << e.duration_ns / 1000.0 << "}";
+
+            first = false;
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    m_hooks_context.export_status = fmt::format("Wrote {} events to {}", events.size(), path.string());
+    spdlog::info("[ObjectExplorer] {}", m_hooks_context.export_status);
+
+    if (events.empty() && !m_hooks_context.record_trace) {
+        m_hooks_context.export_status += " (enable \"Record trace\" first)";
+    }
+}
+
 void ObjectExplorer::on_lua_state_created(sol::state& lua) {
     // lua bindings for ObjectExplorer might sound weird,
     // but it's actually pretty useful for displaying objects
@@ -2232,7 +2456,13 @@ void ObjectExplorer::generate_sdk() {
     m_sdk_dump_stage = SdkDumpStage::GENERATE_SDK;
     
     genny::ida::transform(sdk);
-    sdk.generate("sdk_ida");
+
+    const auto gen_start = std::chrono::high_resolution_clock::now();
+    const auto gen_stats = sdk.generate("sdk_ida");
+    const auto gen_end = std::chrono::high_resolution_clock::now();
+
+    spdlog::info("Generated IDA SDK in {}ms: {} files written, {} unchanged, {} stale files removed",
+        std::chrono::duration_cast<std::chrono::milliseconds>(gen_end - gen_start).count(), gen_stats.written, gen_stats.unchanged, gen_stats.removed);
 
     // Free a couple gigabytes of no longer used memory
     g_stypedb.clear();
@@ -2401,6 +2631,10 @@ void ObjectExplorer::handle_address(Address address, int32_t offset, Address par
             handle_component(address.as<REComponent*>());
         }
 
+        if (utility::re_managed_object::is_a(object, "via.Transform")) {
+            handle_transform(address.as<RETransform*>());
+        }
+
         if (utility::re_managed_object::is_a(object, "via.render.RenderLayer")) {
             handle_render_layer(address.as<sdk::renderer::RenderLayer*>());
         }
@@ -2588,7 +2822,84 @@ void ObjectExplorer::handle_component(REComponent* component) {
 }
 
 void ObjectExplorer::handle_transform(RETransform* transform) {
+    if (!ImGui::TreeNode(transform, "Call Benchmark")) {
+        return;
+    }
+
+    ImGui::SliderInt("Iterations", &m_call_benchmark_iterations, 1000, 1000000, "%d", ImGuiSliderFlags_Logarithmic);
+
+    if (ImGui::Button("Run")) {
+        m_call_benchmark = run_call_benchmark(transform, (uint32_t)m_call_benchmark_iterations);
+    }
 
+    if (m_call_benchmark) {
+        const auto& result = *m_call_benchmark;
+        const auto baseline = result.method_ns > 0.0 ? result.method_ns : 1.0;
+
+        ImGui::Text("via.Transform.get_Position x %u", result.iterations);
+        ImGui::Text("invoke:          %.1f ns/call (%.2fx)", result.invoke_ns, result.invoke_ns / baseline);
+        ImGui::Text("invoke (plan):   %.1f ns/call (%.2fx)", result.invoke_plan_ns, result.invoke_plan_ns / baseline);
+        ImGui::Text("call<>:          %.1f ns/call (%.2fx)", result.call_ns, result.call_ns / baseline);
+        ImGui::Text("sdk::Method<>:   %.1f ns/call", result.method_ns);
+    }
+
+    ImGui::TreePop();
+}
+
+ObjectExplorer::CallBenchmark ObjectExplorer::run_call_benchmark(RETransform* transform, uint32_t iterations) {
+    CallBenchmark result{};
+    result.iterations = iterations;
+
+    const auto method = sdk::find_method_definition("via.Transform", "get_Position");
+
+    if (method == nullptr || iterations == 0) {
+        return result;
+    }
+
+    const sdk::Method<Vector4f(RETransform*)> bound{method};
+    const auto plan = method->get_invoke_plan();
+
+    // Summed so the calls can't be thrown away.
+    volatile float sink{};
+
+    const auto time_ns = [&](auto&& fn) {
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+
+        const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)iterations;
+    };
+
+    std::span<void*> no_args{};
+
+    result.invoke_ns = time_ns([&]() {
+        const auto ret = method->invoke(transform, no_args);
+        sink = sink + (float)ret.bytes[0];
+    });
+
+    result.invoke_plan_ns = time_ns([&]() {
+        reframework::InvokeRet ret{};
+        method->invoke(plan, transform, no_args, ret);
+        sink = sink + (float)ret.bytes[0];
+    });
+
+    result.call_ns = time_ns([&]() {
+        Vector4f out{};
+        method->call<Vector4f*>(&out, sdk::get_thread_context(), transform);
+        sink = sink + out.x;
+    });
+
+    result.method_ns = time_ns([&]() {
+        sink = sink + bound(transform).x;
+    });
+
+    spdlog::info("[ObjectExplorer] get_Position x {}: invoke {:.1f}ns, invoke (plan) {:.1f}ns, call<> {:.1f}ns, sdk::Method<> {:.1f}ns",
+        iterations, result.invoke_ns, result.invoke_plan_ns, result.call_ns, result.method_ns);
+
+    return result;
 }
 
 void ObjectExplorer::handle_render_layer(sdk::renderer::RenderLayer* layer) {
@@ -4087,6 +4398,7 @@ void ObjectExplorer::hook_method(sdk::REMethodDefinition* method, std::optional<
 
     auto& hooked = m_hooked_methods.emplace_back();
     hooked.method = method;
+    m_hooks_context.needs_refresh = true;
 
     if (name) {
         hooked.name = method->get_declaring_type()->get_full_name() + "." + *name;
@@ -4103,7 +4415,7 @@ void ObjectExplorer::hook_method(sdk::REMethodDefinition* method, std::optional<
         code.init(m_jit_runtime.environment());
         Assembler a{&code};
 
-        a.mov(r9, method);
+        a.mov(r9, &hooked);
         a.movabs(r10, &ObjectExplorer::pre_hooked_method);
         a.jmp(r10);
 
@@ -4116,7 +4428,7 @@ void ObjectExplorer::hook_method(sdk::REMethodDefinition* method, std::optional<
         code.init(m_jit_runtime.environment());
         Assembler a{&code};
 
-        a.mov(r9, method);
+        a.mov(r9, &hooked);
         a.movabs(r10, &ObjectExplorer::post_hooked_method);
         a.jmp(r10);
 
@@ -4182,7 +4494,10 @@ void ObjectExplorer::method_context_menu(sdk::REMethodDefinition* method, std::o
 
                 m_frame_jobs.push_back([this, it]() {
                     g_hookman.remove(it->method, it->hook_id);
+
+                    std::scoped_lock _{m_hooks_context.mtx};
                     m_hooked_methods.erase(it);
+                    m_hooks_context.needs_refresh = true;
                 });
             }
         }
@@ -4490,6 +4805,9 @@ void ObjectExplorer::init() {
             m_function_occurrences[func]++;
         }
     }
+
+    // Used to attribute hooked method calls to their callers.
+    sdk::MethodAddressIndex::build_async();
 }
 
 std::string ObjectExplorer::get_full_enum_value_name(std::string_view enum_name, int64_t value) {
@@ -4561,6 +4879,86 @@ uintptr_t ObjectExplorer::get_original_va(void* ptr) {
     return *utility::get_imagebase_va_from_ptr(m_module_chunk.data(), g_framework->get_module(), ptr);
 }
 
+bool ObjectExplorer::search_matches(std::string_view text, std::string_view pattern) {
+    if (!m_search_using_regex) {
+        return text.find(pattern) != std::string_view::npos;
+    }
+
+    if (!m_search_regex || m_search_regex_pattern != pattern) {
+        m_search_regex_pattern = pattern;
+
+        try {
+            m_search_regex = std::regex{m_search_regex_pattern};
+        } catch (const std::regex_error&) {
+            // Invalid while the user is still typing it
+            m_search_regex = std::regex{"$^"};
+        }
+    }
+
+    return std::regex_search(text.begin(), text.end(), *m_search_regex);
+}
+
+void ObjectExplorer::display_global_search() {
+    if (!ImGui::TreeNode("Search Everything")) {
+        return;
+    }
+
+    // Starts the background build the first time this is opened
+    const auto index = sdk::TypeSearchIndex::get();
+
+    if (index == nullptr) {
+        sdk::TypeSearchIndex::build_async();
+        ImGui::Text("Building search index...");
+        ImGui::TreePop();
+        return;
+    }
+
+    ImGui::Text("%zu names, %zu types/methods/fields", index->get_num_names(), index->get_num_entries());
+
+    bool changed = ImGui::Combo("Mode", &m_global_search_mode, "Auto\0Prefix\0Substring\0Fuzzy\0");
+    changed |= ImGui::CheckboxFlags("Types", &m_global_search_kinds, sdk::TypeSearchIndex::TYPES);
+    ImGui::SameLine();
+    changed |= ImGui::CheckboxFlags("Methods", &m_global_search_kinds, sdk::TypeSearchIndex::METHODS);
+    ImGui::SameLine();
+    changed |= ImGui::CheckboxFlags("Fields", &m_global_search_kinds, sdk::TypeSearchIndex::FIELDS);
+
+    m_global_search.resize(256);
+    changed |= ImGui::InputText("Search", m_global_search.data(), m_global_search.size());
+
+    if (changed) {
+        const auto results = m_global_search_session.update({
+            m_global_search.c_str(), 
+            (uint8_t)m_global_search_kinds, 
+            (sdk::TypeSearchIndex::Mode)m_global_search_mode, 
+            500
+        });
+
+        if (results != nullptr) {
+            m_global_search_results = *results;
+        }
+    }
+
+    constexpr std::array<const char*, 3> kind_names{"Type", "Method", "Field"};
+
+    if (ImGui::BeginListBox("##GlobalSearchResults")) {
+        for (const auto& result : m_global_search_results) {
+            const auto name = result.get_display_name();
+
+            if (ImGui::Selectable((std::string{kind_names[(uint8_t)result.kind]} + " " + name).c_str())) {
+                // Show the owning type below, same as the other search boxes
+                if (auto owner = result.get_owner(); owner != nullptr && owner->get_type() != nullptr) {
+                    m_displayed_types.clear();
+                    m_displayed_types.push_back(owner->get_type());
+                }
+            }
+        }
+
+        ImGui::EndListBox();
+    }
+
+    ImGui::TreePop();
+}
+
 bool ObjectExplorer::is_filtered_type(std::string name) {
     auto it = m_types.find(name);
 
@@ -4600,36 +4998,18 @@ bool ObjectExplorer::is_filtered_method(sdk::REMethodDefinition& m) try {
         return true;
     }
 
-    if (!m_search_using_regex) {
-        if (std::string_view{method_name}.find(name) != std::string_view::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(method_name, std::regex{name.data()})) {
-            return true;
-        }
+    if (search_matches(method_name, name)) {
+        return true;
     }
 
     const auto method_return_type = m.get_return_type();
     const std::string method_return_type_name = method_return_type != nullptr ? method_return_type->get_full_name() : "";
 
-    if (!m_search_using_regex) {
-        if (method_return_type_name.find(name) != std::string::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(method_return_type_name, std::regex{name.data()})) {
-            return true;
-        }
+    if (search_matches(method_return_type_name, name)) {
+        return true;
     }
 
-    std::function<bool(std::string_view a)> search_algo_params{};
-
-    if (!m_search_using_regex) {
-        search_algo_params = [name](std::string_view a) { return a.find(name) != std::string_view::npos; };
-    } else {
-        search_algo_params = [name](std::string_view a) { return std::regex_search(a.data(), std::regex{name.data()}); };
-    }
+    const auto search_algo_params = [this, name](std::string_view a) { return search_matches(a, name); };
 
     const auto method_param_names = m.get_param_names();
     if (auto i = std::find_if(method_param_names.begin(), method_param_names.end(), search_algo_params);
@@ -4637,13 +5017,7 @@ bool ObjectExplorer::is_filtered_method(sdk::REMethodDefinition& m) try {
         return true;
     }
 
-    std::function<bool(sdk::RETypeDefinition* a)> search_algo_types{};
-
-    if (!m_search_using_regex) {
-        search_algo_types = [name](sdk::RETypeDefinition* a) { return std::string_view{a->get_name()}.find(name) != std::string_view::npos; };
-    } else {
-        search_algo_types = [name](sdk::RETypeDefinition* a) { return std::regex_search(a->get_name(), std::regex{name.data()}); };
-    }
+    const auto search_algo_types = [this, name](sdk::RETypeDefinition* a) { return search_matches(a->get_name(), name); };
 
     const auto method_param_types = m.get_param_types();
     if (auto i = std::find_if(method_param_types.begin(), method_param_types.end(), search_algo_types);
@@ -4663,27 +5037,15 @@ bool ObjectExplorer::is_filtered_field(sdk::REField& f) try {
         return true;
     }
 
-    if (!m_search_using_regex) {
-        if (std::string_view{field_name}.find(name) != std::string_view::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(field_name, std::regex{name.data()})) {
-            return true;
-        }
+    if (search_matches(field_name, name)) {
+        return true;
     }
 
     const auto field_type = f.get_type();
     const std::string field_type_name = field_type != nullptr ? field_type->get_full_name() : "";
 
-    if (!m_search_using_regex) {
-        if (field_type_name.find(name) != std::string::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(field_type_name, std::regex{name.data()})) {
-            return true;
-        }
+    if (search_matches(field_type_name, name)) {
+        return true;
     }
 
     return false;
@@ -4691,114 +5053,87 @@ bool ObjectExplorer::is_filtered_field(sdk::REField& f) try {
     return false;
 }
 
-HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
-    auto it = std::find_if(m_hooked_methods.begin(), m_hooked_methods.end(), [method](auto& a) { return a.method == method; });
-
-    if (it == m_hooked_methods.end()) {
-        return HookManager::PreHookResult::CALL_ORIGINAL;
-    }
-
-    auto& hooked_method = *it;
+// Runs on the UI thread for return addresses the hooks reported that haven't been attributed yet.
+void ObjectExplorer::resolve_hook_caller(HookedMethod& hooked_method, uintptr_t ret_addr, const sdk::MethodAddressIndex& method_index) {
+    spdlog::info("Creating new entry for {}", hooked_method.name);
 
-    std::scoped_lock _{m_hooks_context.mtx};
-    ++hooked_method.stats.call_count;
+    hooked_method.return_addresses.insert(ret_addr);
+    // Try to locate the containing function from the return address
+    const auto nearest = method_index.find_nearest(ret_addr);
+    sdk::REMethodDefinition* nearest_method = nearest ? nearest->method : nullptr;
 
-    if (!hooked_method.return_addresses.contains(ret_addr)) {
-        spdlog::info("Creating new entry for {}", hooked_method.name);
+    if (nearest_method != nullptr) {
+        auto method_entry = utility::find_function_entry((uintptr_t)nearest_method->get_function());
 
-        hooked_method.return_addresses.insert(ret_addr);
-        // Try to locate the containing function from the return address
-        sdk::REMethodDefinition* nearest_method{nullptr};
-        size_t nearest_distance = UINT64_MAX;
+        bool added = false;
+        auto add_method = [&]() {
+            hooked_method.return_addresses_to_methods[ret_addr] = nearest_method;
+            hooked_method.callers.insert(nearest_method);
 
-        for (auto& it : m_method_map) {
-            if (it.first > ret_addr) {
-                continue;
-            }
+            const auto decl_type = nearest_method->get_declaring_type();
 
-            const auto distance = ret_addr - it.first;
-            if (distance < nearest_distance) {
-                nearest_distance = distance;
-                nearest_method = it.second;
+            if (decl_type != nullptr) {
+                spdlog::info("{} {}.{}", hooked_method.name, nearest_method->get_declaring_type()->get_full_name(), nearest_method->get_name());
+            } else {
+                spdlog::info("{} {}", hooked_method.name, nearest_method->get_name());
             }
-        }
-
-        if (nearest_method != nullptr) {
-            auto method_entry = utility::find_function_entry((uintptr_t)nearest_method->get_function());
-
-            bool added = false;
-            auto add_method = [&]() {
-                hooked_method.return_addresses_to_methods[ret_addr] = nearest_method;
-                hooked_method.callers.insert(nearest_method);
-
-                const auto decl_type = nearest_method->get_declaring_type();
-
-                if (decl_type != nullptr) {
-                    spdlog::info("{} {}.{}", hooked_method.name, nearest_method->get_declaring_type()->get_full_name(), nearest_method->get_name());
-                } else {
-                    spdlog::info("{} {}", hooked_method.name, nearest_method->get_name());
-                }
-
-                added = true;
-            };
 
-            if (method_entry != nullptr) {
-                const auto module_addr = (uintptr_t)utility::get_module_within(ret_addr).value_or(nullptr);
-                const auto ret_addr_rva = (uint32_t)(ret_addr - module_addr);
-                const auto ret_addr_entry = utility::find_function_entry(ret_addr);
-
-                // First condition isn't as heavy as fully disassembling the function which is the second condition
-                if (ret_addr_entry == method_entry ||
-                    (ret_addr_rva >= method_entry->BeginAddress && ret_addr_rva <= method_entry->EndAddress) ||
-                    (ret_addr_entry != nullptr && ret_addr_entry->BeginAddress >= method_entry->BeginAddress && ret_addr_entry->BeginAddress <= method_entry->EndAddress + 1))
-                {
-                    add_method();
-                } else {
-                    // Disassemble all possible code paths to see if we run into the return address
-                    utility::exhaustive_decode((uint8_t*)nearest_method->get_function(), 5000, [&](utility::ExhaustionContext& ctx) -> utility::ExhaustionResult {
-                        if (ctx.addr == ret_addr) {
-                            add_method();
-                            return utility::ExhaustionResult::BREAK;
-                        }
+            added = true;
+        };
 
-                        if (std::string_view{ctx.instrux.Mnemonic}.starts_with("CALL")) {
-                            return utility::ExhaustionResult::STEP_OVER;
-                        }
+        if (method_entry != nullptr) {
+            const auto module_addr = (uintptr_t)utility::get_module_within(ret_addr).value_or(nullptr);
+            const auto ret_addr_rva = (uint32_t)(ret_addr - module_addr);
+            const auto ret_addr_entry = utility::find_function_entry(ret_addr);
 
-                        return utility::ExhaustionResult::CONTINUE;
-                    });
+            // First condition isn't as heavy as fully disassembling the function which is the second condition
+            if (ret_addr_entry == method_entry ||
+                (ret_addr_rva >= method_entry->BeginAddress && ret_addr_rva <= method_entry->EndAddress) ||
+                (ret_addr_entry != nullptr && ret_addr_entry->BeginAddress >= method_entry->BeginAddress && ret_addr_entry->BeginAddress <= method_entry->EndAddress + 1))
+            {
+                add_method();
+            } else {
+                // Disassemble all possible code paths to see if we run into the return address
+                utility::exhaustive_decode((uint8_t*)nearest_method->get_function(), 5000, [&](utility::ExhaustionContext& ctx) -> utility::ExhaustionResult {
+                    if (ctx.addr == ret_addr) {
+                        add_method();
+                        return utility::ExhaustionResult::BREAK;
+                    }
 
-                    if (!added) {
-                        spdlog::info("{} <unknown caller> @ 0x{:x}", hooked_method.name, ret_addr);
+                    if (std::string_view{ctx.instrux.Mnemonic}.starts_with("CALL")) {
+                        return utility::ExhaustionResult::STEP_OVER;
                     }
-                }
-            } else {
-                hooked_method.return_addresses_to_methods[ret_addr] = nearest_method;
-                hooked_method.callers.insert(nearest_method);
-                const auto decl_type = nearest_method->get_declaring_type();
 
-                if (decl_type != nullptr) {
-                    spdlog::info("{} {}.{}", hooked_method.name, nearest_method->get_declaring_type()->get_full_name(), nearest_method->get_name());
-                } else {
-                    spdlog::info("{} {}", hooked_method.name, nearest_method->get_name());
+                    return utility::ExhaustionResult::CONTINUE;
+                });
+
+                if (!added) {
+                    spdlog::info("{} <unknown caller> @ 0x{:x}", hooked_method.name, ret_addr);
                 }
             }
         } else {
-            spdlog::info("{} <unknown caller> @ 0x{:x}", hooked_method.name, ret_addr);
+            hooked_method.return_addresses_to_methods[ret_addr] = nearest_method;
+            hooked_method.callers.insert(nearest_method);
+            const auto decl_type = nearest_method->get_declaring_type();
+
+            if (decl_type != nullptr) {
+                spdlog::info("{} {}.{}", hooked_method.name, nearest_method->get_declaring_type()->get_full_name(), nearest_method->get_name());
+            } else {
+                spdlog::info("{} {}", hooked_method.name, nearest_method->get_name());
+            }
         }
+    } else {
+        spdlog::info("{} <unknown caller> @ 0x{:x}", hooked_method.name, ret_addr);
     }
+}
 
-    if (auto it2 = hooked_method.return_addresses_to_methods.find(ret_addr); it2 != hooked_method.return_addresses_to_methods.end()) {
-        auto caller = it2->second;
-        auto& context = hooked_method.stats.callers_context[caller];
-        ++context.call_count;
-    }
+HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, HookedMethod* hook) {
+    auto& hooked_method = *hook;
 
-    const auto tid = std::this_thread::get_id();
-    const auto now = std::chrono::high_resolution_clock::now();
-    hooked_method.stats.last_call_time = now;
-    hooked_method.stats.last_call_times[tid] = now;
-    hooked_method.stats.thread_ids.insert(tid._Get_underlying_id());
+    // No locks here, callers get attributed later from the per-thread return address counts.
+    hooked_method.stats.on_pre(ret_addr,
+        m_hooks_context.sample_every.load(std::memory_order_relaxed),
+        m_hooks_context.record_trace.load(std::memory_order_relaxed));
 
     auto result = HookManager::PreHookResult::CALL_ORIGINAL;
 
@@ -4809,38 +5144,14 @@ HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vecto
     return result;
 }
 
-HookManager::PreHookResult ObjectExplorer::pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
-    return ObjectExplorer::get()->pre_hooked_method_internal(args, arg_tys, ret_addr, method);
+HookManager::PreHookResult ObjectExplorer::pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, HookedMethod* hook) {
+    return ObjectExplorer::get()->pre_hooked_method_internal(args, arg_tys, ret_addr, hook);
 }
 
-void ObjectExplorer::post_hooked_method_internal(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
-    auto it = std::find_if(m_hooked_methods.begin(), m_hooked_methods.end(), [method](auto& a) { return a.method == method; });
-
-    if (it == m_hooked_methods.end()) {
-        return;
-    }
-
-    const auto now = std::chrono::high_resolution_clock::now();
-
-    auto& hooked_method = *it;
-
-    std::scoped_lock _{m_hooks_context.mtx};
-
-    // Reset the last call time if this is the first time we're calling it
-    // because in between this, there will be a large hitch
-    // that the game is not causing.
-    if (hooked_method.stats.call_count <= 1) {
-        hooked_method.stats.last_call_time = now;
-    }
-
-    const auto tid = std::this_thread::get_id();
-
-    hooked_method.stats.last_call_end_time = now;
-    const auto delta = now - hooked_method.stats.last_call_times[tid];
-    hooked_method.stats.last_call_delta = delta;
-    hooked_method.stats.total_call_time += delta;
+void ObjectExplorer::post_hooked_method_internal(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, HookedMethod* hook) {
+    hook->stats.on_post();
 }
 
-void ObjectExplorer::post_hooked_method(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
-    ObjectExplorer::get()->post_hooked_method_internal(ret_val, ret_ty, ret_addr, method);
+void ObjectExplorer::post_hooked_method(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, HookedMethod* hook) {
+    ObjectExplorer::get()->post_hooked_method_internal(ret_val, ret_ty, ret_addr, hook);
 }
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <deque>
+#include <list>
 #include <unordered_set>
 #include <unordered_map>
 #include <memory>
+#include <optional>
+#include <regex>
 #include <string>
 #include <imgui.h>
 #include <json.hpp>
@@ -14,13 +19,16 @@
 #include "utility/Address.hpp"
 #include "Tool.hpp"
 #include "HookManager.hpp"
+#include "HookStats.hpp"
 
 #include <sdk/TDBVer.hpp>
+#include <sdk/TypeSearch.hpp>
 
 #define TDB_DUMP_ALLOWED
 
 namespace sdk {
 struct RETypeDefinition;
+class MethodAddressIndex;
 
 namespace renderer {
 class RenderLayer;
@@ -135,8 +143,21 @@ public:
     void handle_address(Address address, int32_t offset = -1, Address parent = nullptr, Address real_address = nullptr);
     
 private:
+    // via.Transform.get_Position called through each of the SDK's calling paths, see handle_transform
+    struct CallBenchmark {
+        uint32_t iterations{};
+        double invoke_ns{};      // invoke(), everything looked up per call
+        double invoke_plan_ns{}; // invoke() with a precomputed InvokePlan
+        double call_ns{};        // call<>(), function pointer fetched per call
+        double method_ns{};      // sdk::Method<>
+    };
+
     void display_pins();
     void display_hooks();
+    void refresh_hook_snapshots();
+    void resolve_hook_caller(HookedMethod& hooked_method, uintptr_t ret_addr, const sdk::MethodAddressIndex& method_index);
+    void export_hook_stats_csv();
+    void export_hook_trace();
 
 #ifdef TDB_DUMP_ALLOWED
     std::shared_ptr<detail::ParsedType> init_type_min(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, uint32_t i);
@@ -150,6 +171,7 @@ private:
     void handle_game_object(REGameObject* game_object);
     void handle_component(REComponent* component);
     void handle_transform(RETransform* transform);
+    CallBenchmark run_call_benchmark(RETransform* transform, uint32_t iterations);
     void handle_render_layer(sdk::renderer::RenderLayer* layer);
     void handle_behavior_tree(sdk::behaviortree::BehaviorTree* bhvt);
     void handle_behavior_tree_core_handle(sdk::behaviortree::BehaviorTree* bhvt, sdk::behaviortree::CoreHandle* bhvt_core_handle, uint32_t tree_idx);
@@ -188,6 +210,10 @@ private:
 
     uintptr_t get_original_va(void* ptr);
 
+    // Substring or regex match depending on m_search_using_regex. The regex is compiled once per pattern.
+    bool search_matches(std::string_view text, std::string_view pattern);
+    void display_global_search();
+
     bool is_filtered_type(std::string name);
     bool is_filtered_method(sdk::REMethodDefinition& m);
     bool is_filtered_field(sdk::REField& f);
@@ -218,11 +244,14 @@ private:
         return path;
     }
 
-    HookManager::PreHookResult pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
-    static HookManager::PreHookResult pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
+    struct HookedMethod;
 
-    void post_hooked_method_internal(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, sdk::REMethodDefinition* method);
-    static void post_hooked_method(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, sdk::REMethodDefinition* method);
+    // The jitted thunks pass the HookedMethod they were made for, so no lookup is needed per call.
+    HookManager::PreHookResult pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, HookedMethod* hook);
+    static HookManager::PreHookResult pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, HookedMethod* hook);
+
+    void post_hooked_method_internal(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, HookedMethod* hook);
+    static void post_hooked_method(uintptr_t& ret_val, sdk::RETypeDefinition*& ret_ty, uintptr_t ret_addr, HookedMethod* hook);
 
     struct PinnedObject {
         Address address{};
@@ -239,10 +268,11 @@ private:
             CALL_TIME_TOTAL,
             METHOD_NAME,
             NUMBER_OF_CALLERS,
-            NUMBER_OF_THREADS_CALLED_FROM
+            NUMBER_OF_THREADS_CALLED_FROM,
+            CALL_TIME_P99
         };
 
-        static inline constexpr std::array<const char*, 8> s_sort_method_names {
+        static inline constexpr std::array<const char*, 9> s_sort_method_names {
             "None",
             "Call Count",
             "Call Time (Last)",
@@ -250,12 +280,26 @@ private:
             "Call Time (Total)",
             "Method Name",
             "Number of Callers",
-            "Number of Threads Called From"
+            "Number of Threads Called From",
+            "Call Time (p99)"
         };
 
+        // Guards caller attribution and the UI state below, the stats themselves are lock-free.
         std::recursive_mutex mtx{};
         bool hide_uncalled_methods{false};
         SortMethod sort_method{SortMethod::NONE};
+
+        // Read by the hooks on every call
+        std::atomic<uint32_t> sample_every{1};
+        std::atomic<bool> record_trace{false};
+
+        // Snapshots and sorting are only redone this often
+        std::chrono::milliseconds refresh_interval{250};
+        std::chrono::steady_clock::time_point last_refresh{};
+        std::vector<HookedMethod*> sorted_hooks{};
+        bool needs_refresh{true}; // Set when hooks are added or removed
+
+        std::string export_status{};
     } m_hooks_context{};
 
     std::recursive_mutex m_job_mutex{};
@@ -288,25 +332,14 @@ private:
         std::unordered_map<uintptr_t, sdk::REMethodDefinition*> return_addresses_to_methods{};
         std::unique_ptr<std::recursive_mutex> mtx{std::make_unique<std::recursive_mutex>()};
 
-        struct Stats {
-            uint32_t call_count{};
-            std::unordered_set<uint32_t> thread_ids{};
-            struct CallerContext {
-                size_t call_count{};
-            };
+        HookStats stats{};
 
-
-            using tp = std::chrono::high_resolution_clock::time_point;
-            std::unordered_map<sdk::REMethodDefinition*, CallerContext> callers_context{};
-            std::chrono::high_resolution_clock::time_point last_call_time{std::chrono::high_resolution_clock::now()};
-            std::unordered_map<std::thread::id, tp> last_call_times{};
-            std::chrono::high_resolution_clock::time_point last_call_end_time{std::chrono::high_resolution_clock::now()}; // assuming not recursive...
-            std::chrono::high_resolution_clock::duration last_call_delta{};
-            std::chrono::high_resolution_clock::duration total_call_time{};
-        } stats;
+        // Refreshed from stats by display_hooks
+        HookStats::Snapshot snapshot{};
+        std::unordered_map<sdk::REMethodDefinition*, uint64_t> caller_counts{};
 
         void reset_stats() {
-            stats = Stats{};
+            stats.reset();
         }
     };
 
@@ -321,7 +354,7 @@ private:
     asmjit::JitRuntime m_jit_runtime;
 
     std::vector<PinnedObject> m_pinned_objects{};
-    std::vector<HookedMethod> m_hooked_methods{};
+    std::list<HookedMethod> m_hooked_methods{}; // list so the addresses baked into the thunks stay valid
     std::deque<std::string> m_current_path{};
 
     inline static const ImVec4 VARIABLE_COLOR{ 100.0f / 255.0f, 149.0f / 255.0f, 237.0f / 255.0f, 255 / 255.0f };
@@ -331,12 +364,23 @@ private:
     std::string m_type_name{"via.typeinfo.TypeInfo"};
     std::string m_type_member{""};
     std::string m_type_field{""};
+    std::string m_global_search{""};
+    int m_global_search_mode{0};
+    int m_global_search_kinds{sdk::TypeSearchIndex::ALL};
+    std::vector<sdk::TypeSearchIndex::Result> m_global_search_results{};
+    sdk::TypeSearchSession m_type_name_search{};
+    sdk::TypeSearchSession m_global_search_session{};
+    std::string m_search_regex_pattern{};
+    std::optional<std::regex> m_search_regex{};
     std::string m_method_address{ "0" };
     std::string m_object_address{ "0" };
     std::string m_add_component_name{ "via.Component" };
     std::chrono::system_clock::time_point m_next_refresh;
     std::chrono::system_clock::time_point m_next_refresh_natives{};
 
+    std::optional<CallBenchmark> m_call_benchmark{};
+    int m_call_benchmark_iterations{100000};
+
     std::unordered_map<VariableDescriptor*, int32_t> m_offset_map;
 
     struct EnumDescriptor {
@@ -20,6 +20,7 @@ public:
     std::optional<std::string> on_initialize() override;
     void on_config_load(const utility::Config& cfg) override;
     void on_config_save(utility::Config& cfg) override;
+    bool is_config_dirty() override { return is_any_dirty(m_options); }
 
     void on_lua_state_created(sol::state& lua) override;
     void on_lua_state_destroyed(sol::state& lua) override;
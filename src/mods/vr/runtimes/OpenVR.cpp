@@ -28,6 +28,30 @@ VRRuntime::Error OpenVR::update_poses() {
 
     memcpy(this->render_poses.data(), this->real_render_poses.data(), sizeof(this->render_poses));
     this->needs_pose_update = false;
+
+    static_assert(PoseFrame::MAX_DEVICES == vr::k_unMaxTrackedDeviceCount);
+
+    this->pose_snapshot.publish([this](PoseFrame& frame) {
+        const auto time_ns = VRRuntime::get_pose_time_ns();
+        frame.num_devices = vr::k_unMaxTrackedDeviceCount;
+
+        for (uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i) {
+            const auto& pose = this->render_poses[i];
+            auto& device = frame.devices[i];
+
+            device.transform = glm::rowMajor4(Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking });
+            device.velocity = Vector4f{ pose.vVelocity.v[0], pose.vVelocity.v[1], pose.vVelocity.v[2], 0.0f };
+            device.angular_velocity = Vector4f{ pose.vAngularVelocity.v[0], pose.vAngularVelocity.v[1], pose.vAngularVelocity.v[2], 0.0f };
+            device.located = true;
+
+            if (pose.bDeviceIsConnected && pose.bPoseIsValid) {
+                this->process_device_pose(i, time_ns, device, true);
+            }
+        }
+
+        ++frame.pose_count;
+    });
+
     return VRRuntime::Error::SUCCESS;
 }
 
@@ -97,6 +121,11 @@ VRRuntime::Error OpenVR::update_matrices(float nearz, float farz){
     this->hmd->GetProjectionRaw(vr::Eye_Left, &this->raw_projections[vr::Eye_Left][0], &this->raw_projections[vr::Eye_Left][1], &this->raw_projections[vr::Eye_Left][2], &this->raw_projections[vr::Eye_Left][3]);
     this->hmd->GetProjectionRaw(vr::Eye_Right, &this->raw_projections[vr::Eye_Right][0], &this->raw_projections[vr::Eye_Right][1], &this->raw_projections[vr::Eye_Right][2], &this->raw_projections[vr::Eye_Right][3]);
 
+    this->pose_snapshot.publish([this](PoseFrame& frame) {
+        frame.eyes = this->eyes;
+        frame.projections = this->projections;
+    });
+
     return VRRuntime::Error::SUCCESS;
 }
 
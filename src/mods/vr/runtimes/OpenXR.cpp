@@ -128,6 +128,38 @@ VRRuntime::Error OpenXR::update_poses() {
         this->got_first_valid_poses = (this->view_space_location.locationFlags & (XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)) != 0;
     }
 
+    this->pose_snapshot.publish([this](PoseFrame& frame) {
+        const auto time_ns = VRRuntime::get_pose_time_ns();
+        frame.num_devices = 1 + (uint32_t)this->hands.size();
+
+        // HMD, no velocity yet
+        auto& hmd = frame.devices[0];
+        hmd.transform = Matrix4x4f{*(glm::quat*)&this->view_space_location.pose.orientation};
+        hmd.transform[3] = Vector4f{*(Vector3f*)&this->view_space_location.pose.position, 1.0f};
+        hmd.velocity = Vector4f{};
+        hmd.angular_velocity = Vector4f{};
+        hmd.located = !this->stage_views.empty();
+
+        if (hmd.located) {
+            this->process_device_pose(0, time_ns, hmd, false);
+        }
+
+        for (size_t i = 0; i < this->hands.size(); ++i) {
+            const auto& hand = this->hands[i];
+            auto& device = frame.devices[i + 1];
+
+            device.transform = Matrix4x4f{*(glm::quat*)&hand.location.pose.orientation};
+            device.transform[3] = Vector4f{*(Vector3f*)&hand.location.pose.position, 1.0f};
+            device.velocity = Vector4f{*(Vector3f*)&hand.velocity.linearVelocity, 0.0f};
+            device.angular_velocity = Vector4f{*(Vector3f*)&hand.velocity.angularVelocity, 0.0f};
+            device.located = true;
+
+            this->process_device_pose((uint32_t)i + 1, time_ns, device, true);
+        }
+
+        ++frame.pose_count;
+    });
+
     this->needs_pose_update = false;
     this->got_first_poses = true;
     return VRRuntime::Error::SUCCESS;
@@ -261,6 +293,11 @@ VRRuntime::Error OpenXR::update_matrices(float nearz, float farz) {
         this->eyes[i][3] = Vector4f{*(Vector3f*)&pose.position, 1.0f};
     }
 
+    this->pose_snapshot.publish([this](PoseFrame& frame) {
+        frame.eyes = this->eyes;
+        frame.projections = this->projections;
+    });
+
     return VRRuntime::Error::SUCCESS;
 }
 
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <sdk/Math.hpp>
+
+// Everything the game side reads about the tracked devices, as of the last time the runtime updated them.
+struct PoseFrame {
+    static constexpr uint32_t MAX_DEVICES = 64; // vr::k_unMaxTrackedDeviceCount
+
+    struct Device {
+        Matrix4x4f transform{glm::identity<Matrix4x4f>()};
+        Vector4f velocity{};
+        Vector4f angular_velocity{};
+        bool located{false}; // false if the runtime has nothing at this index
+    };
+
+    std::array<Device, MAX_DEVICES> devices{};
+    std::array<Matrix4x4f, 2> eyes{glm::identity<Matrix4x4f>(), glm::identity<Matrix4x4f>()};
+    std::array<Matrix4x4f, 2> projections{glm::identity<Matrix4x4f>(), glm::identity<Matrix4x4f>()};
+    uint32_t num_devices{0};
+    uint64_t pose_count{0}; // Incremented every time the device poses are published
+};
+
+// Double buffered seqlock around a PoseFrame.
+// Writers fill whichever buffer readers aren't pointed at and then flip it to the front,
+// so a reader only has to retry if two publishes happen while it's copying.
+// Readers never block and never write to shared memory.
+class PoseSnapshot {
+public:
+    // Copies the current frame into the back buffer, lets fn modify it and publishes it.
+    // Writers are serialized with each other but not with readers.
+    template <typename T>
+    void publish(T&& fn) {
+        std::scoped_lock _{m_write_mtx};
+
+        const auto front = m_front.load(std::memory_order_relaxed);
+        auto& back = m_buffers[front ^ 1];
+        const auto sequence = back.sequence.load(std::memory_order_relaxed);
+
+        back.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        back.frame = m_buffers[front].frame;
+        fn(back.frame);
+
+        back.sequence.store(sequence + 2, std::memory_order_release);
+        m_front.store(front ^ 1, std::memory_order_release);
+    }
+
+    // fn gets called on a frame that may be overwritten while it runs, so it should only copy values out of it.
+    // It may be called more than once, only the result of a call that saw a consistent frame is returned.
+    template <typename T>
+    auto read(T&& fn) const {
+        while (true) {
+            const auto& buffer = m_buffers[m_front.load(std::memory_order_acquire)];
+            const auto sequence = buffer.sequence.load(std::memory_order_acquire);
+
+            if ((sequence & 1) != 0) {
+                continue;
+            }
+
+            auto result = fn(buffer.frame);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (buffer.sequence.load(std::memory_order_relaxed) == sequence) {
+                return result;
+            }
+        }
+    }
+
+    PoseFrame get() const {
+        return read([](const PoseFrame& frame) { return frame; });
+    }
+
+private:
+    struct alignas(64) Buffer {
+        std::atomic<uint32_t> sequence{0};
+        PoseFrame frame{};
+    };
+
+    std::array<Buffer, 2> m_buffers{};
+    std::atomic<uint32_t> m_front{0};
+    std::mutex m_write_mtx{};
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <string_view>
 #include <functional>
@@ -10,6 +12,10 @@
 
 #include <spdlog/spdlog.h>
 #include <sdk/Math.hpp>
+#include <vrpose/Filter.hpp>
+#include <vrpose/Recorder.hpp>
+
+#include "PoseSnapshot.hpp"
 
 struct VRRuntime {
     enum class Error : int64_t {
@@ -94,6 +100,53 @@ struct VRRuntime {
         return Error::SUCCESS;
     }
 
+    void set_pose_processor_settings(const vrpose::Settings& settings) {
+        std::scoped_lock _{ this->pose_processor_mtx };
+        this->pose_processor.set_settings(settings);
+    }
+
+    static int64_t get_pose_time_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Called by the runtimes on each device they publish, records the raw pose and/or replaces it
+    // with the filtered and predicted one. The HMD (index 0) is only recorded, the compositor reprojects
+    // with its raw render pose so rendering from anything else judders, and OpenVR already predicts it to photon time.
+    void process_device_pose(uint32_t index, int64_t time_ns, PoseFrame::Device& device, bool has_velocity) {
+        const auto recording = this->pose_recorder.is_open();
+        const auto processing = this->pose_processing_enabled.load() && index != 0;
+
+        if (!recording && !processing) {
+            return;
+        }
+
+        const auto rotation = glm::quat_cast(device.transform);
+
+        vrpose::PoseSample sample{};
+        sample.time_ns = time_ns;
+        sample.position = vrpose::Vec3{ device.transform[3].x, device.transform[3].y, device.transform[3].z };
+        sample.orientation = vrpose::Quat{ rotation.x, rotation.y, rotation.z, rotation.w };
+        sample.velocity = vrpose::Vec3{ device.velocity.x, device.velocity.y, device.velocity.z };
+        sample.angular_velocity = vrpose::Vec3{ device.angular_velocity.x, device.angular_velocity.y, device.angular_velocity.z };
+        sample.has_velocity = has_velocity;
+
+        if (recording) {
+            this->pose_recorder.record(index, sample);
+        }
+
+        if (!processing) {
+            return;
+        }
+
+        std::scoped_lock _{ this->pose_processor_mtx };
+        const auto out = this->pose_processor.process(index, sample);
+
+        device.transform = Matrix4x4f{ glm::quat{ out.orientation.w, out.orientation.x, out.orientation.y, out.orientation.z } };
+        device.transform[3] = Vector4f{ out.position.x, out.position.y, out.position.z, 1.0f };
+        device.velocity = Vector4f{ out.velocity.x, out.velocity.y, out.velocity.z, 0.0f };
+        device.angular_velocity = Vector4f{ out.angular_velocity.x, out.angular_velocity.y, out.angular_velocity.z, 0.0f };
+    }
+
     bool is_openxr() const {
         return this->type() == Type::OPENXR;
     }
@@ -125,6 +178,15 @@ struct VRRuntime {
     mutable std::shared_mutex eyes_mtx{};
     mutable std::shared_mutex pose_mtx{};
 
+    // Published at the end of update_poses/update_matrices, lets the game side read poses without taking the locks above.
+    PoseSnapshot pose_snapshot{};
+
+    // Optional filtering/prediction of the published poses, and recording of the raw ones for offline replay.
+    vrpose::PoseProcessor pose_processor{};
+    vrpose::Recorder pose_recorder{};
+    std::mutex pose_processor_mtx{};
+    std::atomic<bool> pose_processing_enabled{false};
+
     Vector4f raw_projections[2]{};
 
     SynchronizeStage custom_stage{SynchronizeStage::EARLY};